@@ -0,0 +1,8 @@
+#! /usr/bin/env python3
+
+# Programs that are runnable.
+ns3_runnable_programs = ['build/scratch/ns3-dev-wns3-mpquic-one-path-debug', 'build/scratch/ns3-dev-zz-alloc-debug', 'build/scratch/ns3-dev-wns3-mpquic-two-path-debug', 'build/scratch/ns3-dev-wns3-mpquic-four-path-debug', 'build/scratch/subdir/ns3-dev-subdir-debug', 'build/scratch/ns3-dev-wns3-mpquic-two-path-cwnd-debug', 'build/scratch/ns3-dev-wns3-mpquic-two-path-flip-debug']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = []
+
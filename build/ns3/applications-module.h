@@ -0,0 +1,41 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_APPLICATIONS
+    
+
+// Module headers:
+#include "application-packet-probe.h"
+#include "bulk-send-application.h"
+#include "bulk-send-helper.h"
+#include "mpquic-bulk-send-application.h"
+#include "mpquic-bulk-send-helper.h"
+#include "on-off-helper.h"
+#include "onoff-application.h"
+#include "packet-loss-counter.h"
+#include "packet-sink-helper.h"
+#include "packet-sink.h"
+#include "quic-client-server-helper.h"
+#include "quic-client.h"
+#include "quic-echo-client.h"
+#include "quic-echo-helper.h"
+#include "quic-echo-server.h"
+#include "quic-server.h"
+#include "seq-ts-echo-header.h"
+#include "seq-ts-header.h"
+#include "seq-ts-size-header.h"
+#include "three-gpp-http-client.h"
+#include "three-gpp-http-header.h"
+#include "three-gpp-http-helper.h"
+#include "three-gpp-http-server.h"
+#include "three-gpp-http-variables.h"
+#include "udp-client-server-helper.h"
+#include "udp-client.h"
+#include "udp-echo-client.h"
+#include "udp-echo-helper.h"
+#include "udp-echo-server.h"
+#include "udp-server.h"
+#include "udp-trace-client.h"
+#endif
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICLIA_H
+#define MPQUICLIA_H
+
+#include "mp-quic-congestion-ops.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Linked Increases Algorithm (RFC 6356)
+ *
+ * In congestion avoidance, the window of a path grows by
+ * min (alpha * bytesAcked * MSS / totalCwnd, bytesAcked * MSS / cWnd), with
+ * alpha = totalCwnd * max (cWnd / rtt^2) / (sum (cWnd / rtt))^2.
+ * Losses halve the window of the path, as in NewReno.
+ */
+class MpQuicLia : public MpQuicCongestionOps
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicLia ();
+  MpQuicLia (const MpQuicLia& sock);
+  ~MpQuicLia ();
+
+  std::string GetName () const;
+  Ptr<TcpCongestionOps> Fork ();
+
+protected:
+  virtual void CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                    uint8_t pathId, const MpQuicCoupledState &coupled);
+};
+
+} // namespace ns3
+
+#endif /* MPQUICLIA_H */
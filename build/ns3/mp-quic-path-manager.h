@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Shengjie Shu <shengjies@uvic.ca>
+ */
+
+#ifndef MpQUICPATHMANAGER_H
+#define MpQUICPATHMANAGER_H
+
+#include "ns3/node.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+
+#include "quic-socket-base.h"
+#include "mp-quic-subflow.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \see MpQuicPathManagerBase
+ * \brief (abstract) base class of all MpQuicPathManagers
+ *
+ * This class constitutes a basic implementation of a Quic Stream.
+ *
+ * With EnableProbing, the paths are checked every ProbeInterval once the
+ * connection is open. A PATH_CHALLENGE is sent on an active path that is
+ * idle, i.e. nothing was received on it for IdleTimeout, or suspect, i.e. a
+ * tail loss probe or retransmission timeout fired on it, or its oldest packet
+ * in flight is older than ProbeRtts smoothed RTTs. If nothing is received on
+ * the path within ProbeRtts smoothed RTTs of the challenge, the path fails:
+ * the scheduler no longer uses it, and the frames in flight on it are put
+ * back in the application buffer ahead of new data. A failed path keeps
+ * being probed, and is active again as soon as a packet is received on it.
+ * It is abandoned with a PATH_ABANDON frame if it stays failed for
+ * AbandonTimeout.
+ *
+ * A path whose local interface goes down is closed right away, and a
+ * REMOVE_ADDRESS frame tells the peer to close it as well. It is announced
+ * again with an ADD_ADDRESS frame when the interface comes back up. The
+ * server also opens new paths on the interfaces added to the node during the
+ * connection.
+ */
+class MpQuicPathManager : public Object
+{
+public:
+  /**
+   * Get the type ID.
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicPathManager (void);
+  virtual ~MpQuicPathManager (void);
+
+
+  Ptr<MpQuicSubFlow> InitialSubflow0 (Address localAddress, Address peerAddress);
+  Ptr<MpQuicSubFlow> AddSubflow(Address address, Address from, uint8_t pathId);
+  Ptr<MpQuicSubFlow> AddSubflowWithPeerAddress(Address localAddress, Address peerAddress, uint8_t pathId);
+ 
+  void SetSocket(Ptr<QuicSocketBase> sock);
+  void SetSegSize(uint32_t size);
+  uint32_t GetSegSize() const;
+  void SetInitialSSThresh (uint32_t threshold);
+  uint32_t GetInitialSSThresh (void) const;
+
+  /**
+   * \brief TracedCallback signature for the path state changes made by the path manager
+   *
+   * \param [in] pathId the path
+   * \param [in] state the new state of the path
+   */
+  typedef void (*PathStateTracedCallback)(uint8_t pathId, MpQuicSubFlow::SubflowStates_t state);
+
+  /**
+   * \brief Start checking the paths, if probing is enabled
+   */
+  void StartProbing (void);
+
+  /**
+   * \brief Stop checking the paths
+   */
+  void StopProbing (void);
+
+  /**
+   * \brief Record that a packet was received on a path
+   *
+   * A failed path is active again.
+   *
+   * \param pathId the path
+   */
+  void OnPacketReceived (uint8_t pathId);
+
+  /**
+   * \brief Send a PATH_CHALLENGE on a path
+   *
+   * \param pathId the path
+   */
+  void Probe (uint8_t pathId);
+
+  /**
+   * \brief Make a path active once a PATH_CHALLENGE or PATH_RESPONSE was received on it
+   *
+   * Closed paths stay closed.
+   *
+   * \param pathId the path
+   */
+  void OnPathValidated (uint8_t pathId);
+
+  /**
+   * \brief Close a path, putting back the frames in flight on it in the application buffer
+   *
+   * \param pathId the path
+   */
+  void ClosePath (uint8_t pathId);
+
+  /**
+   * \brief Validate again a closed path announced by the peer
+   *
+   * \param pathId the path
+   * \param peerAddress the address of the peer on the path
+   */
+  void ReopenPath (uint8_t pathId, Address peerAddress);
+
+  /**
+   * \brief Get an active path to send control frames on
+   *
+   * \param exclude a path not to use
+   * \return the active path with the lowest ID, or -1 if there is none
+   */
+  int16_t GetLivePath (int16_t exclude) const;
+
+private:
+  /**
+   * \brief Check the liveness and local interface of each path, and schedule the next check
+   */
+  void CheckPaths (void);
+
+  /**
+   * \param subflow the subflow
+   * \return true if the subflow is idle or suspect, and should be probed
+   */
+  bool IsSuspect (Ptr<MpQuicSubFlow> subflow) const;
+
+  /**
+   * \param subflow the subflow
+   * \return the time after which an unanswered PATH_CHALLENGE marks the path as failed
+   */
+  Time GetProbeTimeout (Ptr<MpQuicSubFlow> subflow) const;
+
+  /**
+   * \param subflow the subflow
+   * \return the index of the interface of the local address of the subflow, or -1
+   */
+  int32_t GetInterface (Ptr<MpQuicSubFlow> subflow) const;
+
+  /**
+   * \brief Stop using a path that no longer answers, and reinject the frames in flight on it
+   *
+   * \param subflow the subflow
+   */
+  void FailPath (Ptr<MpQuicSubFlow> subflow);
+
+  /**
+   * \brief Reset the congestion control and the loss detection of a path
+   *
+   * \param subflow the subflow
+   */
+  void ResetPath (Ptr<MpQuicSubFlow> subflow);
+
+  /**
+   * \brief Change the state of a path, and fire the trace
+   *
+   * \param subflow the subflow
+   * \param state the new state
+   */
+  void SetPathState (Ptr<MpQuicSubFlow> subflow, MpQuicSubFlow::SubflowStates_t state);
+
+  Ptr<QuicSocketBase> m_socket;
+  uint32_t m_segSize;
+  uint32_t m_initialSsThresh;
+
+  bool m_opensPaths;                       //!< True if this side opens the paths, i.e. it is the server
+  bool m_enableProbing;                    //!< True if the paths are probed, and fail over
+  Time m_probeInterval;                    //!< Interval between two checks of the paths
+  Time m_idleTimeout;                      //!< Time without receiving anything on a path after which it is probed
+  double m_probeRtts;                      //!< Smoothed RTTs without an answer after which a path fails
+  Time m_abandonTimeout;                   //!< Time after which a failed path is abandoned
+  EventId m_checkEvent;                    //!< Next check of the paths
+  std::vector<bool> m_removed;             //!< True for the paths closed because their local interface went down
+  TracedCallback<uint8_t, MpQuicSubFlow::SubflowStates_t> m_pathStateTrace;  //!< Trace of the path state changes
+};
+
+} // namespace ns3
+
+#endif /* MP_QUIC_PATH_MANAGER_H */
+
+
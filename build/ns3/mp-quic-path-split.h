@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICPATHSPLIT_H
+#define MPQUICPATHSPLIT_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Table of the data to send on each path, filled by MpQuicScheduler
+ *
+ * The table has a fixed capacity and is owned by the caller, so that
+ * scheduling decisions do not allocate memory.
+ */
+class MpQuicPathSplit
+{
+public:
+  static const uint8_t MAX_PATHS = 8;   //!< Capacity of the table
+
+  /**
+   * \brief Number of bytes to send on a path
+   */
+  struct Entry
+  {
+    uint8_t m_pathId;    //!< The path
+    uint32_t m_budget;   //!< Bytes to send on the path
+    bool m_duplicate;    //!< True to send a copy of the packet sent on the first path instead of new data
+  };
+
+  MpQuicPathSplit ();
+
+  /**
+   * \brief Remove all the entries
+   */
+  void Clear (void);
+
+  /**
+   * \brief Add an entry
+   *
+   * \param pathId the path
+   * \param budget the number of bytes to send on the path
+   */
+  void Add (uint8_t pathId, uint32_t budget);
+
+  /**
+   * \brief Add a path that carries a copy of the packet sent on the first path
+   *
+   * \param pathId the path
+   */
+  void AddDuplicate (uint8_t pathId);
+
+  /**
+   * \return the number of entries
+   */
+  uint8_t GetSize (void) const;
+
+  /**
+   * \param index the index of the entry
+   * \return the entry
+   */
+  const Entry &Get (uint8_t index) const;
+
+private:
+  Entry m_entries[MAX_PATHS];   //!< Entries
+  uint8_t m_size;               //!< Number of entries in use
+};
+
+} // namespace ns3
+
+#endif /* MPQUICPATHSPLIT_H */
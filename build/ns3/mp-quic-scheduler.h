@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Shengjie Shu <shengjies@uvic.ca>
+ */
+
+
+#ifndef MPQUICSCHEDULER_H
+#define MPQUICSCHEDULER_H
+
+#include "ns3/node.h"
+#include "ns3/traced-callback.h"
+#include "quic-socket-base.h"
+#include "mp-quic-linucb.h"
+#include "mp-quic-path-split.h"
+#include <eigen3/Eigen/Dense>
+#include <eigen3/Eigen/StdVector>
+#include <map>
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+namespace ns3 {
+
+class MpQuicScheduler : public Object
+{
+public:
+
+  typedef enum
+    {
+      ROUND_ROBIN,       
+      MIN_RTT,
+      BLEST,
+      ECF,
+      PEEKABOO,
+      DEADLINE,
+      REDUNDANT,
+      SELECTIVE_REDUNDANT
+    } SchedulerType_t;
+
+  /**
+   * \brief TracedCallback signature for predicted deadline misses
+   *
+   * \param [in] streamId the stream of the frame expected to miss its deadline
+   * \param [in] misses the number of predicted deadline misses of the stream so far
+   */
+  typedef void (*PredictedDeadlineMissTracedCallback)(uint64_t streamId, uint32_t misses);
+  
+  /**
+   * Get the type ID.
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicScheduler (void);
+  virtual ~MpQuicScheduler (void);
+
+  /**
+   * \brief Decide how the data waiting to be sent is split among the active paths
+   *
+   * The paths that pacing holds back are left out. The split is empty when
+   * pacing holds back every active path.
+   *
+   * \param bytes the number of bytes waiting to be sent
+   * \param split the table to fill, its previous entries are removed
+   */
+  void GetNextPathIdToUse (uint32_t bytes, MpQuicPathSplit &split);
+  void SetSocket(Ptr<QuicSocketBase> sock);
+    
+  void UpdateReward (uint32_t oldValue, uint32_t newValue);
+  void SetNumOfLostPackets(uint16_t lost);
+  void UpdateRewardMab(uint8_t pathId, uint32_t lostOut, uint32_t inflight, uint32_t round);
+  uint32_t GetCurrentRound();
+
+  void PeekabooReward(uint8_t pathId, Time lastActTime);
+
+  /**
+   * \brief Get the number of frames of a stream that no path was expected to deliver before their deadline
+   *
+   * Only the DEADLINE scheduler counts them. The count is taken when the
+   * frame is scheduled, from the estimated delay of each path, so a frame
+   * counted here may still arrive in time, and a frame that was not may
+   * arrive late.
+   *
+   * \param streamId the stream ID
+   * \return the number of predicted deadline misses of the stream
+   */
+  uint32_t GetPredictedDeadlineMisses (uint64_t streamId) const;
+
+private:
+  Ptr<QuicSocketBase> m_socket;
+  uint8_t m_lastUsedPathId;
+  
+  
+  const std::vector <Ptr<MpQuicSubFlow>> *m_subflows;   //!< Subflows the current decision is taken among
+  std::vector <Ptr<MpQuicSubFlow>> m_candidates;       //!< Active subflows that pacing does not hold back
+  SchedulerType_t m_schedulerType;
+
+
+  uint8_t RoundRobin();
+  uint8_t MinRtt();
+  uint8_t Peekaboo();
+  uint8_t Blest();
+  uint8_t Ecf();
+
+  /**
+   * \brief Place the head-of-line frame on a path that delivers it before its deadline
+   *
+   * The deadline is the one given to the frame by the EDF stream scheduler.
+   * Among the paths expected to deliver the frame in time, the one with the
+   * earliest delivery is used, preferring the paths with room in their
+   * window. When no path is expected to meet the deadline, a predicted miss
+   * is counted for the stream and the frame is deprioritized behind the
+   * frames that still can, then the new head-of-line frame is placed. Frames
+   * without a deadline are sent on the path with the earliest expected
+   * delivery.
+   *
+   * \return the path to use
+   */
+  uint8_t Deadline();
+
+  /**
+   * \brief Estimate how long a frame sent now on a path takes to reach the peer
+   *
+   * The frame waits for the bytes in flight in excess of the congestion
+   * window to be acknowledged, at a rate of one window per smoothed RTT,
+   * then takes half a smoothed RTT plus the RTT variance to be delivered.
+   *
+   * \param pathId the path
+   * \param size the size of the frame
+   * \return the expected delay, in seconds
+   */
+  double EstimateDelay (uint8_t pathId, uint32_t size) const;
+
+  /**
+   * \brief Decide whether the selective redundant scheduler copies the next packet on every path
+   *
+   * The packet is copied when the RTT variance of the path it is sent on
+   * exceeds RedundantRttVarRatio times its smoothed RTT, or when the
+   * head-of-line frame belongs to a stream whose EDF latency bound is at
+   * most RedundantLatency.
+   *
+   * \param pathId the path the packet is sent on
+   * \return true if the packet should be copied on the other paths
+   */
+  bool IsLatencyCritical (uint8_t pathId);
+
+  /**
+   * \brief Find the path with the earliest expected delivery, preferring the paths with room in their window
+   *
+   * \param size the size of the frame
+   * \return the path to use
+   */
+  uint8_t EarliestDelivery (uint32_t size) const;
+
+  /**
+   * \brief Find an active path, other than the initial one, with no RTT sample yet
+   *
+   * \return the path ID, or -1 if every path has been measured
+   */
+  int16_t FindUnmeasuredPath () const;
+
+  /**
+   * \brief Get a subflow of the socket from its path ID
+   *
+   * The active subflows skip the paths that are not Active, so their
+   * positions are not path IDs.
+   *
+   * \param pathId the path ID
+   * \return the subflow
+   */
+  const Ptr<MpQuicSubFlow> &GetPath (uint8_t pathId) const;
+
+  /**
+   * \brief Pick the fastest path and the fastest path that has room in its congestion window
+   *
+   * Paths are ranked by smoothed RTT. When the fastest path has room in its
+   * window, both are the fastest path. Otherwise slowPathId is the fastest of
+   * the other paths with room in their window, or the second fastest path if
+   * none has any, and the schedulers decide between waiting for the fastest
+   * path and sending on slowPathId.
+   *
+   * \param fastPathId the fastest path
+   * \param slowPathId the path to use instead of waiting for the fastest one
+   */
+  void GetFastAndSlowPaths (uint8_t &fastPathId, uint8_t &slowPathId);
+
+  /**
+   * \brief Build the Peekaboo context of a decision between two paths
+   *
+   * \param fastPathId the fastest path
+   * \param slowPathId the path to use instead of waiting for the fastest one
+   * \return the features of the fastest path followed by those of the other path
+   */
+  MpQuicLinUcbArm::Vector GetPeekabooContext (uint8_t fastPathId, uint8_t slowPathId) const;
+
+  uint32_t m_rate;
+  uint16_t m_lostPackets;
+  uint16_t m_lambda;
+  uint16_t m_bVar;
+  uint8_t m_waiting = 0;
+  uint16_t m_select;
+
+  std::vector <double> m_cost;
+  std::vector <uint32_t> m_missingRounds;
+  uint32_t m_lastUpdateRounds;
+  uint32_t m_e;
+  std::vector <double> m_L;
+  std::vector <double> m_eL;
+  std::vector <double> m_p;
+  std::vector <MpQuicLinUcbArm, Eigen::aligned_allocator<MpQuicLinUcbArm> > m_peekArms;  //!< LinUCB arm of each path
+  std::vector <uint8_t> m_pathsByRtt;        //!< IDs of the active paths, sorted by smoothed RTT
+  std::vector <Eigen::Vector3d> m_peekFeatures;  //!< Latest Peekaboo features of each path
+  std::vector <double> m_peekRtt;            //!< Latest RTT of each path, used by Peekaboo
+  Time m_redundantLatency;                   //!< Streams with a latency bound up to this are copied on every path
+  double m_redundantRttVarRatio;             //!< Packets are copied on every path when RTT variance / smoothed RTT exceeds this
+  std::map <uint64_t, uint32_t> m_predictedMisses;  //!< Number of predicted deadline misses of each stream
+  TracedCallback<uint64_t, uint32_t> m_predictedMissTrace;  //!< Trace of the predicted deadline misses
+  double T_r, g = 1, R = 0, T_e;
+};
+
+} // namespace ns3
+
+#endif /* MP_QUIC_SCHEDULER_H */
+
+
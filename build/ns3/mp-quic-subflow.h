@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Shengjie Shu <shengjies@uvic.ca>
+ */
+
+#include <vector>
+#include <map>
+#include "ns3/sequence-number.h"
+#include "ns3/rtt-estimator.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/event-id.h"
+#include <stdint.h>
+#include <queue>
+#include <list>
+#include <set>
+
+#include "ns3/object.h"
+#include "ns3/uinteger.h"
+#include "ns3/traced-value.h"
+#include "ns3/trace-source-accessor.h"
+
+#include "quic-socket-tx-buffer.h"
+#include "quic-socket-base.h"
+#include "quic-ack-range-tracker.h"
+
+#ifndef MP_QUIC_SUBFLOW_H
+#define MP_QUIC_SUBFLOW_H
+
+using namespace std;
+
+namespace ns3 {
+
+class MpQuicSubFlow : public Object
+{
+public:
+
+    typedef enum
+    {
+      Validating,       //!< subflow is initialed, cannot send data yet
+      Active,           //!< sublfow is fully active
+      Failed,           //!< subflow stopped answering, probed until it does again
+      Closeing,         //!< subflow is closing
+      Closed            //!< subflow is fully closed
+    } SubflowStates_t;
+    
+    static TypeId GetTypeId (void);
+
+    MpQuicSubFlow ();
+    ~MpQuicSubFlow ();
+
+    uint16_t m_flowId;
+    Address m_localAddr;
+    Address m_peerAddr;
+
+    TracedValue<SubflowStates_t> m_subflowState;     //!< State 
+
+    void SetSegSize (uint32_t size);
+    uint32_t GetSegSize (void) const;
+    double GetRate();
+
+
+    void UpdateCwnd (uint32_t oldValue, uint32_t newValue);
+
+    // The following member parameters are moved from 'quic-socket-base.h'
+    // Timers and Events
+    EventId m_sendPendingDataEvent;             //!< Micro-delay event to send pending data
+    EventId m_retxEvent;                        //!< Retransmission event
+    EventId m_idleTimeoutEvent;                 //!< Event triggered upon receiving or sending a packet, when it expires the connection closes
+    EventId m_drainingPeriodEvent;              //!< Event triggered upon idle timeout or immediate connection close, when it expires all closes
+    TracedValue<Time> m_rto;                    //!< Retransmit timeout
+    TracedValue<Time> m_drainingPeriodTimeout;  //!< Draining Period timeout
+    QuicLazyTimer m_sendAckTimer;               //!< Send ACK timer
+    QuicLazyTimer m_delAckTimer;                //!< Delayed ACK timer
+    bool m_flushOnClose;                        //!< Control behavior on connection close
+    bool m_closeOnEmpty;                        //!< True if the socket will close after sending the buffered packets
+
+    // Congestion Control
+    Ptr<QuicSocketState> m_tcb;                     //!< Congestion control informations
+    bool m_queue_ack;                               //!< Indicates a request for a queue ACK if true
+    uint32_t m_numPacketsReceivedSinceLastAckSent;  //!< Number of packets received since last ACK sent
+    uint32_t m_lastMaxData;                         //!< Last MaxData ACK
+    uint32_t m_maxDataInterval;                     //!< Interval between successive MaxData frames in ACKs
+    uint64_t m_advertisedMaxData;                   //!< Last MAX_DATA attached to an ACK of the path
+
+    // Pacing
+    Timer m_pacingTimer       {Timer::REMOVE_ON_DESTROY};   //!< Pacing Event, running while the path waits for pacing tokens
+    int64_t m_pacingTokens;                                 //!< Bytes the path can still send back-to-back
+    Time m_pacingLastRefill;                                //!< Last time the pacing tokens were refilled
+    QuicAckRangeTracker m_receivedPacketNumbers;            //!< Ranges of the received packet numbers
+    TracedValue<DataRate> m_deliveryRate;                   //!< Last delivery rate sampled on the path
+    Time m_controlRtt;                                      //!< Last RTT sampled from an ACK carrying a window update
+    SequenceNumber32 m_windowUpdatePacket;                  //!< Packet number of the ACK carrying a window update
+    Time m_windowUpdateSent;                                //!< Time that ACK was sent, zero once acknowledged
+
+    uint32_t m_rounds;
+
+    // Liveness
+    Time m_lastReceived;                        //!< Last time a packet was received on the path
+    Time m_challengeSent;                       //!< Time the unanswered PATH_CHALLENGE was sent, zero if none
+    Time m_failedSince;                         //!< Time the path was declared failed
+
+private:
+  TracedCallback<uint32_t, uint32_t> m_cWndTrace;
+
+};
+
+
+}//namespace ns3
+#endif //MP_QUIC_SUBFLOW_H
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef QUICACKRANGETRACKER_H
+#define QUICACKRANGETRACKER_H
+
+#include <map>
+#include <stdint.h>
+#include "ns3/sequence-number.h"
+#include "quic-subheader.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Set of the packet numbers received on a path, stored as disjoint ranges
+ *
+ * Packet numbers are merged into the existing ranges as they arrive, so that
+ * generating an ACK frame only walks the ranges and not every packet received.
+ * Once the ranges have been reported, Prune bounds their number by folding
+ * the oldest ones together, as the ACK frame only describes the most recent
+ * gaps and acknowledges everything below its last block.
+ */
+class QuicAckRangeTracker
+{
+public:
+  QuicAckRangeTracker ();
+
+  /**
+   * \brief Add a received packet number
+   *
+   * \param seq the packet number
+   * \return false if the packet number had already been received
+   */
+  bool Add (SequenceNumber32 seq);
+
+  /**
+   * \return true if no packet number has been received
+   */
+  bool IsEmpty (void) const;
+
+  /**
+   * \return the largest packet number received
+   */
+  SequenceNumber32 GetLargest (void) const;
+
+  /**
+   * \return the number of disjoint ranges
+   */
+  uint32_t GetNumRanges (void) const;
+
+  /**
+   * \brief Check if the last packet number added did not extend the largest range
+   *
+   * This is the case when the packet opened a new gap above the largest
+   * packet number, or filled (part of) an older gap.
+   *
+   * \return true if the last packet was received out of order
+   */
+  bool IsOutOfOrder (void) const;
+
+  /**
+   * \brief Build the gaps and blocks of an ACK frame, in the format used by QuicSubheader::CreateMpAck
+   *
+   * The first block implicitly ends at GetLargest (); for each further block,
+   * gaps holds the last packet number missing above it and additionalAckBlocks
+   * its largest packet number.
+   *
+   * \param gaps the vector to fill with the gaps
+   * \param additionalAckBlocks the vector to fill with the additional ACK blocks
+   * \param maxGaps the maximum number of gaps to report
+   */
+  void GetAckBlocks (QuicAckBlocks &gaps,
+                     QuicAckBlocks &additionalAckBlocks,
+                     uint32_t maxGaps) const;
+
+  /**
+   * \brief Fold the oldest ranges together, keeping at most maxRanges of them
+   *
+   * \param maxRanges the maximum number of ranges to keep
+   */
+  void Prune (uint32_t maxRanges);
+
+  /**
+   * \brief Forget all the packet numbers received
+   */
+  void Clear (void);
+
+private:
+  typedef std::map<uint32_t, uint32_t> RangeMap;  //!< first packet number -> last packet number of a range
+
+  RangeMap m_ranges;          //!< disjoint, non-adjacent ranges of packet numbers
+  bool m_outOfOrder;          //!< true if the last packet added did not extend the largest range
+};
+
+} // namespace ns3
+
+#endif /* QUICACKRANGETRACKER_H */
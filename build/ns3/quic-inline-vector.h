@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef QUICINLINEVECTOR_H
+#define QUICINLINEVECTOR_H
+
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Vector of trivially copyable elements that keeps the first N of them inline
+ *
+ * The elements only move to the heap when the vector grows past N, so that
+ * small vectors (such as the ACK blocks of a typical ACK frame) are built,
+ * copied and destroyed without any allocation.
+ */
+template <typename T, uint32_t N>
+class QuicInlineVector
+{
+public:
+  typedef T value_type;             //!< Element type
+  typedef const T* const_iterator;  //!< Iterator type
+
+  QuicInlineVector ()
+    : m_data (m_inline),
+      m_size (0),
+      m_capacity (N)
+  {
+  }
+
+  /**
+   * \brief Copy the elements of a std::vector
+   * \param v the vector to copy
+   */
+  QuicInlineVector (const std::vector<T> &v)
+    : m_data (m_inline),
+      m_size (0),
+      m_capacity (N)
+  {
+    Assign (v.data (), v.size ());
+  }
+
+  /**
+   * \brief Copy constructor
+   * \param other the vector to copy
+   */
+  QuicInlineVector (const QuicInlineVector &other)
+    : m_data (m_inline),
+      m_size (0),
+      m_capacity (N)
+  {
+    Assign (other.m_data, other.m_size);
+  }
+
+  ~QuicInlineVector ()
+  {
+    if (m_data != m_inline)
+      {
+        delete [] m_data;
+      }
+  }
+
+  /**
+   * \brief Assignment operator
+   * \param other the vector to copy
+   * \return this vector
+   */
+  QuicInlineVector &operator= (const QuicInlineVector &other)
+  {
+    if (this != &other)
+      {
+        Assign (other.m_data, other.m_size);
+      }
+    return *this;
+  }
+
+  /**
+   * \return the number of elements
+   */
+  uint32_t size () const
+  {
+    return m_size;
+  }
+
+  /**
+   * \return true if the vector holds no element
+   */
+  bool empty () const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \param i the index of an element
+   * \return the element
+   */
+  const T &operator[] (uint32_t i) const
+  {
+    NS_ASSERT (i < m_size);
+    return m_data[i];
+  }
+
+  /**
+   * \param i the index of an element
+   * \return the element
+   */
+  T &operator[] (uint32_t i)
+  {
+    NS_ASSERT (i < m_size);
+    return m_data[i];
+  }
+
+  /**
+   * \return an iterator to the first element
+   */
+  const_iterator begin () const
+  {
+    return m_data;
+  }
+
+  /**
+   * \return an iterator past the last element
+   */
+  const_iterator end () const
+  {
+    return m_data + m_size;
+  }
+
+  /**
+   * \brief Append an element, moving the elements to the heap if the inline storage is full
+   * \param value the element
+   */
+  void push_back (const T &value)
+  {
+    if (m_size == m_capacity)
+      {
+        Grow (2 * m_capacity);
+      }
+    m_data[m_size++] = value;
+  }
+
+  /**
+   * \brief Make room for at least n elements
+   * \param n the number of elements
+   */
+  void reserve (uint32_t n)
+  {
+    if (n > m_capacity)
+      {
+        Grow (n);
+      }
+  }
+
+  /**
+   * \brief Remove all the elements, keeping the storage
+   */
+  void clear ()
+  {
+    m_size = 0;
+  }
+
+private:
+  /**
+   * \brief Move the elements to a heap array of the given capacity
+   * \param capacity the new capacity
+   */
+  void Grow (uint32_t capacity)
+  {
+    T *data = new T[capacity];
+    std::copy (m_data, m_data + m_size, data);
+    if (m_data != m_inline)
+      {
+        delete [] m_data;
+      }
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+  /**
+   * \brief Replace the elements with a copy of an array
+   * \param data the array
+   * \param size the number of elements in the array
+   */
+  void Assign (const T *data, uint32_t size)
+  {
+    m_size = 0;
+    reserve (size);
+    std::copy (data, data + size, m_data);
+    m_size = size;
+  }
+
+  T m_inline[N];        //!< Inline storage for the first N elements
+  T *m_data;            //!< Current storage, m_inline or a heap array
+  uint32_t m_size;      //!< Number of elements
+  uint32_t m_capacity;  //!< Number of elements the current storage can hold
+};
+
+} // namespace ns3
+
+#endif /* QUICINLINEVECTOR_H */
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef QUICLAZYTIMER_H
+#define QUICLAZYTIMER_H
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/fatal-error.h"
+#include "ns3/timer-impl.h"
+
+namespace ns3 {
+
+class QuicTimerWheel;
+
+/**
+ * \ingroup quic
+ *
+ * \brief A deadline timer that is re-armed without touching the event queue
+ *
+ * Timers such as the idle timeout are pushed forward on every packet.
+ * Rather than cancelling and scheduling an event each time, the timer only
+ * records the new deadline, and keeps at most one event in the simulator:
+ * when that event fires before the deadline, it schedules itself again for
+ * the remaining time. An event is only cancelled when the deadline is
+ * moved earlier than it, and Cancel simply disarms the timer.
+ *
+ * Like ns3::Watchdog, on which it is modeled, the function and its
+ * arguments are set once, and invoked when the deadline is reached.
+ *
+ * A timer attached to a QuicTimerWheel schedules no event of its own: the
+ * wheel serves the deadlines of all the timers of a connection with a
+ * single event.
+ */
+class QuicLazyTimer
+{
+public:
+  QuicLazyTimer ();
+  ~QuicLazyTimer ();
+
+  /**
+   * \brief Set the function to invoke when the timer expires
+   * \param memPtr the member function pointer
+   * \param objPtr the pointer to the object
+   */
+  template <typename MEM_PTR, typename OBJ_PTR>
+  void SetFunction (MEM_PTR memPtr, OBJ_PTR objPtr);
+
+  /**
+   * \brief Set the arguments of the function invoked on expiry
+   * \param args the arguments
+   */
+  template <typename... Ts>
+  void SetArguments (Ts&&... args);
+
+  /**
+   * \brief Let a wheel serve the deadline of the timer, instead of an event of its own
+   * \param wheel the wheel, or 0 to detach the timer from its wheel
+   */
+  void SetWheel (QuicTimerWheel *wheel);
+
+  /**
+   * \brief Arm the timer to expire after delay, replacing any previous deadline
+   * \param delay the delay
+   */
+  void Schedule (Time delay);
+
+  /**
+   * \brief Disarm the timer
+   */
+  void Cancel (void);
+
+  /**
+   * \return true if the timer is armed
+   */
+  bool IsRunning (void) const;
+
+  /**
+   * \return true if the timer is not armed, i.e., it expired or was cancelled
+   */
+  bool IsExpired (void) const;
+
+  /**
+   * \return the time left before expiry, or zero if the timer is not armed
+   */
+  Time GetDelayLeft (void) const;
+
+private:
+  friend class QuicTimerWheel;
+
+  QuicLazyTimer (const QuicLazyTimer &);
+  QuicLazyTimer& operator= (const QuicLazyTimer &);
+
+  /**
+   * \brief Invoked by the pending event: expire, or wait until the deadline
+   */
+  void Expire (void);
+
+  TimerImpl *m_impl;   //!< the function to invoke, with its arguments
+  EventId m_event;     //!< the pending event, if any
+  Time m_eventTime;    //!< the time at which the pending event fires
+  Time m_end;          //!< the deadline
+  bool m_running;      //!< true if the timer is armed
+  QuicTimerWheel *m_wheel;  //!< the wheel serving the deadline, if any
+  uint64_t m_armOrder;      //!< when the timer was last armed on its wheel, to order the timers due at the same time
+};
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+QuicLazyTimer::SetFunction (MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+  delete m_impl;
+  m_impl = MakeTimerImpl (memPtr, objPtr);
+}
+
+template <typename... Ts>
+void
+QuicLazyTimer::SetArguments (Ts&&... args)
+{
+  if (m_impl == 0)
+    {
+      NS_FATAL_ERROR ("You cannot set the arguments of a QuicLazyTimer before setting its function.");
+      return;
+    }
+  m_impl->SetArgs (std::forward<Ts>(args)...);
+}
+
+} // namespace ns3
+
+#endif /* QUICLAZYTIMER_H */
@@ -0,0 +1,50 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_QUIC
+    
+
+// Module headers:
+#include "mp-quic-balia.h"
+#include "mp-quic-bbr.h"
+#include "mp-quic-congestion-ops.h"
+#include "mp-quic-coupled-state.h"
+#include "mp-quic-lia.h"
+#include "mp-quic-linucb.h"
+#include "mp-quic-path-manager.h"
+#include "mp-quic-path-split.h"
+#include "mp-quic-reinjection.h"
+#include "mp-quic-scheduler.h"
+#include "mp-quic-subflow.h"
+#include "mp-quic-wvegas.h"
+#include "quic-ack-range-tracker.h"
+#include "quic-alloc-counter.h"
+#include "quic-bbr.h"
+#include "quic-congestion-ops.h"
+#include "quic-free-list.h"
+#include "quic-header.h"
+#include "quic-helper.h"
+#include "quic-inline-vector.h"
+#include "quic-l4-protocol.h"
+#include "quic-l5-protocol.h"
+#include "quic-lazy-timer.h"
+#include "quic-socket-base.h"
+#include "quic-socket-factory.h"
+#include "quic-socket-rx-buffer.h"
+#include "quic-socket-tx-buffer.h"
+#include "quic-socket-tx-edf-scheduler.h"
+#include "quic-socket-tx-pfifo-scheduler.h"
+#include "quic-socket-tx-scheduler.h"
+#include "quic-socket.h"
+#include "quic-stream-base.h"
+#include "quic-stream-rx-buffer.h"
+#include "quic-stream-tx-buffer.h"
+#include "quic-stream.h"
+#include "quic-subheader.h"
+#include "quic-timer-wheel.h"
+#include "quic-trace-recorder.h"
+#include "quic-transport-parameters.h"
+#include "windowed-filter.h"
+#endif
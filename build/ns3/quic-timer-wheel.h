@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef QUICTIMERWHEEL_H
+#define QUICTIMERWHEEL_H
+
+#include <vector>
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+namespace ns3 {
+
+class QuicLazyTimer;
+
+/**
+ * \ingroup quic
+ *
+ * \brief The deadlines of the timers of a connection, served by a single event
+ *
+ * Each path of a connection has a loss detection alarm, which also serves
+ * the tail loss probes and retransmission timeouts, and two ACK timers. The
+ * QuicLazyTimer instances attached to the wheel only record their deadline,
+ * and the wheel keeps at most one event in the simulator, armed no later
+ * than the earliest deadline. When it fires, the timers whose deadline is
+ * reached expire, earliest deadline first and, for the same deadline, in the
+ * order they were armed, as events of their own would, and the event is
+ * armed again for the earliest remaining deadline.
+ *
+ * A connection has few timers, so the deadlines are scanned when the event
+ * fires rather than kept sorted on every re-arm, which is the frequent
+ * operation.
+ */
+class QuicTimerWheel
+{
+public:
+  QuicTimerWheel ();
+  ~QuicTimerWheel ();
+
+  /**
+   * \brief Serve a timer
+   * \param timer the timer
+   */
+  void Attach (QuicLazyTimer *timer);
+
+  /**
+   * \brief Stop serving a timer
+   * \param timer the timer
+   */
+  void Detach (QuicLazyTimer *timer);
+
+  /**
+   * \brief Make sure the event fires no later than the new deadline of a timer
+   * \param timer the timer that was just armed
+   */
+  void Update (QuicLazyTimer *timer);
+
+  /**
+   * \return the number of timers served
+   */
+  uint32_t GetNTimers (void) const;
+
+  /**
+   * \return the number of events scheduled by the wheel so far
+   */
+  uint64_t GetNEvents (void) const;
+
+private:
+  QuicTimerWheel (const QuicTimerWheel &);
+  QuicTimerWheel& operator= (const QuicTimerWheel &);
+
+  /**
+   * \brief Expire the timers whose deadline is reached, and wait for the next one
+   */
+  void Expire (void);
+
+  /**
+   * \brief Make sure the event fires no later than a deadline
+   * \param deadline the deadline
+   */
+  void Wait (Time deadline);
+
+  /**
+   * \brief Schedule the event at a deadline
+   * \param deadline the deadline
+   */
+  void Arm (Time deadline);
+
+  std::vector<QuicLazyTimer *> m_timers;   //!< the timers served, in the order they were attached
+  std::vector<QuicLazyTimer *> m_due;      //!< the timers expiring, kept to reuse its storage
+  uint64_t m_nArms;                         //!< the number of times a timer was armed
+  EventId m_event;                          //!< the pending event, if any
+  Time m_eventTime;                         //!< the time at which the pending event fires
+  uint64_t m_nEvents;                       //!< the number of events scheduled
+  bool m_expiring;                          //!< true while the timers are being expired
+};
+
+} // namespace ns3
+
+#endif /* QUICTIMERWHEEL_H */
@@ -62,6 +62,14 @@ void ThroughputMonitor (FlowMonitorHelper *fmhelper, Ptr<FlowMonitor> flowMon, P
     Simulator::Schedule(Seconds(0.05),&ThroughputMonitor, fmhelper, flowMon, stream);
 }
 
+static Time g_lastRx = Seconds (0);
+
+void
+SinkRx (Ptr<const Packet> packet, const Address &from)
+{
+    g_lastRx = Simulator::Now ();
+}
+
 void
 ModifyLinkRate(NetDeviceContainer *ptp, DataRate lr, Time delay) {
     StaticCast<PointToPointNetDevice>(ptp->Get(0))->SetDataRate(lr);
@@ -72,6 +80,7 @@ int
 main (int argc, char *argv[])
 {
     int schedulerType = MpQuicScheduler::ROUND_ROBIN;
+    int reinjection = MpQuicReinjection::SAME_PATH;
     
     string myRandomNo = "5242880";
     string lossrate = "0.0000";
@@ -95,7 +104,8 @@ main (int argc, char *argv[])
     CommandLine cmd;
 
 
-    cmd.AddValue ("SchedulerType", "in use scheduler type (0 - ROUND_ROBIN, 1 - MIN_RTT, 2 - BLEST, 3 - ECF, 4 - Peekaboo", schedulerType);
+    cmd.AddValue ("SchedulerType", "in use scheduler type (0 - ROUND_ROBIN, 1 - MIN_RTT, 2 - BLEST, 3 - ECF, 4 - Peekaboo, 5 - Deadline, 6 - Redundant, 7 - Selective redundant", schedulerType);
+    cmd.AddValue ("Reinjection", "path of the lost frames (0 - same path, 1 - best path, 2 - proactive)", reinjection);
     cmd.AddValue ("BVar", "e.g. 100", bVar);
     cmd.AddValue ("BLambda", "e.g. 100", bLambda);
     cmd.AddValue ("MabRate", "e.g. 100", mrate);
@@ -111,7 +121,7 @@ main (int argc, char *argv[])
     cmd.AddValue ("Seed", "e.g. 80", seed);
     cmd.AddValue ("LossRate", "e.g. 0.0001", lossrate);
     cmd.AddValue ("Select", "e.g. 0.0001", mselect);
-    cmd.AddValue ("CcType", "in use congestion control type (0 - QuicNewReno, 1 - OLIA)", ccType);
+    cmd.AddValue ("CcType", "in use congestion control type (0 - QuicNewReno, 1 - OLIA, 2 - LIA, 3 - BALIA, 4 - wVegas, 5 - BBR)", ccType);
     cmd.Parse (argc, argv);
 
     NS_LOG_INFO("\n\n#################### SIMULATION SET-UP ####################\n\n\n");
@@ -127,14 +137,24 @@ main (int argc, char *argv[])
     if (ccType == QuicSocketBase::OLIA){
         ccTypeId = MpQuicCongestionOps::GetTypeId ();
     }
+    if (ccType == QuicSocketBase::LIA){
+        ccTypeId = MpQuicLia::GetTypeId ();
+    }
+    if (ccType == QuicSocketBase::BALIA){
+        ccTypeId = MpQuicBalia::GetTypeId ();
+    }
+    if (ccType == QuicSocketBase::WVEGAS){
+        ccTypeId = MpQuicWVegas::GetTypeId ();
+    }
+    if (ccType == QuicSocketBase::MPBBR){
+        ccTypeId = MpQuicBbr::GetTypeId ();
+    }
     if(ccType == QuicSocketBase::QuicNewReno){
         ccTypeId = QuicCongestionOps::GetTypeId ();
     }
 
     Config::SetDefault ("ns3::QuicSocketBase::SocketSndBufSize",UintegerValue (40000000));
     Config::SetDefault ("ns3::QuicStreamBase::StreamSndBufSize",UintegerValue (40000000));
-    Config::SetDefault ("ns3::QuicSocketBase::SocketRcvBufSize",UintegerValue (40000000));
-    Config::SetDefault ("ns3::QuicStreamBase::StreamRcvBufSize",UintegerValue (40000000));
 
 
     Config::SetDefault ("ns3::QuicSocketBase::EnableMultipath",BooleanValue(true));
@@ -145,6 +165,7 @@ main (int argc, char *argv[])
     Config::SetDefault ("ns3::MpQuicScheduler::BlestLambda", UintegerValue(bLambda));     
     Config::SetDefault ("ns3::MpQuicScheduler::MabRate", UintegerValue(mrate)); 
     Config::SetDefault ("ns3::MpQuicScheduler::Select", UintegerValue(mselect)); 
+    Config::SetDefault ("ns3::MpQuicReinjection::Policy", IntegerValue(reinjection));
 
     
     Ptr<RateErrorModel> em = CreateObjectWithAttributes<RateErrorModel> (
@@ -292,6 +313,7 @@ main (int argc, char *argv[])
     PacketSinkHelper sink2 ("ns3::QuicSocketFactory",
                             InetSocketAddress (Ipv4Address::GetAny (), port2));
     ApplicationContainer sinkApps2 = sink2.Install (c.Get (5));
+    sinkApps2.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&SinkRx));
     sinkApps2.Start (Seconds (0.0));
     sinkApps2.Stop (Seconds(simulationEndTime));
 
@@ -346,6 +368,16 @@ main (int argc, char *argv[])
                 "\npath 0: rate "<< rate0a <<", delay "<< delay0a << 
                 "\npath 1: rate " << rate1a << ", delay " << delay1a );
 
+    // Goodput of the transfer, and the lost or stalled frames sent again on another path
+    uint64_t rxBytes = DynamicCast<PacketSink> (sinkApps2.Get (0))->GetTotalRx ();
+    Ptr<QuicSocketBase> sender = DynamicCast<QuicSocketBase> (
+        DynamicCast<MpquicBulkSendApplication> (sourceApps.Get (0))->GetSocket ());
+    double duration = g_lastRx.GetSeconds () - start_time;
+    NS_LOG_INFO("\nreinjection policy " << reinjection <<
+                "\ngoodput(Mbps): " << (duration > 0 ? rxBytes * 8 / 1e6 / duration : 0) <<
+                "\nreinjected bytes: " << sender->GetTxBuffer ()->GetReinjectedBytes () <<
+                "\nrequeued bytes: " << sender->GetReinjection ()->GetRequeuedBytes ());
+
     Simulator::Destroy ();
 
     return 0;
@@ -95,7 +95,7 @@ main (int argc, char *argv[])
     CommandLine cmd;
 
 
-    cmd.AddValue ("SchedulerType", "in use scheduler type (0 - ROUND_ROBIN, 1 - MIN_RTT, 2 - BLEST, 3 - ECF, 4 - Peekaboo", schedulerType);
+    cmd.AddValue ("SchedulerType", "in use scheduler type (0 - ROUND_ROBIN, 1 - MIN_RTT, 2 - BLEST, 3 - ECF, 4 - Peekaboo, 5 - Deadline, 6 - Redundant, 7 - Selective redundant", schedulerType);
     cmd.AddValue ("BVar", "e.g. 100", bVar);
     cmd.AddValue ("BLambda", "e.g. 100", bLambda);
     cmd.AddValue ("MabRate", "e.g. 100", mrate);
@@ -111,7 +111,7 @@ main (int argc, char *argv[])
     cmd.AddValue ("Seed", "e.g. 80", seed);
     cmd.AddValue ("LossRate", "e.g. 0.0001", lossrate);
     cmd.AddValue ("Select", "e.g. 0.0001", mselect);
-    cmd.AddValue ("CcType", "in use congestion control type (0 - QuicNewReno, 1 - OLIA)", ccType);
+    cmd.AddValue ("CcType", "in use congestion control type (0 - QuicNewReno, 1 - OLIA, 2 - LIA, 3 - BALIA, 4 - wVegas, 5 - BBR)", ccType);
     cmd.Parse (argc, argv);
 
     NS_LOG_INFO("\n\n#################### SIMULATION SET-UP ####################\n\n\n");
@@ -128,14 +128,24 @@ main (int argc, char *argv[])
     if (ccType == QuicSocketBase::OLIA){
         ccTypeId = MpQuicCongestionOps::GetTypeId ();
     }
+    if (ccType == QuicSocketBase::LIA){
+        ccTypeId = MpQuicLia::GetTypeId ();
+    }
+    if (ccType == QuicSocketBase::BALIA){
+        ccTypeId = MpQuicBalia::GetTypeId ();
+    }
+    if (ccType == QuicSocketBase::WVEGAS){
+        ccTypeId = MpQuicWVegas::GetTypeId ();
+    }
+    if (ccType == QuicSocketBase::MPBBR){
+        ccTypeId = MpQuicBbr::GetTypeId ();
+    }
     if(ccType == QuicSocketBase::QuicNewReno){
         ccTypeId = QuicCongestionOps::GetTypeId ();
     }
 
     Config::SetDefault ("ns3::QuicSocketBase::SocketSndBufSize",UintegerValue (40000000));
     Config::SetDefault ("ns3::QuicStreamBase::StreamSndBufSize",UintegerValue (40000000));
-    Config::SetDefault ("ns3::QuicSocketBase::SocketRcvBufSize",UintegerValue (40000000));
-    Config::SetDefault ("ns3::QuicStreamBase::StreamRcvBufSize",UintegerValue (40000000));
 
 
     Config::SetDefault ("ns3::QuicSocketBase::EnableMultipath",BooleanValue(true));
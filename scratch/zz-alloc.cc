@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of a QUIC bulk transfer on the sender and
+// receiver data path. Two nodes are connected by a fast point-to-point link
+// and a BulkSendApplication transfers a fixed amount of data over QUIC. The
+// number of heap allocations performed while the simulation runs and its
+// wall-clock time are reported, along with the bytes received.
+
+// This file defines the counting operator new of the program
+#define QUIC_ALLOC_COUNTER
+
+#include <chrono>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/quic-module.h"
+#include "ns3/quic-alloc-counter.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("QuicBulkAllocBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint64_t maxBytes = 100 * 1024 * 1024;
+  std::string dataRate = "1Gbps";
+  std::string delay = "5ms";
+
+  CommandLine cmd;
+  cmd.AddValue ("maxBytes", "Number of bytes to transfer", maxBytes);
+  cmd.AddValue ("dataRate", "Rate of the link", dataRate);
+  cmd.AddValue ("delay", "One-way delay of the link", delay);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::QuicSocketBase::SocketSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketRcvBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamRcvBufSize", UintegerValue (40000000));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper link;
+  link.SetDeviceAttribute ("DataRate", StringValue (dataRate));
+  link.SetChannelAttribute ("Delay", StringValue (delay));
+  link.SetQueue ("ns3::DropTailQueue", "MaxSize", StringValue ("10000p"));
+  NetDeviceContainer devices = link.Install (nodes);
+
+  QuicHelper stack;
+  stack.InstallQuic (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  uint16_t port = 9;
+  MpquicBulkSendHelper source ("ns3::QuicSocketFactory", InetSocketAddress (interfaces.GetAddress (1), port));
+  source.SetAttribute ("MaxBytes", UintegerValue (maxBytes));
+  ApplicationContainer sourceApps = source.Install (nodes.Get (0));
+  sourceApps.Start (Seconds (1));
+
+  PacketSinkHelper sink ("ns3::QuicSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sink.Install (nodes.Get (1));
+  sinkApps.Start (Seconds (0));
+
+  Simulator::Stop (Seconds (1000));
+
+  uint64_t allocations = QuicAllocCounter::GetAllocations ();
+  auto start = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+  allocations = QuicAllocCounter::GetAllocations () - allocations;
+
+  Ptr<PacketSink> packetSink = DynamicCast<PacketSink> (sinkApps.Get (0));
+  std::cout << "received bytes\t" << packetSink->GetTotalRx () << std::endl;
+  std::cout << "allocations\t" << allocations << std::endl;
+  std::cout << "wall time (s)\t" << seconds << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
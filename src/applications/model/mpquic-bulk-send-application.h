@@ -19,8 +19,8 @@
  *         Shengjie Shu <shengjies@uvic.ca>
  */
 
-#ifndef BULK_SEND_APPLICATION_H
-#define BULK_SEND_APPLICATION_H
+#ifndef MPQUIC_BULK_SEND_APPLICATION_H
+#define MPQUIC_BULK_SEND_APPLICATION_H
 
 #include "ns3/address.h"
 #include "ns3/application.h"
@@ -158,4 +158,4 @@ private:
 
 } // namespace ns3
 
-#endif /* BULK_SEND_APPLICATION_H */
+#endif /* MPQUIC_BULK_SEND_APPLICATION_H */
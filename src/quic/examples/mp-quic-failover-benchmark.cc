@@ -0,0 +1,257 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures how an MPQUIC transfer survives the failure of its
+// fastest path or of its initial path. Two nodes are connected by two
+// point-to-point links, and the sender writes the whole file on the stream
+// once the connection is up. At FailTime the fast link (path 1) or the
+// initial one (path 0) either silently drops every packet, or the interface
+// of the sender on that link goes down, and it comes back after RecoverAfter
+// seconds if that is not zero. The same run is repeated for each path, without
+// and with the probing of the paths by the MpQuicPathManager, and the time
+// the sender took to fail or close the path, the longest time the receiver
+// went without data after the failure and the completion time of the
+// transfer are reported.
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/quic-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicFailoverBenchmark");
+
+static uint64_t g_rxBytes = 0;             //!< Bytes delivered to the receiving application
+static Time g_failTime;                    //!< Time the path fails
+static Time g_lastRx;                      //!< Time of the last delivery
+static Time g_longestStall;                //!< Longest time without delivery since the failure
+static Time g_detection;                   //!< Time the sender stopped using the failed path, zero if it did not
+static Time g_completion;                  //!< Time the last byte was delivered, zero if it was not
+
+/**
+ * Record a delivery to the receiving application
+ *
+ * \param size the size of the file
+ * \param packet the packet delivered to the application
+ * \param from the sender address
+ */
+static void
+Received (uint32_t size, Ptr<const Packet> packet, const Address &from)
+{
+  Time now = Simulator::Now ();
+  if (now > g_failTime)
+    {
+      g_longestStall = std::max (g_longestStall, now - std::max (g_lastRx, g_failTime));
+    }
+  g_lastRx = now;
+  g_rxBytes += packet->GetSize ();
+  if (g_rxBytes >= size and g_completion.IsZero ())
+    {
+      g_completion = now;
+    }
+}
+
+/**
+ * Record the first time the sender fails or closes a path after the failure
+ *
+ * \param pathId the path
+ * \param state the new state of the path
+ */
+static void
+PathStateChanged (uint8_t pathId, MpQuicSubFlow::SubflowStates_t state)
+{
+  Time now = Simulator::Now ();
+  if (now >= g_failTime and g_detection.IsZero ()
+      and (state == MpQuicSubFlow::Failed or state == MpQuicSubFlow::Closed))
+    {
+      g_detection = now;
+    }
+}
+
+/**
+ * Write the file on the stream
+ *
+ * \param socket the sending socket
+ * \param size the size of the file
+ */
+static void
+SendFile (Ptr<QuicSocketBase> socket, uint32_t size)
+{
+  socket->GetPathManager ()->TraceConnectWithoutContext ("PathState", MakeCallback (&PathStateChanged));
+  socket->Send (Create<Packet> (size), 1);
+}
+
+/**
+ * Make a link drop every packet, or deliver them again
+ *
+ * \param devices the devices of the link
+ * \param drop true to drop every packet
+ */
+static void
+SetLinkDrops (NetDeviceContainer devices, bool drop)
+{
+  for (uint32_t i = 0; i < devices.GetN (); i++)
+    {
+      Ptr<RateErrorModel> em = CreateObjectWithAttributes<RateErrorModel> (
+        "ErrorRate", DoubleValue (drop ? 1.0 : 0.0),
+        "ErrorUnit", StringValue ("ERROR_UNIT_PACKET"));
+      devices.Get (i)->SetAttribute ("ReceiveErrorModel", PointerValue (em));
+    }
+}
+
+/**
+ * Run a simulation and print the failover times
+ *
+ * \param probing true if the paths are probed
+ * \param silent true if the link drops the packets, false if the interface goes down
+ * \param failedPath the path that fails, 0 for the initial path and 1 for the fast path
+ * \param size the size of the file
+ * \param failTime the time the fast path fails
+ * \param recoverAfter the time after which the path recovers, zero if it does not
+ */
+static void
+Run (bool probing, bool silent, uint8_t failedPath, uint32_t size, Time failTime, Time recoverAfter)
+{
+  g_rxBytes = 0;
+  g_failTime = failTime;
+  g_lastRx = Time ();
+  g_longestStall = Time ();
+  g_detection = Time ();
+  g_completion = Time ();
+
+  Config::SetDefault ("ns3::MpQuicPathManager::EnableProbing", BooleanValue (probing));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  QuicHelper stack;
+  stack.InstallQuic (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("30ms"));
+  NetDeviceContainer d0 = p2p.Install (nodes);
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  NetDeviceContainer d1 = p2p.Install (nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i0 = ipv4.Assign (d0);
+  ipv4.SetBase ("10.1.2.0", "255.255.255.0");
+  ipv4.Assign (d1);
+
+  // Path 0 runs on the first interface of each node, path 1 on the second
+  Ptr<Ipv4> senderIpv4 = nodes.Get (0)->GetObject<Ipv4> ();
+  NetDeviceContainer failedDevices = failedPath == 0 ? d0 : d1;
+  uint32_t failedInterface = failedPath + 1;
+  if (silent)
+    {
+      Simulator::Schedule (failTime, &SetLinkDrops, failedDevices, true);
+    }
+  else
+    {
+      Simulator::Schedule (failTime, &Ipv4::SetDown, senderIpv4, failedInterface);
+    }
+  if (!recoverAfter.IsZero ())
+    {
+      if (silent)
+        {
+          Simulator::Schedule (failTime + recoverAfter, &SetLinkDrops, failedDevices, false);
+        }
+      else
+        {
+          Simulator::Schedule (failTime + recoverAfter, &Ipv4::SetUp, senderIpv4, failedInterface);
+        }
+    }
+
+  uint16_t port = 9;
+  PacketSinkHelper sinkHelper ("ns3::QuicSocketFactory",
+                               InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sinkHelper.Install (nodes.Get (1));
+  sinkApps.Get (0)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&Received, size));
+  sinkApps.Start (Seconds (0.0));
+
+  Ptr<Socket> socket = Socket::CreateSocket (nodes.Get (0), QuicSocketFactory::GetTypeId ());
+  socket->Bind ();
+  socket->Connect (InetSocketAddress (i0.GetAddress (1), port));
+  Simulator::Schedule (Seconds (1.0), &SendFile, DynamicCast<QuicSocketBase> (socket), size);
+
+  Simulator::Stop (failTime + Seconds (60.0));
+  Simulator::Run ();
+  if (g_completion.IsZero ())
+    {
+      // the receiver is still waiting
+      g_longestStall = std::max (g_longestStall, Simulator::Now () - std::max (g_lastRx, failTime));
+    }
+
+  std::cout << (uint16_t) failedPath << "\t" << (probing ? "on" : "off") << "\t";
+  if (g_detection.IsZero ())
+    {
+      std::cout << "-";
+    }
+  else
+    {
+      std::cout << (g_detection - failTime).GetMilliSeconds ();
+    }
+  std::cout << "\t" << g_longestStall.GetMilliSeconds () << "\t";
+  if (g_completion.IsZero ())
+    {
+      std::cout << "-";
+    }
+  else
+    {
+      std::cout << g_completion.GetSeconds ();
+    }
+  std::cout << "\t" << g_rxBytes << std::endl;
+
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t size = 5242880;
+  Time failTime = Seconds (2.0);
+  Time recoverAfter = Seconds (0);
+  bool silent = true;
+
+  CommandLine cmd;
+  cmd.AddValue ("Size", "Size of the file in bytes", size);
+  cmd.AddValue ("FailTime", "Time the path fails", failTime);
+  cmd.AddValue ("RecoverAfter", "Time after which the path recovers, 0 for never", recoverAfter);
+  cmd.AddValue ("Silent", "Drop every packet on the link instead of bringing the interface down", silent);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::QuicSocketBase::EnableMultipath", BooleanValue (true));
+  Config::SetDefault ("ns3::QuicSocketBase::CcType", IntegerValue (QuicSocketBase::OLIA));
+  Config::SetDefault ("ns3::QuicL4Protocol::SocketType", TypeIdValue (MpQuicCongestionOps::GetTypeId ()));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketRcvBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamRcvBufSize", UintegerValue (40000000));
+
+  std::cout << "path\tprobing\tdetection(ms)\tstall(ms)\tcompletion(s)\trx bytes" << std::endl;
+  for (uint8_t failedPath : {1, 0})
+    {
+      Run (false, silent, failedPath, size, failTime, recoverAfter);
+      Run (true, silent, failedPath, size, failTime, recoverAfter);
+    }
+
+  return 0;
+}
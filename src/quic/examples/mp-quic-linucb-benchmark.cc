@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of a decision of the Peekaboo scheduler,
+// i.e. scoring the fastest and the slow path with LinUCB and updating the
+// arm that was chosen. The "inverse" variant is the original one, which
+// inverts A with dynamically sized Eigen matrices at every decision; the
+// "incremental" variant uses MpQuicLinUcbArm, which keeps A^-1 up to date
+// with Sherman-Morrison updates. Both are fed the same contexts and rewards,
+// and the number of decisions that differ is reported along with the
+// decisions per second of each variant.
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "ns3/core-module.h"
+#include "ns3/quic-module.h"
+#include "ns3/mp-quic-linucb.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicLinUcbBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t decisions = 200000;
+
+  CommandLine cmd;
+  cmd.AddValue ("decisions", "Number of scheduling decisions", decisions);
+  cmd.Parse (argc, argv);
+
+  const int dim = MpQuicLinUcbArm::DIM;
+  const double alpha = 0.8;
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  std::vector<Eigen::VectorXd> contexts (decisions, Eigen::VectorXd (dim));
+  std::vector<double> rewards (decisions);
+  double reward = 0;
+  for (uint32_t n = 0; n < decisions; n++)
+    {
+      for (int j = 0; j < dim; j++)
+        {
+          contexts[n][j] = rng->GetValue (0, 1);
+        }
+      reward += rng->GetValue (0, 1);
+      rewards[n] = reward;
+    }
+
+  std::vector<uint8_t> inverseChoices (decisions);
+  Eigen::MatrixXd A[2] = {Eigen::MatrixXd::Identity (dim, dim), Eigen::MatrixXd::Identity (dim, dim)};
+  Eigen::VectorXd b[2] = {Eigen::VectorXd::Constant (dim, 0), Eigen::VectorXd::Constant (dim, 0)};
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t n = 0; n < decisions; n++)
+    {
+      const Eigen::VectorXd &x = contexts[n];
+      double EPR[2];
+      for (int i = 0; i < 2; i++)
+        {
+          Eigen::MatrixXd inverse = A[i].inverse ();
+          Eigen::VectorXd theta = inverse * b[i];
+          EPR[i] = x.dot (theta) + alpha * std::sqrt (x.transpose () * inverse * x);
+        }
+      uint8_t choice = EPR[0] > EPR[1] ? 0 : 1;
+      A[choice] = A[choice] + x * x.transpose ();
+      b[choice] = b[choice] + rewards[n] * x;
+      inverseChoices[n] = choice;
+    }
+  double inverseSeconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+  uint32_t mismatches = 0;
+  MpQuicLinUcbArm arms[2] = {MpQuicLinUcbArm (alpha), MpQuicLinUcbArm (alpha)};
+  start = std::chrono::steady_clock::now ();
+  for (uint32_t n = 0; n < decisions; n++)
+    {
+      MpQuicLinUcbArm::Vector x = contexts[n];
+      uint8_t choice = arms[0].GetScore (x) > arms[1].GetScore (x) ? 0 : 1;
+      arms[choice].Update (x, rewards[n]);
+      mismatches += (choice != inverseChoices[n]);
+    }
+  double incrementalSeconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+  std::cout << "variant\tdecisions/s" << std::endl;
+  std::cout << "inverse\t" << decisions / inverseSeconds << std::endl;
+  std::cout << "incremental\t" << decisions / incrementalSeconds << std::endl;
+  std::cout << "mismatches\t" << mismatches << std::endl;
+
+  return 0;
+}
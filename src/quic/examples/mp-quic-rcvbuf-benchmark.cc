@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the memory an MPQUIC receiver needs when the RTTs of
+// its paths differ. Two nodes are connected by a fast and a slow
+// point-to-point link of the same rate, and the sender writes the whole file
+// on the stream once the connection is up. The transfer is run with fixed
+// 40 MB receive buffers, as the scripts of the module used before the window
+// was autotuned, with fixed 128 KB buffers, and with the receive window
+// autotuned from 128 KB, and the completion time of the transfer, the
+// largest receive window of the receiver and the bytes delivered are
+// reported.
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/quic-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicRcvBufBenchmark");
+
+static uint64_t g_rxBytes = 0;             //!< Bytes delivered to the receiving application
+static Time g_completion;                  //!< Time the last byte was delivered, zero if it was not
+static uint32_t g_maxRcvWindow = 0;        //!< Largest receive window of the receiver
+
+/**
+ * Record a delivery to the receiving application
+ *
+ * \param size the size of the file
+ * \param packet the packet delivered to the application
+ * \param from the sender address
+ */
+static void
+Received (uint32_t size, Ptr<const Packet> packet, const Address &from)
+{
+  g_rxBytes += packet->GetSize ();
+  if (g_rxBytes >= size and g_completion.IsZero ())
+    {
+      g_completion = Simulator::Now ();
+    }
+}
+
+/**
+ * Record the receive window of the receiver
+ *
+ * \param oldValue the previous window
+ * \param newValue the new window
+ */
+static void
+RcvWindowChanged (uint32_t oldValue, uint32_t newValue)
+{
+  g_maxRcvWindow = std::max (g_maxRcvWindow, newValue);
+}
+
+/**
+ * Follow the receive window of the sockets of the receiver
+ *
+ * \param nodeId the receiving node
+ */
+static void
+FollowRcvWindow (uint32_t nodeId)
+{
+  std::ostringstream path;
+  path << "/NodeList/" << nodeId << "/$ns3::QuicL4Protocol/SocketList/*/QuicSocketBase/RcvWindow";
+  Config::ConnectWithoutContext (path.str (), MakeCallback (&RcvWindowChanged));
+}
+
+/**
+ * Write the file on the stream
+ *
+ * \param socket the sending socket
+ * \param size the size of the file
+ */
+static void
+SendFile (Ptr<Socket> socket, uint32_t size)
+{
+  socket->Send (Create<Packet> (size), 1);
+}
+
+/**
+ * Run a simulation and print the completion time and the receive window
+ *
+ * \param autoTuning true if the receive window is autotuned
+ * \param rcvBufSize the receive buffer size of the sockets and the streams
+ * \param size the size of the file
+ * \param slowDelay the delay of the slow link
+ */
+static void
+Run (bool autoTuning, uint32_t rcvBufSize, uint32_t size, Time slowDelay)
+{
+  g_rxBytes = 0;
+  g_completion = Time ();
+  g_maxRcvWindow = rcvBufSize;
+
+  Config::SetDefault ("ns3::QuicSocketBase::RcvBufAutoTuning", BooleanValue (autoTuning));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketRcvBufSize", UintegerValue (rcvBufSize));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamRcvBufSize", UintegerValue (rcvBufSize));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  QuicHelper stack;
+  stack.InstallQuic (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  NetDeviceContainer d0 = p2p.Install (nodes);
+  p2p.SetChannelAttribute ("Delay", TimeValue (slowDelay));
+  NetDeviceContainer d1 = p2p.Install (nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i0 = ipv4.Assign (d0);
+  ipv4.SetBase ("10.1.2.0", "255.255.255.0");
+  ipv4.Assign (d1);
+
+  uint16_t port = 9;
+  PacketSinkHelper sinkHelper ("ns3::QuicSocketFactory",
+                               InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sinkHelper.Install (nodes.Get (1));
+  sinkApps.Get (0)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&Received, size));
+  sinkApps.Start (Seconds (0.0));
+  Simulator::Schedule (Seconds (1.0), &FollowRcvWindow, nodes.Get (1)->GetId ());
+
+  Ptr<Socket> socket = Socket::CreateSocket (nodes.Get (0), QuicSocketFactory::GetTypeId ());
+  socket->Bind ();
+  socket->Connect (InetSocketAddress (i0.GetAddress (1), port));
+  Simulator::Schedule (Seconds (1.0), &SendFile, socket, size);
+
+  Simulator::Stop (Seconds (60.0));
+  Simulator::Run ();
+
+  std::cout << (autoTuning ? "on" : "off") << "\t" << rcvBufSize << "\t";
+  if (g_completion.IsZero ())
+    {
+      std::cout << "-";
+    }
+  else
+    {
+      std::cout << g_completion.GetSeconds ();
+    }
+  std::cout << "\t" << g_maxRcvWindow << "\t" << g_rxBytes << std::endl;
+
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t size = 5242880;
+  Time slowDelay = MilliSeconds (100);
+
+  CommandLine cmd;
+  cmd.AddValue ("Size", "Size of the file in bytes", size);
+  cmd.AddValue ("SlowDelay", "Delay of the slow link", slowDelay);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::QuicSocketBase::EnableMultipath", BooleanValue (true));
+  Config::SetDefault ("ns3::QuicSocketBase::CcType", IntegerValue (QuicSocketBase::OLIA));
+  Config::SetDefault ("ns3::QuicL4Protocol::SocketType", TypeIdValue (MpQuicCongestionOps::GetTypeId ()));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamSndBufSize", UintegerValue (40000000));
+
+  std::cout << "autotuning\trcvbuf(B)\tcompletion(s)\tmax window(B)\trx bytes" << std::endl;
+  Run (false, 40000000, size, slowDelay);
+  Run (false, 131072, size, slowDelay);
+  Run (true, 131072, size, slowDelay);
+
+  return 0;
+}
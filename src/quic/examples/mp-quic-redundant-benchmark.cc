@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the tail latency of short messages sent over a
+// lossy two-path MPQUIC connection. Two nodes are connected by two
+// point-to-point links that drop packets at the given rate. The sender writes
+// a message on the stream at a fixed interval, and a message completes when
+// all its bytes have been delivered in order to the receiving application.
+// The same run is repeated with the MinRTT, redundant and selective redundant
+// schedulers, and the median, 99th percentile and maximum completion times
+// are reported, along with the number of packets sent by the sender.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/quic-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicRedundantBenchmark");
+
+static std::vector<Time> g_sendTimes;      //!< Time each message was written
+static std::vector<Time> g_completions;    //!< Completion time of each delivered message
+static uint64_t g_rxBytes = 0;             //!< Bytes delivered to the receiving application
+static uint32_t g_messageSize = 0;         //!< Size of a message
+static uint64_t g_txPackets = 0;           //!< Packets sent by the sender
+
+/**
+ * Write a message on the stream and schedule the next one
+ *
+ * \param socket the sending socket
+ * \param remaining the number of messages still to send
+ * \param interval the time between two messages
+ */
+static void
+SendMessage (Ptr<Socket> socket, uint32_t remaining, Time interval)
+{
+  g_sendTimes.push_back (Simulator::Now ());
+  socket->Send (Create<Packet> (g_messageSize), 1);
+  if (remaining > 1)
+    {
+      Simulator::Schedule (interval, &SendMessage, socket, remaining - 1, interval);
+    }
+}
+
+/**
+ * Record the completion of the messages delivered by a packet
+ *
+ * \param packet the packet delivered to the application
+ * \param from the sender address
+ */
+static void
+Received (Ptr<const Packet> packet, const Address &from)
+{
+  g_rxBytes += packet->GetSize ();
+  while ((g_completions.size () + 1) * (uint64_t) g_messageSize <= g_rxBytes
+         && g_completions.size () < g_sendTimes.size ())
+    {
+      g_completions.push_back (Simulator::Now () - g_sendTimes[g_completions.size ()]);
+    }
+}
+
+/**
+ * Count a packet sent by the sender
+ *
+ * \param packet the packet
+ */
+static void
+Transmitted (Ptr<const Packet> packet)
+{
+  g_txPackets++;
+}
+
+/**
+ * \param sorted the sorted completion times
+ * \param p the percentile, in [0, 1]
+ * \return the completion time at the given percentile
+ */
+static double
+Percentile (const std::vector<Time> &sorted, double p)
+{
+  uint32_t index = std::min<uint32_t> (sorted.size () - 1, p * sorted.size ());
+  return sorted[index].GetMilliSeconds ();
+}
+
+/**
+ * Run a simulation with the given scheduler and print its completion times
+ *
+ * \param name the name of the scheduler
+ * \param type the scheduler type
+ * \param messages the number of messages
+ * \param interval the time between two messages
+ * \param lossRate the packet error rate of the links
+ */
+static void
+Run (std::string name, int16_t type, uint32_t messages, Time interval, double lossRate)
+{
+  g_sendTimes.clear ();
+  g_completions.clear ();
+  g_rxBytes = 0;
+  g_txPackets = 0;
+
+  Config::SetDefault ("ns3::MpQuicScheduler::SchedulerType", IntegerValue (type));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  QuicHelper stack;
+  stack.InstallQuic (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("20ms"));
+  NetDeviceContainer d0 = p2p.Install (nodes);
+  p2p.SetChannelAttribute ("Delay", StringValue ("30ms"));
+  NetDeviceContainer d1 = p2p.Install (nodes);
+
+  // The links drop the packets towards the receiver once the connection is
+  // established, with the same losses in every run
+  int64_t stream = 0;
+  for (NetDeviceContainer devices : {d0, d1})
+    {
+      Ptr<RateErrorModel> em = CreateObjectWithAttributes<RateErrorModel> (
+        "RanVar", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
+        "ErrorRate", DoubleValue (lossRate),
+        "ErrorUnit", StringValue ("ERROR_UNIT_PACKET"));
+      stream += em->AssignStreams (stream);
+      Simulator::Schedule (Seconds (1.0), &NetDevice::SetAttribute, devices.Get (1),
+                           "ReceiveErrorModel", PointerValue (em));
+      devices.Get (0)->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&Transmitted));
+    }
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i0 = ipv4.Assign (d0);
+  ipv4.SetBase ("10.1.2.0", "255.255.255.0");
+  ipv4.Assign (d1);
+
+  uint16_t port = 9;
+  PacketSinkHelper sinkHelper ("ns3::QuicSocketFactory",
+                               InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sinkHelper.Install (nodes.Get (1));
+  sinkApps.Get (0)->TraceConnectWithoutContext ("Rx", MakeCallback (&Received));
+  sinkApps.Start (Seconds (0.0));
+
+  Ptr<Socket> socket = Socket::CreateSocket (nodes.Get (0), QuicSocketFactory::GetTypeId ());
+  socket->Bind ();
+  socket->Connect (InetSocketAddress (i0.GetAddress (1), port));
+  Simulator::Schedule (Seconds (1.0), &SendMessage, socket, messages, interval);
+
+  Simulator::Stop (Seconds (1.0) + interval * messages + Seconds (10.0));
+  Simulator::Run ();
+
+  std::vector<Time> sorted = g_completions;
+  std::sort (sorted.begin (), sorted.end ());
+  std::cout << name << "\t" << g_completions.size () << "/" << g_sendTimes.size () << "\t";
+  if (sorted.empty ())
+    {
+      std::cout << "-\t-\t-";
+    }
+  else
+    {
+      std::cout << Percentile (sorted, 0.5) << "\t" << Percentile (sorted, 0.99) << "\t"
+                << sorted.back ().GetMilliSeconds ();
+    }
+  std::cout << "\t" << g_txPackets << std::endl;
+
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t messages = 500;
+  uint32_t messageSize = 2400;
+  Time interval = MilliSeconds (20);
+  double lossRate = 0.005;
+
+  CommandLine cmd;
+  cmd.AddValue ("Messages", "Number of messages", messages);
+  cmd.AddValue ("MessageSize", "Size of a message in bytes", messageSize);
+  cmd.AddValue ("Interval", "Time between two messages", interval);
+  cmd.AddValue ("LossRate", "Packet error rate of the links", lossRate);
+  cmd.Parse (argc, argv);
+  g_messageSize = messageSize;
+
+  Config::SetDefault ("ns3::QuicSocketBase::EnableMultipath", BooleanValue (true));
+  Config::SetDefault ("ns3::QuicSocketBase::CcType", IntegerValue (QuicSocketBase::OLIA));
+  Config::SetDefault ("ns3::QuicL4Protocol::SocketType", TypeIdValue (MpQuicCongestionOps::GetTypeId ()));
+
+  std::cout << "scheduler\tmessages\tp50(ms)\tp99(ms)\tmax(ms)\tpackets" << std::endl;
+  Run ("MinRTT", MpQuicScheduler::MIN_RTT, messages, interval, lossRate);
+  Run ("Redundant", MpQuicScheduler::REDUNDANT, messages, interval, lossRate);
+  Run ("SelectiveRedundant", MpQuicScheduler::SELECTIVE_REDUNDANT, messages, interval, lossRate);
+
+  return 0;
+}
@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of the loss detection and ACK timers of a
+// lossy two-path MPQUIC transfer. Two nodes are connected by two
+// point-to-point links that drop packets at the given rate, and the sender
+// writes the whole file on the stream once the connection is up. The same
+// run is repeated with every timer scheduling its own events and with the
+// timers of each connection served by a QuicTimerWheel, and the number of
+// simulator events per packet sent, the longest time the receiver went
+// without data and the completion time of the transfer are reported.
+
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/quic-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicTimerBenchmark");
+
+static uint64_t g_rxBytes = 0;             //!< Bytes delivered to the receiving application
+static uint64_t g_txPackets = 0;           //!< Packets sent by both nodes
+static Time g_lastRx;                      //!< Time of the last delivery
+static Time g_longestStall;                //!< Longest time without delivery once the transfer started
+static Time g_completion;                  //!< Time the last byte was delivered, zero if it was not
+
+/**
+ * Record a delivery to the receiving application
+ *
+ * \param size the size of the file
+ * \param packet the packet delivered to the application
+ * \param from the sender address
+ */
+static void
+Received (uint32_t size, Ptr<const Packet> packet, const Address &from)
+{
+  Time now = Simulator::Now ();
+  if (!g_lastRx.IsZero ())
+    {
+      g_longestStall = std::max (g_longestStall, now - g_lastRx);
+    }
+  g_lastRx = now;
+  g_rxBytes += packet->GetSize ();
+  if (g_rxBytes >= size and g_completion.IsZero ())
+    {
+      g_completion = now;
+    }
+}
+
+/**
+ * Count a packet sent on a link
+ *
+ * \param packet the packet
+ */
+static void
+Transmitted (Ptr<const Packet> packet)
+{
+  g_txPackets++;
+}
+
+/**
+ * Write the file on the stream
+ *
+ * \param socket the sending socket
+ * \param size the size of the file
+ */
+static void
+SendFile (Ptr<Socket> socket, uint32_t size)
+{
+  socket->Send (Create<Packet> (size), 1);
+}
+
+/**
+ * Run a simulation and print the events per packet and the transfer times
+ *
+ * \param wheel true if the timers are served by a QuicTimerWheel
+ * \param size the size of the file
+ * \param lossRate the packet error rate of the links
+ */
+static void
+Run (bool wheel, uint32_t size, double lossRate)
+{
+  g_rxBytes = 0;
+  g_txPackets = 0;
+  g_lastRx = Time ();
+  g_longestStall = Time ();
+  g_completion = Time ();
+
+  Config::SetDefault ("ns3::QuicSocketBase::EnableTimerWheel", BooleanValue (wheel));
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  QuicHelper stack;
+  stack.InstallQuic (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("20ms"));
+  NetDeviceContainer d0 = p2p.Install (nodes);
+  p2p.SetChannelAttribute ("Delay", StringValue ("30ms"));
+  NetDeviceContainer d1 = p2p.Install (nodes);
+
+  // The links drop the packets in both directions once the connection is
+  // established, with the same losses in every run
+  int64_t stream = 0;
+  for (NetDeviceContainer devices : {d0, d1})
+    {
+      for (uint32_t i = 0; i < devices.GetN (); i++)
+        {
+          Ptr<RateErrorModel> em = CreateObjectWithAttributes<RateErrorModel> (
+            "RanVar", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
+            "ErrorRate", DoubleValue (lossRate),
+            "ErrorUnit", StringValue ("ERROR_UNIT_PACKET"));
+          stream += em->AssignStreams (stream);
+          Simulator::Schedule (Seconds (1.0), &NetDevice::SetAttribute, devices.Get (i),
+                               "ReceiveErrorModel", PointerValue (em));
+          devices.Get (i)->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&Transmitted));
+        }
+    }
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i0 = ipv4.Assign (d0);
+  ipv4.SetBase ("10.1.2.0", "255.255.255.0");
+  ipv4.Assign (d1);
+
+  uint16_t port = 9;
+  PacketSinkHelper sinkHelper ("ns3::QuicSocketFactory",
+                               InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sinkHelper.Install (nodes.Get (1));
+  sinkApps.Get (0)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&Received, size));
+  sinkApps.Start (Seconds (0.0));
+
+  Ptr<Socket> socket = Socket::CreateSocket (nodes.Get (0), QuicSocketFactory::GetTypeId ());
+  socket->Bind ();
+  socket->Connect (InetSocketAddress (i0.GetAddress (1), port));
+  Simulator::Schedule (Seconds (1.0), &SendFile, socket, size);
+
+  Simulator::Stop (Seconds (60.0));
+  Simulator::Run ();
+
+  std::cout << (wheel ? "on" : "off") << "\t" << Simulator::GetEventCount () << "\t" << g_txPackets << "\t"
+            << (double) Simulator::GetEventCount () / g_txPackets << "\t"
+            << g_longestStall.GetMilliSeconds () << "\t";
+  if (g_completion.IsZero ())
+    {
+      std::cout << "-";
+    }
+  else
+    {
+      std::cout << g_completion.GetSeconds ();
+    }
+  std::cout << "\t" << g_rxBytes << std::endl;
+
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t size = 5242880;
+  double lossRate = 0.01;
+
+  CommandLine cmd;
+  cmd.AddValue ("Size", "Size of the file in bytes", size);
+  cmd.AddValue ("LossRate", "Packet error rate of the links", lossRate);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::QuicSocketBase::EnableMultipath", BooleanValue (true));
+  Config::SetDefault ("ns3::QuicSocketBase::CcType", IntegerValue (QuicSocketBase::OLIA));
+  Config::SetDefault ("ns3::QuicL4Protocol::SocketType", TypeIdValue (MpQuicCongestionOps::GetTypeId ()));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamSndBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicSocketBase::SocketRcvBufSize", UintegerValue (40000000));
+  Config::SetDefault ("ns3::QuicStreamBase::StreamRcvBufSize", UintegerValue (40000000));
+
+  std::cout << "wheel\tevents\tpackets\tevents/packet\tstall(ms)\tcompletion(s)\trx bytes" << std::endl;
+  Run (false, size, lossRate);
+  Run (true, size, lossRate);
+
+  return 0;
+}
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program measures the cost of handling QuicSubheaders of STREAM and
+// MP_ACK frames. For each frame type, the stream ID and offset peek used by
+// the send buffer and schedulers, a full PeekHeader, Serialize and
+// Deserialize are each run a large number of times. The wall-clock time and
+// the number of heap allocations per operation are reported.
+
+// This file defines the counting operator new of the program
+#define QUIC_ALLOC_COUNTER
+
+#include <chrono>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/quic-module.h"
+#include "ns3/quic-alloc-counter.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("QuicSubheaderBenchmark");
+
+static volatile uint64_t g_sink = 0;
+
+/**
+ * Run an operation and print its cost
+ *
+ * \param frame the name of the frame type
+ * \param op the name of the operation
+ * \param iterations the number of runs
+ * \param f the operation, returning a value derived from the frame
+ */
+template <typename F>
+static void
+Measure (std::string frame, std::string op, uint32_t iterations, F f)
+{
+  uint64_t allocations = QuicAllocCounter::GetAllocations ();
+  uint64_t sum = 0;
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      sum += f ();
+    }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds> (
+    std::chrono::steady_clock::now () - start);
+  g_sink = g_sink + sum;
+
+  std::cout << frame << "\t" << op << "\t"
+            << double (elapsed.count ()) / iterations << "\t"
+            << double (QuicAllocCounter::GetAllocations () - allocations) / iterations << std::endl;
+}
+
+/**
+ * Measure the operations on a subheader
+ *
+ * \param frame the name of the frame type
+ * \param sub the subheader
+ * \param iterations the number of runs of each operation
+ */
+static void
+MeasureSubheader (std::string frame, const QuicSubheader &sub, uint32_t iterations)
+{
+  Ptr<Packet> packet = Create<Packet> (1200);
+  packet->AddHeader (sub);
+  Buffer buffer;
+  buffer.AddAtStart (sub.GetSerializedSize ());
+
+  if (sub.IsStream ())
+    {
+      Measure (frame, "peek", iterations, [&] ()
+               {
+                 uint64_t streamId, offset;
+                 QuicSubheader::PeekStreamIdAndOffset (packet, streamId, offset);
+                 return streamId + offset;
+               });
+    }
+  Measure (frame, "peek-full", iterations, [&] ()
+           {
+             QuicSubheader peeked;
+             packet->PeekHeader (peeked);
+             return peeked.GetStreamId () + peeked.GetLargestAcknowledged ();
+           });
+  Measure (frame, "serialize", iterations, [&] ()
+           {
+             sub.Serialize (buffer.Begin ());
+             return buffer.GetSize ();
+           });
+  Measure (frame, "deserialize", iterations, [&] ()
+           {
+             QuicSubheader deserialized;
+             return deserialized.Deserialize (buffer.Begin ());
+           });
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t iterations = 1000000;
+  uint32_t ackBlocks = 4;
+
+  CommandLine cmd;
+  cmd.AddValue ("iterations", "Number of runs of each operation", iterations);
+  cmd.AddValue ("ackBlocks", "Number of additional blocks in the MP_ACK frame", ackBlocks);
+  cmd.Parse (argc, argv);
+
+  std::cout << "frame\toperation\tns/op\tallocs/op" << std::endl;
+
+  QuicSubheader stream = QuicSubheader::CreateStreamSubHeader (4, 1234567, 1200, true, true, false);
+  MeasureSubheader ("STREAM", stream, iterations);
+
+  // Blocks of 10 packets, each followed by a gap of 5 packets
+  uint32_t largest = 100000;
+  QuicAckBlocks gaps;
+  QuicAckBlocks additionalAckBlocks;
+  for (uint32_t j = 0; j < ackBlocks; j++)
+    {
+      gaps.push_back (largest - 15 * j - 10);
+      additionalAckBlocks.push_back (largest - 15 * (j + 1));
+    }
+  QuicSubheader ack = QuicSubheader::CreateMpAck (largest, 100, largest, gaps, additionalAckBlocks, 1);
+  MeasureSubheader ("MP_ACK", ack, iterations);
+
+  return 0;
+}
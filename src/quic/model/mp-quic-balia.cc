@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-balia.h"
+
+#include <cmath>
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicBalia");
+
+NS_OBJECT_ENSURE_REGISTERED (MpQuicBalia);
+
+TypeId
+MpQuicBalia::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MpQuicBalia")
+    .SetParent<MpQuicCongestionOps> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<MpQuicBalia> ()
+  ;
+  return tid;
+}
+
+MpQuicBalia::MpQuicBalia (void)
+  : MpQuicCongestionOps ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicBalia::MpQuicBalia (const MpQuicBalia& sock)
+  : MpQuicCongestionOps (sock)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicBalia::~MpQuicBalia (void)
+{}
+
+std::string
+MpQuicBalia::GetName () const
+{
+  return "MpQuicCongestionControl_BALIA";
+}
+
+Ptr<TcpCongestionOps>
+MpQuicBalia::Fork ()
+{
+  return CopyObject<MpQuicBalia> (this);
+}
+
+double
+MpQuicBalia::GetAlpha (Ptr<QuicSocketState> tcbd, const MpQuicCoupledState &coupled) const
+{
+  double rtt = tcbd->m_smoothedRtt.GetSeconds ();
+  if (rtt == 0 || coupled.GetMaxRate () == 0)
+    {
+      return 1;
+    }
+  return coupled.GetMaxRate () / (tcbd->m_cWnd.Get () / rtt);
+}
+
+void
+MpQuicBalia::CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                  uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  double mss = tcbd->m_segmentSize;
+  double bytesAcked = ackedPacket->m_packet->GetSize ();
+  double rtt = tcbd->m_smoothedRtt.GetSeconds ();
+  if (rtt == 0 || coupled.GetSumRate () == 0)
+    {
+      AddToCwnd (tcbd, bytesAcked * mss / tcbd->m_cWnd.Get ());
+      return;
+    }
+
+  double rate = tcbd->m_cWnd.Get () / rtt;
+  double alpha = GetAlpha (tcbd, coupled);
+  double increase = rate * mss * bytesAcked / (rtt * std::pow (coupled.GetSumRate (), 2))
+                    * (1 + alpha) / 2 * (4 + alpha) / 5;
+  NS_LOG_LOGIC ("BALIA alpha " << alpha << " increase " << increase);
+  AddToCwnd (tcbd, increase);
+}
+
+double
+MpQuicBalia::GetLossReduction (Ptr<QuicSocketState> tcbd, uint8_t pathId,
+                               const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  return 1 - std::min (GetAlpha (tcbd, coupled), 1.5) / 2;
+}
+
+} // namespace ns3
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICBALIA_H
+#define MPQUICBALIA_H
+
+#include "mp-quic-congestion-ops.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Balanced Linked Adaptation (BALIA)
+ *
+ * With x_r = cWnd_r / rtt_r the rate of path r and alpha_r = max (x) / x_r,
+ * the window of path r grows by
+ * x_r / (rtt_r * sum (x)^2) * (1 + alpha_r) / 2 * (4 + alpha_r) / 5
+ * packets per packet acked, and is reduced by cWnd_r / 2 * min (alpha_r, 1.5)
+ * on a loss. With a single path, BALIA behaves as NewReno.
+ */
+class MpQuicBalia : public MpQuicCongestionOps
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicBalia ();
+  MpQuicBalia (const MpQuicBalia& sock);
+  ~MpQuicBalia ();
+
+  std::string GetName () const;
+  Ptr<TcpCongestionOps> Fork ();
+
+protected:
+  virtual void CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                    uint8_t pathId, const MpQuicCoupledState &coupled);
+  virtual double GetLossReduction (Ptr<QuicSocketState> tcbd, uint8_t pathId, const MpQuicCoupledState &coupled);
+
+private:
+  /**
+   * \brief Get the alpha of a path, max (x) / x_r
+   *
+   * \param tcbd the state of the path
+   * \param coupled the state of all the paths of the connection
+   * \return alpha, or 1 if the rates are not known yet
+   */
+  double GetAlpha (Ptr<QuicSocketState> tcbd, const MpQuicCoupledState &coupled) const;
+};
+
+} // namespace ns3
+
+#endif /* MPQUICBALIA_H */
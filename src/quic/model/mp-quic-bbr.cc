@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-bbr.h"
+
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicBbr");
+
+NS_OBJECT_ENSURE_REGISTERED (MpQuicBbr);
+
+TypeId
+MpQuicBbr::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MpQuicBbr")
+    .SetParent<MpQuicCongestionOps> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<MpQuicBbr> ()
+  ;
+  return tid;
+}
+
+MpQuicBbr::MpQuicBbr (void)
+  : MpQuicCongestionOps ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicBbr::MpQuicBbr (const MpQuicBbr& sock)
+  : MpQuicCongestionOps (sock)
+{
+  NS_LOG_FUNCTION (this);
+  // The paths belong to the socket being copied: the new socket starts
+  // its own as they are acknowledged
+}
+
+MpQuicBbr::~MpQuicBbr (void)
+{}
+
+std::string
+MpQuicBbr::GetName () const
+{
+  return "MpQuicCongestionControl_BBR";
+}
+
+Ptr<TcpCongestionOps>
+MpQuicBbr::Fork ()
+{
+  return CopyObject<MpQuicBbr> (this);
+}
+
+Ptr<QuicBbr>
+MpQuicBbr::GetPathBbr (uint8_t pathId) const
+{
+  return pathId < m_paths.size () ? m_paths[pathId] : 0;
+}
+
+Ptr<QuicBbr>
+MpQuicBbr::GetOrCreatePath (Ptr<QuicSocketState> tcb, uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  if (pathId >= m_paths.size ())
+    {
+      m_paths.resize (pathId + 1);
+      m_tcbs.resize (pathId + 1);
+    }
+  if (m_paths[pathId] == 0)
+    {
+      NS_LOG_INFO ("Starting BBR on path " << (uint16_t) pathId);
+      m_paths[pathId] = CreateObject<QuicBbr> ();
+      m_tcbs[pathId] = tcb;
+      m_paths[pathId]->CongestionStateSet (tcb, TcpSocketState::CA_OPEN);
+    }
+  return m_paths[pathId];
+}
+
+Ptr<QuicBbr>
+MpQuicBbr::FindPath (Ptr<const TcpSocketState> tcb) const
+{
+  for (uint32_t i = 0; i < m_tcbs.size (); i++)
+    {
+      if (PeekPointer (m_tcbs[i]) == PeekPointer (tcb))
+        {
+          return m_paths[i];
+        }
+    }
+  return 0;
+}
+
+void
+MpQuicBbr::CouplePacingRate (Ptr<QuicSocketState> tcb, uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  Ptr<QuicBbr> bbr = m_paths[pathId];
+  if (bbr->m_state.Get () != QuicBbr::BBR_PROBE_BW || bbr->m_pacingGain <= 1)
+    {
+      return;
+    }
+
+  double sumBw = 0;
+  for (uint32_t i = 0; i < m_paths.size (); i++)
+    {
+      if (m_paths[i] != 0)
+        {
+          sumBw += m_paths[i]->m_maxBwFilter.GetBest ().GetBitRate ();
+        }
+    }
+  double bw = bbr->m_maxBwFilter.GetBest ().GetBitRate ();
+  if (sumBw == 0)
+    {
+      return;
+    }
+
+  double gain = 1 + (bbr->m_pacingGain - 1) * bw / sumBw;
+  DataRate rate = std::min (DataRate (gain * bw), tcb->m_maxPacingRate);
+  NS_LOG_DEBUG ("Path " << (uint16_t) pathId << " probing with gain " << gain << " instead of " <<
+                bbr->m_pacingGain << ", pacing rate " << rate);
+  tcb->m_pacingRate = rate;
+}
+
+void
+MpQuicBbr::OnAckReceived (Ptr<TcpSocketState> tcb, QuicSubheader &ack,
+                          std::vector<Ptr<QuicSocketTxItem> > newAcks,
+                          const struct RateSample *rs, uint8_t pathId,
+                          const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  NS_UNUSED (coupled);
+  Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
+  NS_ASSERT_MSG (tcbd != 0, "tcb is not a QuicSocketState");
+
+  GetOrCreatePath (tcbd, pathId)->OnAckReceived (tcb, ack, newAcks, rs);
+  CouplePacingRate (tcbd, pathId);
+}
+
+void
+MpQuicBbr::OnPacketsLost (Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<QuicBbr> bbr = FindPath (tcb);
+  if (bbr != 0)
+    {
+      bbr->OnPacketsLost (tcb, lostPackets);
+    }
+}
+
+void
+MpQuicBbr::OnPacketsLost (Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets,
+                          uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  NS_UNUSED (coupled);
+  Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
+  NS_ASSERT_MSG (tcbd != 0, "tcb is not a QuicSocketState");
+
+  GetOrCreatePath (tcbd, pathId)->OnPacketsLost (tcb, lostPackets);
+}
+
+void
+MpQuicBbr::CongestionStateSet (Ptr<TcpSocketState> tcb,
+                               const TcpSocketState::TcpCongState_t newState)
+{
+  NS_LOG_FUNCTION (this << tcb << newState);
+  // Paths are initialized on their first ACK, when their ID is known
+  Ptr<QuicBbr> bbr = FindPath (tcb);
+  if (bbr != 0)
+    {
+      bbr->CongestionStateSet (tcb, newState);
+    }
+}
+
+void
+MpQuicBbr::CwndEvent (Ptr<TcpSocketState> tcb,
+                      const TcpSocketState::TcpCAEvent_t event)
+{
+  NS_LOG_FUNCTION (this << tcb << event);
+  Ptr<QuicBbr> bbr = FindPath (tcb);
+  if (bbr != 0)
+    {
+      bbr->CwndEvent (tcb, event);
+    }
+}
+
+uint32_t
+MpQuicBbr::GetSsThresh (Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
+{
+  NS_LOG_FUNCTION (this << tcb << bytesInFlight);
+  Ptr<QuicBbr> bbr = FindPath (tcb);
+  if (bbr != 0)
+    {
+      return bbr->GetSsThresh (tcb, bytesInFlight);
+    }
+  return tcb->m_initialSsThresh;
+}
+
+void
+MpQuicBbr::IncreaseWindow (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
+{
+  NS_UNUSED (tcb);
+  NS_UNUSED (segmentsAcked);
+}
+
+} // namespace ns3
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICBBR_H
+#define MPQUICBBR_H
+
+#include <vector>
+#include "mp-quic-congestion-ops.h"
+#include "quic-bbr.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Multipath BBR, a model-based coupled congestion control
+ *
+ * Each path runs its own QuicBbr instance, with its own bottleneck bandwidth
+ * filter, RTprop filter, gain cycle and ProbeRTT schedule, fed with the rate
+ * sample of the path. The paths are coupled through the pacing gain of
+ * ProbeBW: the extra rate a path probes for is scaled by the share of the
+ * path in the sum of the estimated bottleneck bandwidths, so that the paths
+ * probing at the same time do not push the aggregate rate much above the sum
+ * of the bottlenecks. The resulting rate is written in the QuicSocketState of
+ * the path, which drives the pacer of the subflow.
+ */
+class MpQuicBbr : public MpQuicCongestionOps
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicBbr ();
+  MpQuicBbr (const MpQuicBbr& sock);
+  ~MpQuicBbr ();
+
+  std::string GetName () const;
+  Ptr<TcpCongestionOps> Fork ();
+
+  virtual void CongestionStateSet (Ptr<TcpSocketState> tcb,
+                                   const TcpSocketState::TcpCongState_t newState);
+  virtual void CwndEvent (Ptr<TcpSocketState> tcb,
+                          const TcpSocketState::TcpCAEvent_t event);
+  virtual uint32_t GetSsThresh (Ptr<const TcpSocketState> tcb,
+                                uint32_t bytesInFlight);
+  virtual void IncreaseWindow (Ptr<TcpSocketState> tcb,
+                               uint32_t segmentsAcked);
+
+  virtual void OnAckReceived (Ptr<TcpSocketState> tcb, QuicSubheader &ack, std::vector<Ptr<QuicSocketTxItem> > newAcks,
+                              const struct RateSample *rs, uint8_t pathId, const MpQuicCoupledState &coupled);
+  virtual void OnPacketsLost (Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets);
+  virtual void OnPacketsLost (Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets,
+                              uint8_t pathId, const MpQuicCoupledState &coupled);
+
+  /**
+   * \brief Get the BBR instance of a path
+   *
+   * \param pathId the path
+   * \return the instance, or 0 if the path has not been acknowledged yet
+   */
+  Ptr<QuicBbr> GetPathBbr (uint8_t pathId) const;
+
+private:
+  /**
+   * \brief Get the BBR instance of a path, creating and initializing it on first use
+   *
+   * \param tcb the state of the path
+   * \param pathId the path
+   * \return the instance
+   */
+  Ptr<QuicBbr> GetOrCreatePath (Ptr<QuicSocketState> tcb, uint8_t pathId);
+
+  /**
+   * \brief Find the BBR instance driving a given path state
+   *
+   * \param tcb the state of the path
+   * \return the instance, or 0 if the state does not belong to a known path
+   */
+  Ptr<QuicBbr> FindPath (Ptr<const TcpSocketState> tcb) const;
+
+  /**
+   * \brief Scale the ProbeBW pacing gain of a path by its share of the total bottleneck bandwidth
+   *
+   * \param tcb the state of the path
+   * \param pathId the path
+   */
+  void CouplePacingRate (Ptr<QuicSocketState> tcb, uint8_t pathId);
+
+  std::vector<Ptr<QuicBbr> > m_paths;          //!< BBR instance of each path, indexed by path ID
+  std::vector<Ptr<QuicSocketState> > m_tcbs;   //!< State of each path, indexed by path ID
+};
+
+} // namespace ns3
+
+#endif /* MPQUICBBR_H */
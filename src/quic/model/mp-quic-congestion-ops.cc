@@ -25,6 +25,7 @@
 
 #define __STDC_LIMIT_MACROS
 
+#include <cmath>
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
@@ -99,7 +100,8 @@ void
 MpQuicCongestionOps::OnAckReceived (Ptr<TcpSocketState> tcb,
                                   QuicSubheader &ack,
                                   std::vector<Ptr<QuicSocketTxItem> > newAcks,
-                                  const struct RateSample *rs, double alpha, double sum_rate)
+                                  const struct RateSample *rs, uint8_t pathId,
+                                  const MpQuicCoupledState &coupled)
 {
   NS_LOG_FUNCTION (this);
   NS_UNUSED (rs);
@@ -127,7 +129,7 @@ MpQuicCongestionOps::OnAckReceived (Ptr<TcpSocketState> tcb,
       if ((*it)->m_acked)
         {
           m_inCCAvoid = false;
-          OnPacketAcked (tcb, (*it), alpha, sum_rate);
+          OnPacketAcked (tcb, (*it), pathId, coupled);
           if (m_inCCAvoid)
           {
             return;
@@ -171,21 +173,22 @@ MpQuicCongestionOps::UpdateRtt (Ptr<TcpSocketState> tcb, Time latestRtt,
     {
       Time rttVarSample = Time (
         std::abs ((tcbd->m_smoothedRtt - latestRtt).GetDouble ()));
-      tcbd->m_rttVar = 3 / 4 * tcbd->m_rttVar + 1 / 4 * rttVarSample;
-      tcbd->m_smoothedRtt = 7 / 8 * tcbd->m_smoothedRtt + 1 / 8 * latestRtt;
+      tcbd->m_rttVar = tcbd->m_rttVar * 3 / 4 + rttVarSample / 4;
+      tcbd->m_smoothedRtt = tcbd->m_smoothedRtt * 7 / 8 + latestRtt / 8;
     }
 
 }
 
 void
 MpQuicCongestionOps::OnPacketAcked (Ptr<TcpSocketState> tcb,
-                                  Ptr<QuicSocketTxItem> ackedPacket, double alpha, double sum_rate)
+                                  Ptr<QuicSocketTxItem> ackedPacket, uint8_t pathId,
+                                  const MpQuicCoupledState &coupled)
 {
   NS_LOG_FUNCTION (this);
   Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
   NS_ASSERT_MSG (tcbd != 0, "tcb is not a QuicSocketState");
   
-  OnPacketAckedCC (tcbd, ackedPacket, alpha, sum_rate);
+  OnPacketAckedCC (tcbd, ackedPacket, pathId, coupled);
 
   NS_LOG_LOGIC ("Handle possible RTO");
   // If a packet sent prior to RTO was acked, then the RTO  was spurious. Otherwise, inform congestion control.
@@ -211,7 +214,8 @@ MpQuicCongestionOps::InRecovery (Ptr<TcpSocketState> tcb,
 
 void
 MpQuicCongestionOps::OnPacketAckedCC (Ptr<TcpSocketState> tcb,
-                                    Ptr<QuicSocketTxItem> ackedPacket, double alpha, double sum_rate)
+                                    Ptr<QuicSocketTxItem> ackedPacket, uint8_t pathId,
+                                    const MpQuicCoupledState &coupled)
 {
   NS_LOG_FUNCTION (this);
   Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
@@ -227,25 +231,83 @@ MpQuicCongestionOps::OnPacketAckedCC (Ptr<TcpSocketState> tcb,
   if (tcbd->m_cWnd < tcbd->m_ssThresh)
     {
       NS_LOG_LOGIC ("In slow start");
-      // Slow start.
-      tcbd->m_cWnd += ackedPacket->m_packet->GetSize ();
-      // tcbd->m_cWnd += tcbd->m_segmentSize;
+      SlowStart (tcbd, ackedPacket, pathId, coupled);
     }
   else
     {
       NS_LOG_LOGIC ("In congestion avoidance");
-      // Congestion Avoidance.
       m_inCCAvoid = true;
       if (tcbd->m_cWnd > (uint32_t) 0) {
-        double increase = (tcbd->m_cWnd/tcbd->m_segmentSize/pow(tcbd->m_lastRtt.Get().GetSeconds(),2))/pow(sum_rate,2)
-                        + alpha/(tcbd->m_cWnd/tcbd->m_segmentSize);
-        tcbd->m_cWnd += fabs(increase)*tcbd->m_segmentSize;
+        CongestionAvoidance (tcbd, ackedPacket, pathId, coupled);
       } else {
           tcbd->m_cWnd = tcbd->m_kMinimumWindow;
       }
     }
 }
 
+void
+MpQuicCongestionOps::SlowStart (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this);
+  NS_UNUSED (pathId);
+  NS_UNUSED (coupled);
+  tcbd->m_cWnd += ackedPacket->m_packet->GetSize ();
+}
+
+void
+MpQuicCongestionOps::CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                          uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this);
+  NS_UNUSED (ackedPacket);
+  double mss = tcbd->m_segmentSize;
+  double w = tcbd->m_cWnd / mss;
+  double rtt = tcbd->m_smoothedRtt.GetSeconds ();
+  if (rtt == 0 || coupled.GetSumRate () == 0)
+    {
+      AddToCwnd (tcbd, mss / w);
+      return;
+    }
+
+  // OLIA: alpha moves window from the paths with the largest window to the
+  // best paths (by bytes between losses) that do not have the largest window
+  double alpha = 0;
+  int16_t best = coupled.GetBestLossIntervalPath ();
+  int16_t maxCwnd = coupled.GetMaxCwndPath ();
+  if (best >= 0 && best != maxCwnd)
+    {
+      if (pathId == best)
+        {
+          alpha = 1.0 / coupled.GetNumPaths ();
+        }
+      else if (pathId == maxCwnd)
+        {
+          alpha = -1.0 / coupled.GetNumPaths ();
+        }
+    }
+
+  double sumRate = coupled.GetSumRate () / mss;
+  double increase = (w / (rtt * rtt)) / (sumRate * sumRate) + alpha / w;
+  AddToCwnd (tcbd, increase * mss);
+}
+
+double
+MpQuicCongestionOps::GetLossReduction (Ptr<QuicSocketState> tcbd, uint8_t pathId,
+                                       const MpQuicCoupledState &coupled)
+{
+  NS_UNUSED (pathId);
+  NS_UNUSED (coupled);
+  return tcbd->m_kLossReductionFactor;
+}
+
+void
+MpQuicCongestionOps::AddToCwnd (Ptr<QuicSocketState> tcbd, double bytes)
+{
+  double cWnd = std::round (tcbd->m_cWnd + bytes);
+  tcbd->m_cWnd = std::max (cWnd, (double) tcbd->m_kMinimumWindow);
+}
+
 void
 MpQuicCongestionOps::OnPacketsLost (
   Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets)
@@ -254,6 +316,25 @@ MpQuicCongestionOps::OnPacketsLost (
   Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
   NS_ASSERT_MSG (tcbd != 0, "tcb is not a QuicSocketState");
 
+  EnterRecovery (tcbd, lostPackets, tcbd->m_kLossReductionFactor);
+}
+
+void
+MpQuicCongestionOps::OnPacketsLost (
+  Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets,
+  uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_LOGIC (this);
+  Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
+  NS_ASSERT_MSG (tcbd != 0, "tcb is not a QuicSocketState");
+
+  EnterRecovery (tcbd, lostPackets, GetLossReduction (tcbd, pathId, coupled));
+}
+
+void
+MpQuicCongestionOps::EnterRecovery (Ptr<QuicSocketState> tcbd,
+                                    std::vector<Ptr<QuicSocketTxItem> > &lostPackets, double reduction)
+{
   auto largestLostPacket = *(lostPackets.end () - 1);
   //for OLIA
   tcbd->m_bytesBeforeLost1 = tcbd->m_bytesBeforeLost2;
@@ -264,7 +345,7 @@ MpQuicCongestionOps::OnPacketsLost (
   if (!InRecovery (tcbd, largestLostPacket->m_packetNumber))
     {
       tcbd->m_endOfRecovery = tcbd->m_highTxMark;
-      tcbd->m_cWnd *= tcbd->m_kLossReductionFactor;
+      tcbd->m_cWnd *= reduction;
       if (tcbd->m_cWnd < tcbd->m_kMinimumWindow)
         {
           tcbd->m_cWnd = tcbd->m_kMinimumWindow;
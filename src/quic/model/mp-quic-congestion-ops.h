@@ -34,6 +34,7 @@
 #include "quic-socket-base.h"
 #include "quic-socket-tx-buffer.h"
 #include "quic-congestion-ops.h"
+#include "mp-quic-coupled-state.h"
 
 namespace ns3 {
 
@@ -47,16 +48,17 @@ namespace ns3 {
 /**
  * \ingroup congestionOps
  *
- * \brief Congestion control abstract class
+ * \brief Coupled multipath congestion control, implementing OLIA
  *
  * The congestion control is splitted from the main socket code, and it is a
  * pluggable component. An interface has been defined; variables are maintained
  * in the QuicSocketState class, while subclasses of MpQuicCongestionOps operate
  * over an instance of that class.
  *
- * The design extends TcpNewReno to provide compatibility with the TCP congestion
- * control implementations, as well as the possibility of extending it with new
- * QUIC-related capabilities.
+ * The window of a path is coupled with the other paths of the connection
+ * through the MpQuicCoupledState kept by the socket. Subclasses implement
+ * other coupled algorithms by overriding SlowStart, CongestionAvoidance
+ * and GetLossReduction.
  *
  */
 class MpQuicCongestionOps : public QuicCongestionOps
@@ -105,9 +107,11 @@ public:
    * \param ack the received ACK
    * \param newAcks the newly acked packets
    * \param rs the connection RateSample
+   * \param pathId the path of the ACK
+   * \param coupled the state of all the paths of the connection
    */
   virtual void OnAckReceived (Ptr<TcpSocketState> tcb, QuicSubheader &ack, std::vector<Ptr<QuicSocketTxItem> > newAcks,
-                              const struct RateSample *rs, double alpha, double sum_rate);
+                              const struct RateSample *rs, uint8_t pathId, const MpQuicCoupledState &coupled);
 
   /**
    * \brief Method called when a packet is lost. It process the lost packets and updates
@@ -118,6 +122,18 @@ public:
    */
   virtual void OnPacketsLost (Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets);
 
+  /**
+   * \brief Method called when packets of a path are lost. The window is reduced
+   *   by the factor returned by GetLossReduction.
+   *
+   * \param tcb a smart pointer to the SocketState (it accepts a QuicSocketState)
+   * \param lostPackets the lost packets
+   * \param pathId the path of the lost packets
+   * \param coupled the state of all the paths of the connection
+   */
+  virtual void OnPacketsLost (Ptr<TcpSocketState> tcb, std::vector<Ptr<QuicSocketTxItem> > lostPackets,
+                              uint8_t pathId, const MpQuicCoupledState &coupled);
+
   void OnRetransmissionTimeout (Ptr<TcpSocketState> tcb);
 
 
@@ -139,8 +155,11 @@ protected:
    *
    * \param tcb a smart pointer to the SocketState (it accepts a QuicSocketState)
    * \param ackedPacked the acked packet
+   * \param pathId the path of the acked packet
+   * \param coupled the state of all the paths of the connection
    */
-  virtual void OnPacketAcked (Ptr<TcpSocketState> tcb, Ptr<QuicSocketTxItem> ackedPacket, double alpha, double sum_rate);
+  virtual void OnPacketAcked (Ptr<TcpSocketState> tcb, Ptr<QuicSocketTxItem> ackedPacket,
+                              uint8_t pathId, const MpQuicCoupledState &coupled);
 
   /**
    * \brief Check if in recovery period
@@ -156,8 +175,60 @@ protected:
    *
    * \param tcb a smart pointer to the SocketState (it accepts a QuicSocketState)
    * \param ackedPacked the acked packet
+   * \param pathId the path of the acked packet
+   * \param coupled the state of all the paths of the connection
+   */
+  void OnPacketAckedCC (Ptr<TcpSocketState> tcb, Ptr<QuicSocketTxItem> ackedPacket,
+                        uint8_t pathId, const MpQuicCoupledState &coupled);
+
+  /**
+   * \brief Increase the window of a path in slow start
+   *
+   * \param tcbd the state of the path
+   * \param ackedPacket the acked packet
+   * \param pathId the path
+   * \param coupled the state of all the paths of the connection
+   */
+  virtual void SlowStart (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                          uint8_t pathId, const MpQuicCoupledState &coupled);
+
+  /**
+   * \brief Increase the window of a path in congestion avoidance (OLIA)
+   *
+   * \param tcbd the state of the path
+   * \param ackedPacket the acked packet
+   * \param pathId the path
+   * \param coupled the state of all the paths of the connection
+   */
+  virtual void CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                    uint8_t pathId, const MpQuicCoupledState &coupled);
+
+  /**
+   * \brief Get the factor applied to the window of a path on a loss
+   *
+   * \param tcbd the state of the path
+   * \param pathId the path
+   * \param coupled the state of all the paths of the connection
+   * \return the factor, m_kLossReductionFactor by default
+   */
+  virtual double GetLossReduction (Ptr<QuicSocketState> tcbd, uint8_t pathId, const MpQuicCoupledState &coupled);
+
+  /**
+   * \brief Change the window of a path, keeping it above the minimum window
+   *
+   * \param tcbd the state of the path
+   * \param bytes the bytes to add to the window, can be negative
+   */
+  void AddToCwnd (Ptr<QuicSocketState> tcbd, double bytes);
+
+  /**
+   * \brief Start a new recovery epoch, unless the lost packet belongs to the current one
+   *
+   * \param tcbd the state of the path
+   * \param lostPackets the lost packets
+   * \param reduction the factor applied to the window
    */
-  void OnPacketAckedCC (Ptr<TcpSocketState> tcb, Ptr<QuicSocketTxItem> ackedPacket, double alpha, double sum_rate);
+  void EnterRecovery (Ptr<QuicSocketState> tcbd, std::vector<Ptr<QuicSocketTxItem> > &lostPackets, double reduction);
 
   /**
    * \brief Method called when retransmission timeout fires. It updates the quantities in the tcb.
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-coupled-state.h"
+
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicCoupledState");
+
+MpQuicCoupledState::MpQuicCoupledState ()
+  : m_numPaths (0),
+    m_totalCwnd (0),
+    m_sumRate (0),
+    m_maxCwndPath (-1),
+    m_bestRatePath (-1),
+    m_maxCwndOverRttSquaredPath (-1),
+    m_bestLossIntervalPath (-1)
+{
+}
+
+void
+MpQuicCoupledState::UpdatePath (uint8_t pathId, uint32_t cWnd, double rtt, uint32_t lossInterval)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId << cWnd << rtt << lossInterval);
+
+  if (pathId >= m_paths.size ())
+    {
+      PathState unmeasured = {false, 0, 0, 0, 0};
+      m_paths.resize (pathId + 1, unmeasured);
+    }
+
+  PathState &path = m_paths[pathId];
+  PathState old = path;
+  if (old.m_measured)
+    {
+      m_numPaths--;
+      m_totalCwnd -= old.m_cWnd;
+      m_sumRate -= old.m_rate;
+    }
+
+  path.m_measured = (rtt > 0);
+  if (path.m_measured)
+    {
+      path.m_cWnd = cWnd;
+      path.m_rate = cWnd / rtt;
+      path.m_cWndOverRttSquared = path.m_rate / rtt;
+      path.m_lossIntervalRate = (double) lossInterval * lossInterval / (rtt * rtt);
+      m_numPaths++;
+      m_totalCwnd += path.m_cWnd;
+      m_sumRate += path.m_rate;
+    }
+  else
+    {
+      path.m_cWnd = 0;
+      path.m_rate = 0;
+      path.m_cWndOverRttSquared = 0;
+      path.m_lossIntervalRate = 0;
+    }
+
+  if (m_numPaths == 0)
+    {
+      // do not carry rounding errors over
+      m_totalCwnd = 0;
+      m_sumRate = 0;
+    }
+
+  UpdateBest (m_maxCwndPath, &PathState::m_cWnd, pathId, old.m_cWnd);
+  UpdateBest (m_bestRatePath, &PathState::m_rate, pathId, old.m_rate);
+  UpdateBest (m_maxCwndOverRttSquaredPath, &PathState::m_cWndOverRttSquared, pathId, old.m_cWndOverRttSquared);
+  UpdateBest (m_bestLossIntervalPath, &PathState::m_lossIntervalRate, pathId, old.m_lossIntervalRate);
+}
+
+void
+MpQuicCoupledState::UpdateBest (int16_t &best, Field field, uint8_t pathId, double oldValue)
+{
+  const PathState &path = m_paths[pathId];
+  if (best == pathId && (path.*field < oldValue || !path.m_measured))
+    {
+      // the best path got worse, look for the new one
+      best = -1;
+      for (uint16_t i = 0; i < m_paths.size (); i++)
+        {
+          if (m_paths[i].m_measured && (best < 0 || m_paths[i].*field > m_paths[best].*field))
+            {
+              best = i;
+            }
+        }
+    }
+  else if (path.m_measured && (best < 0 || path.*field > m_paths[best].*field))
+    {
+      best = pathId;
+    }
+}
+
+uint8_t
+MpQuicCoupledState::GetNumPaths (void) const
+{
+  return m_numPaths;
+}
+
+double
+MpQuicCoupledState::GetTotalCwnd (void) const
+{
+  return m_totalCwnd;
+}
+
+double
+MpQuicCoupledState::GetSumRate (void) const
+{
+  return m_sumRate;
+}
+
+double
+MpQuicCoupledState::GetMaxRate (void) const
+{
+  return m_bestRatePath < 0 ? 0 : m_paths[m_bestRatePath].m_rate;
+}
+
+double
+MpQuicCoupledState::GetMaxCwndOverRttSquared (void) const
+{
+  return m_maxCwndOverRttSquaredPath < 0 ? 0 : m_paths[m_maxCwndOverRttSquaredPath].m_cWndOverRttSquared;
+}
+
+int16_t
+MpQuicCoupledState::GetMaxCwndPath (void) const
+{
+  return m_maxCwndPath;
+}
+
+int16_t
+MpQuicCoupledState::GetBestRatePath (void) const
+{
+  return m_bestRatePath;
+}
+
+int16_t
+MpQuicCoupledState::GetBestLossIntervalPath (void) const
+{
+  return m_bestLossIntervalPath;
+}
+
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICCOUPLEDSTATE_H
+#define MPQUICCOUPLEDSTATE_H
+
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Connection-wide quantities used by the coupled congestion controls
+ *
+ * The socket reports the window, RTT and loss interval of a path each time
+ * they may have changed, and the totals and the best paths are updated from
+ * the difference with the previous report. The best paths are only searched
+ * again when the current best one gets worse, so an ACK usually costs O(1)
+ * whatever the number of paths.
+ *
+ * Paths without an RTT sample are not counted.
+ */
+class MpQuicCoupledState
+{
+public:
+  MpQuicCoupledState ();
+
+  /**
+   * \brief Report the state of a path
+   *
+   * \param pathId the path
+   * \param cWnd the congestion window of the path, in bytes
+   * \param rtt the smoothed RTT of the path, in seconds, or 0 if not measured yet
+   * \param lossInterval the bytes acknowledged between the last two losses of the path
+   */
+  void UpdatePath (uint8_t pathId, uint32_t cWnd, double rtt, uint32_t lossInterval);
+
+  /**
+   * \return the number of paths with an RTT sample
+   */
+  uint8_t GetNumPaths (void) const;
+
+  /**
+   * \return the sum of the congestion windows, in bytes
+   */
+  double GetTotalCwnd (void) const;
+
+  /**
+   * \return the sum of the rates cWnd/rtt of the paths, in bytes/s
+   */
+  double GetSumRate (void) const;
+
+  /**
+   * \return the largest rate cWnd/rtt of a path, in bytes/s
+   */
+  double GetMaxRate (void) const;
+
+  /**
+   * \return the largest cWnd/rtt^2 of a path, as used by LIA
+   */
+  double GetMaxCwndOverRttSquared (void) const;
+
+  /**
+   * \return the path with the largest congestion window, or -1 if none
+   */
+  int16_t GetMaxCwndPath (void) const;
+
+  /**
+   * \return the path with the largest rate cWnd/rtt, or -1 if none
+   */
+  int16_t GetBestRatePath (void) const;
+
+  /**
+   * \return the path with the largest lossInterval^2/rtt^2 (the best path of OLIA), or -1 if none
+   */
+  int16_t GetBestLossIntervalPath (void) const;
+
+private:
+  /**
+   * \brief Last report of a path
+   */
+  struct PathState
+  {
+    bool m_measured;              //!< True if the path has an RTT sample
+    double m_cWnd;                //!< Congestion window, in bytes
+    double m_rate;                //!< cWnd/rtt
+    double m_cWndOverRttSquared;  //!< cWnd/rtt^2
+    double m_lossIntervalRate;    //!< lossInterval^2/rtt^2
+  };
+
+  typedef double PathState::*Field;   //!< A quantity of a path
+
+  /**
+   * \brief Update the path with the largest value of a field after a path changed
+   *
+   * \param best the best path, updated
+   * \param field the quantity compared
+   * \param pathId the path that changed
+   * \param oldValue the previous value of the field for pathId
+   */
+  void UpdateBest (int16_t &best, Field field, uint8_t pathId, double oldValue);
+
+  std::vector<PathState> m_paths;     //!< Last report of each path
+  uint8_t m_numPaths;                 //!< Number of measured paths
+  double m_totalCwnd;                 //!< Sum of the windows of the measured paths
+  double m_sumRate;                   //!< Sum of the rates of the measured paths
+  int16_t m_maxCwndPath;              //!< Path with the largest window
+  int16_t m_bestRatePath;             //!< Path with the largest rate
+  int16_t m_maxCwndOverRttSquaredPath;  //!< Path with the largest cWnd/rtt^2
+  int16_t m_bestLossIntervalPath;     //!< Path with the largest lossInterval^2/rtt^2
+};
+
+} // namespace ns3
+
+#endif /* MPQUICCOUPLEDSTATE_H */
@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-lia.h"
+
+#include <cmath>
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicLia");
+
+NS_OBJECT_ENSURE_REGISTERED (MpQuicLia);
+
+TypeId
+MpQuicLia::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MpQuicLia")
+    .SetParent<MpQuicCongestionOps> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<MpQuicLia> ()
+  ;
+  return tid;
+}
+
+MpQuicLia::MpQuicLia (void)
+  : MpQuicCongestionOps ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicLia::MpQuicLia (const MpQuicLia& sock)
+  : MpQuicCongestionOps (sock)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicLia::~MpQuicLia (void)
+{}
+
+std::string
+MpQuicLia::GetName () const
+{
+  return "MpQuicCongestionControl_LIA";
+}
+
+Ptr<TcpCongestionOps>
+MpQuicLia::Fork ()
+{
+  return CopyObject<MpQuicLia> (this);
+}
+
+void
+MpQuicLia::CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  double mss = tcbd->m_segmentSize;
+  double bytesAcked = ackedPacket->m_packet->GetSize ();
+  // the increase of an uncoupled NewReno flow is the upper bound
+  double increase = bytesAcked * mss / tcbd->m_cWnd.Get ();
+
+  if (coupled.GetSumRate () > 0)
+    {
+      double totalCwnd = coupled.GetTotalCwnd ();
+      double alpha = totalCwnd * coupled.GetMaxCwndOverRttSquared () / std::pow (coupled.GetSumRate (), 2);
+      increase = std::min (alpha * bytesAcked * mss / totalCwnd, increase);
+      NS_LOG_LOGIC ("LIA alpha " << alpha << " increase " << increase);
+    }
+  AddToCwnd (tcbd, increase);
+}
+
+} // namespace ns3
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-linucb.h"
+
+#include <cmath>
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicLinUcbArm");
+
+const int MpQuicLinUcbArm::DIM;
+
+MpQuicLinUcbArm::MpQuicLinUcbArm (double alpha)
+  : m_alpha (alpha),
+    m_a (Matrix::Identity ()),
+    m_aInv (Matrix::Identity ()),
+    m_b (Vector::Zero ()),
+    m_theta (Vector::Zero ()),
+    m_cached (false),
+    m_lastContext (Vector::Zero ()),
+    m_lastScore (0),
+    m_lastWidth (0)
+{
+}
+
+double
+MpQuicLinUcbArm::GetScore (const Vector &x)
+{
+  if (m_cached && x == m_lastContext)
+    {
+      return m_lastScore;
+    }
+
+  m_lastWidth = m_alpha * std::sqrt (x.dot (m_aInv * x));
+  m_lastScore = x.dot (m_theta) + m_lastWidth;
+  m_lastContext = x;
+  m_cached = true;
+  return m_lastScore;
+}
+
+double
+MpQuicLinUcbArm::GetWidth (void) const
+{
+  return m_lastWidth;
+}
+
+void
+MpQuicLinUcbArm::Update (const Vector &x, double reward)
+{
+  NS_LOG_FUNCTION (this << reward);
+
+  // Sherman-Morrison: (A + x x')^-1 = A^-1 - (A^-1 x)(A^-1 x)' / (1 + x' A^-1 x),
+  // as A, and so A^-1, is symmetric
+  Vector u = m_aInv * x;
+  m_aInv -= (u * u.transpose ()) / (1 + x.dot (u));
+
+  m_a += x * x.transpose ();
+  m_b += reward * x;
+  m_theta = m_aInv * m_b;
+  m_cached = false;
+}
+
+const MpQuicLinUcbArm::Matrix &
+MpQuicLinUcbArm::GetA (void) const
+{
+  return m_a;
+}
+
+const MpQuicLinUcbArm::Matrix &
+MpQuicLinUcbArm::GetAInverse (void) const
+{
+  return m_aInv;
+}
+
+const MpQuicLinUcbArm::Vector &
+MpQuicLinUcbArm::GetB (void) const
+{
+  return m_b;
+}
+
+} // namespace ns3
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICLINUCB_H
+#define MPQUICLINUCB_H
+
+#include <eigen3/Eigen/Dense>
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief One arm (path) of the LinUCB bandit used by the Peekaboo scheduler
+ *
+ * The arm scores a context x as x' theta + alpha * sqrt (x' A^-1 x), where A
+ * is the sum of the outer products of the contexts it was updated with (plus
+ * the identity), b the sum of the contexts weighted by their reward, and
+ * theta = A^-1 b the estimate of the weights of the reward.
+ * A^-1 is kept up to date with rank-1 Sherman-Morrison updates instead of
+ * inverting A for every score, and all the matrices have a fixed size so that
+ * scoring and updating do not allocate. The last score is cached until the
+ * context or the arm changes.
+ */
+class MpQuicLinUcbArm
+{
+public:
+  static const int DIM = 6;                              //!< Size of the context
+  typedef Eigen::Matrix<double, DIM, DIM> Matrix;        //!< DIM x DIM matrix
+  typedef Eigen::Matrix<double, DIM, 1> Vector;          //!< Context vector
+
+  /**
+   * \brief Constructor
+   *
+   * \param alpha the weight of the confidence width in the score
+   */
+  MpQuicLinUcbArm (double alpha = 0.8);
+
+  /**
+   * \brief Compute the upper confidence bound of the reward of the arm
+   *
+   * \param x the context
+   * \return the score of the arm for the context
+   */
+  double GetScore (const Vector &x);
+
+  /**
+   * \brief Get the confidence width of the last score computed
+   *
+   * \return alpha * sqrt (x' A^-1 x) for the last context scored
+   */
+  double GetWidth (void) const;
+
+  /**
+   * \brief Account for the arm being played in a context
+   *
+   * \param x the context
+   * \param reward the reward observed
+   */
+  void Update (const Vector &x, double reward);
+
+  /**
+   * \return the matrix A
+   */
+  const Matrix &GetA (void) const;
+
+  /**
+   * \return the inverse of A, as maintained by the rank-1 updates
+   */
+  const Matrix &GetAInverse (void) const;
+
+  /**
+   * \return the vector b
+   */
+  const Vector &GetB (void) const;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+  double m_alpha;         //!< Weight of the confidence width
+  Matrix m_a;             //!< A
+  Matrix m_aInv;          //!< A^-1
+  Vector m_b;             //!< b
+  Vector m_theta;         //!< A^-1 b, the estimated weights of the reward
+
+  bool m_cached;          //!< True if m_lastScore is valid for m_lastContext
+  Vector m_lastContext;   //!< Last context scored
+  double m_lastScore;     //!< Score of m_lastContext
+  double m_lastWidth;     //!< Confidence width of m_lastContext
+};
+
+} // namespace ns3
+
+#endif /* MPQUICLINUCB_H */
@@ -28,6 +28,9 @@
 #include "quic-stream.h"
 #include "ns3/node.h"
 #include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv4.h"
+#include "ns3/inet-socket-address.h"
 
 
 #include <algorithm>
@@ -53,6 +56,35 @@ MpQuicPathManager::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::MpQuicPathManager")
     .SetParent<Object> ()
     .SetGroupName ("Internet")                  
+    .AddAttribute ("EnableProbing",
+                   "Probe the idle or suspect paths, stop using the failed ones and follow the changes of the local interfaces",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MpQuicPathManager::m_enableProbing),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ProbeInterval",
+                   "Interval between two checks of the paths",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&MpQuicPathManager::m_probeInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("IdleTimeout",
+                   "Time without receiving anything on a path after which it is probed",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&MpQuicPathManager::m_idleTimeout),
+                   MakeTimeChecker ())
+    .AddAttribute ("ProbeRtts",
+                   "Smoothed RTTs without receiving anything after a PATH_CHALLENGE, or since the oldest packet in flight was sent, after which a path is failed, or suspect",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&MpQuicPathManager::m_probeRtts),
+                   MakeDoubleChecker<double> (1.0))
+    .AddAttribute ("AbandonTimeout",
+                   "Time after which a failed path is abandoned",
+                   TimeValue (Seconds (5)),
+                   MakeTimeAccessor (&MpQuicPathManager::m_abandonTimeout),
+                   MakeTimeChecker ())
+    .AddTraceSource ("PathState",
+                     "A path was validated, failed, recovered or closed",
+                     MakeTraceSourceAccessor (&MpQuicPathManager::m_pathStateTrace),
+                     "ns3::MpQuicPathManager::PathStateTracedCallback")
   ;
   return tid;
 }
@@ -60,7 +92,13 @@ MpQuicPathManager::GetTypeId (void)
 MpQuicPathManager::MpQuicPathManager ()
   : m_socket(0),
   m_segSize(0),
-  m_initialSsThresh(0)
+  m_initialSsThresh(0),
+  m_opensPaths(false),
+  m_enableProbing(false),
+  m_probeInterval(MilliSeconds (100)),
+  m_idleTimeout(Seconds (1)),
+  m_probeRtts(3.0),
+  m_abandonTimeout(Seconds (5))
 {
   NS_LOG_FUNCTION_NOARGS ();
  
@@ -111,6 +149,7 @@ MpQuicPathManager::AddSubflow(Address localAddress, Address peerAddress, uint8_t
   sFlow->m_tcb->m_initialSsThresh = m_initialSsThresh;
   sFlow->m_tcb->m_cWnd = sFlow->m_tcb->m_initialCWnd;
   sFlow->m_tcb->m_ssThresh = sFlow->m_tcb->m_initialSsThresh;
+  m_opensPaths = true;
   m_socket->SubflowInsert(sFlow);
   m_socket->AddPath(localAddress, peerAddress, pathId);
   m_socket->SendAddAddress(localAddress, pathId);
@@ -134,7 +173,7 @@ MpQuicPathManager::AddSubflowWithPeerAddress(Address localAddress, Address peerA
   sFlow->m_tcb->m_cWnd = sFlow->m_tcb->m_initialCWnd;
   sFlow->m_tcb->m_ssThresh = sFlow->m_tcb->m_initialSsThresh;
   m_socket->SubflowInsert(sFlow);
-  m_socket->SendPathChallenge(pathId);
+  Probe (pathId);
   bool ok;
   ok = sFlow->m_tcb->TraceConnectWithoutContext ("CongestionWindow", MakeCallback (&QuicSocketBase::UpdateCwnd1, m_socket));
   NS_ASSERT_MSG (ok == true, "Failed connection to CWND trace");
@@ -179,5 +218,284 @@ MpQuicPathManager::GetInitialSSThresh (void) const
   return m_initialSsThresh;
 }
 
+void
+MpQuicPathManager::StartProbing (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_enableProbing or m_checkEvent.IsRunning ())
+    {
+      return;
+    }
+  for (Ptr<MpQuicSubFlow> subflow : m_socket->GetSubflows ())
+    {
+      subflow->m_lastReceived = Simulator::Now ();
+    }
+  m_checkEvent = Simulator::Schedule (m_probeInterval, &MpQuicPathManager::CheckPaths, this);
+}
+
+void
+MpQuicPathManager::StopProbing (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_checkEvent.Cancel ();
+}
+
+void
+MpQuicPathManager::OnPacketReceived (uint8_t pathId)
+{
+  const std::vector<Ptr<MpQuicSubFlow>> &subflows = m_socket->GetSubflows ();
+  if (pathId >= subflows.size ())
+    {
+      return;
+    }
+  Ptr<MpQuicSubFlow> subflow = subflows[pathId];
+  subflow->m_lastReceived = Simulator::Now ();
+  if (subflow->m_subflowState == MpQuicSubFlow::Failed)
+    {
+      NS_LOG_INFO ("Path " << (uint16_t) pathId << " answers again");
+      ResetPath (subflow);
+      SetPathState (subflow, MpQuicSubFlow::Active);
+      m_socket->ResumeSending ();
+    }
+  else if (subflow->m_subflowState == MpQuicSubFlow::Active)
+    {
+      subflow->m_challengeSent = Time ();
+    }
+}
+
+void
+MpQuicPathManager::OnPathValidated (uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  Ptr<MpQuicSubFlow> subflow = m_socket->GetSubflows ()[pathId];
+  if (subflow->m_subflowState == MpQuicSubFlow::Validating)
+    {
+      subflow->m_challengeSent = Time ();
+      subflow->m_lastReceived = Simulator::Now ();
+      SetPathState (subflow, MpQuicSubFlow::Active);
+    }
+}
+
+void
+MpQuicPathManager::Probe (uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  m_socket->GetSubflows ()[pathId]->m_challengeSent = Simulator::Now ();
+  m_socket->SendPathChallenge (pathId);
+}
+
+void
+MpQuicPathManager::ClosePath (uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  const std::vector<Ptr<MpQuicSubFlow>> &subflows = m_socket->GetSubflows ();
+  if (pathId >= subflows.size () or subflows[pathId]->m_subflowState == MpQuicSubFlow::Closed)
+    {
+      return;
+    }
+  Ptr<MpQuicSubFlow> subflow = subflows[pathId];
+  SetPathState (subflow, MpQuicSubFlow::Closed);
+  subflow->m_tcb->m_lossDetectionAlarm.Cancel ();
+  uint32_t requeued = m_socket->GetTxBuffer ()->ClearSentList (pathId);
+  NS_LOG_INFO ("Path " << (uint16_t) pathId << " closed, " << requeued << " bytes put back");
+  m_socket->ResumeSending ();
+}
+
+void
+MpQuicPathManager::ReopenPath (uint8_t pathId, Address peerAddress)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  Ptr<MpQuicSubFlow> subflow = m_socket->GetSubflows ()[pathId];
+  if (subflow->m_subflowState != MpQuicSubFlow::Closed)
+    {
+      // The peer lost the path, without us noticing
+      ClosePath (pathId);
+    }
+  subflow->m_peerAddr = peerAddress;
+  ResetPath (subflow);
+  SetPathState (subflow, MpQuicSubFlow::Validating);
+  Probe (pathId);
+}
+
+int16_t
+MpQuicPathManager::GetLivePath (int16_t exclude) const
+{
+  for (Ptr<MpQuicSubFlow> subflow : m_socket->GetActiveSubflows ())
+    {
+      if (subflow->m_flowId != exclude)
+        {
+          return subflow->m_flowId;
+        }
+    }
+  return -1;
+}
+
+void
+MpQuicPathManager::CheckPaths (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_socket->GetSocketState () != QuicSocket::OPEN)
+    {
+      return;
+    }
+
+  if (m_opensPaths)
+    {
+      m_socket->CreateNewSubflows (true);
+    }
+
+  Ptr<Ipv4> ipv4 = m_socket->GetNode ()->GetObject<Ipv4> ();
+  Time now = Simulator::Now ();
+  const std::vector<Ptr<MpQuicSubFlow>> &subflows = m_socket->GetSubflows ();
+  m_removed.resize (subflows.size (), false);
+  for (uint8_t pathId = 0; pathId < subflows.size (); pathId++)
+    {
+      Ptr<MpQuicSubFlow> subflow = subflows[pathId];
+      int32_t interface = GetInterface (subflow);
+      bool up = interface < 0 or ipv4->IsUp (interface);
+      MpQuicSubFlow::SubflowStates_t state = subflow->m_subflowState;
+
+      if ((state == MpQuicSubFlow::Active or state == MpQuicSubFlow::Failed) and !up)
+        {
+          // Tell the peer on another path, and stop using this one right away
+          NS_LOG_INFO ("Interface of path " << (uint16_t) pathId << " is down");
+          int16_t livePathId = GetLivePath (pathId);
+          if (livePathId >= 0)
+            {
+              m_socket->SendRemoveAddress (subflow->m_localAddr, pathId, livePathId);
+            }
+          ClosePath (pathId);
+          m_removed[pathId] = true;
+        }
+      else if (state == MpQuicSubFlow::Active)
+        {
+          if (subflow->m_challengeSent.IsZero ())
+            {
+              if (IsSuspect (subflow))
+                {
+                  Probe (pathId);
+                }
+            }
+          else if (now - subflow->m_challengeSent > GetProbeTimeout (subflow))
+            {
+              FailPath (subflow);
+            }
+        }
+      else if (state == MpQuicSubFlow::Failed)
+        {
+          if (now - subflow->m_failedSince > m_abandonTimeout)
+            {
+              NS_LOG_INFO ("Abandon path " << (uint16_t) pathId);
+              int16_t livePathId = GetLivePath (pathId);
+              if (livePathId >= 0)
+                {
+                  m_socket->SendPathAbandon (pathId, livePathId);
+                }
+              ClosePath (pathId);
+            }
+          else if (now - subflow->m_challengeSent > GetProbeTimeout (subflow))
+            {
+              Probe (pathId);
+            }
+        }
+      else if (state == MpQuicSubFlow::Validating)
+        {
+          // Only the side that sent the first PATH_CHALLENGE sends it again
+          if (up and !subflow->m_challengeSent.IsZero ()
+              and now - subflow->m_challengeSent > GetProbeTimeout (subflow))
+            {
+              Probe (pathId);
+            }
+        }
+      else if (state == MpQuicSubFlow::Closed and up and m_removed[pathId])
+        {
+          int16_t livePathId = GetLivePath (pathId);
+          if (livePathId >= 0)
+            {
+              NS_LOG_INFO ("Interface of path " << (uint16_t) pathId << " is up again");
+              m_removed[pathId] = false;
+              ResetPath (subflow);
+              SetPathState (subflow, MpQuicSubFlow::Validating);
+              m_socket->SendAddAddress (subflow->m_localAddr, pathId, livePathId);
+            }
+        }
+    }
+
+  m_checkEvent = Simulator::Schedule (m_probeInterval, &MpQuicPathManager::CheckPaths, this);
+}
+
+bool
+MpQuicPathManager::IsSuspect (Ptr<MpQuicSubFlow> subflow) const
+{
+  Ptr<QuicSocketState> tcb = subflow->m_tcb;
+  if (tcb->m_rtoCount > 0 or tcb->m_tlpCount > 0)
+    {
+      return true;
+    }
+  Time now = Simulator::Now ();
+  if (now - subflow->m_lastReceived > m_idleTimeout)
+    {
+      return true;
+    }
+  Time oldest = m_socket->GetTxBuffer ()->GetOldestUnackedSent (subflow->m_flowId);
+  return oldest != Time::Max () and now - oldest > GetProbeTimeout (subflow);
+}
+
+Time
+MpQuicPathManager::GetProbeTimeout (Ptr<MpQuicSubFlow> subflow) const
+{
+  Time srtt = subflow->m_tcb->m_smoothedRtt;
+  if (srtt.IsZero ())
+    {
+      return m_idleTimeout;
+    }
+  return std::max (m_probeInterval, Seconds (m_probeRtts * srtt.GetSeconds ()));
+}
+
+int32_t
+MpQuicPathManager::GetInterface (Ptr<MpQuicSubFlow> subflow) const
+{
+  if (!InetSocketAddress::IsMatchingType (subflow->m_localAddr))
+    {
+      return -1;
+    }
+  Ipv4Address local = InetSocketAddress::ConvertFrom (subflow->m_localAddr).GetIpv4 ();
+  return m_socket->GetNode ()->GetObject<Ipv4> ()->GetInterfaceForAddress (local);
+}
+
+void
+MpQuicPathManager::FailPath (Ptr<MpQuicSubFlow> subflow)
+{
+  NS_LOG_FUNCTION (this << subflow->m_flowId);
+  SetPathState (subflow, MpQuicSubFlow::Failed);
+  subflow->m_failedSince = Simulator::Now ();
+  subflow->m_tcb->m_lossDetectionAlarm.Cancel ();
+  uint32_t requeued = m_socket->GetTxBuffer ()->ClearSentList (subflow->m_flowId);
+  NS_LOG_INFO ("Path " << subflow->m_flowId << " failed, " << requeued << " bytes put back");
+  m_socket->ResumeSending ();
+}
+
+void
+MpQuicPathManager::ResetPath (Ptr<MpQuicSubFlow> subflow)
+{
+  NS_LOG_FUNCTION (this << subflow->m_flowId);
+  Ptr<QuicSocketState> tcb = subflow->m_tcb;
+  tcb->m_cWnd = tcb->m_initialCWnd;
+  tcb->m_ssThresh = tcb->m_initialSsThresh;
+  tcb->m_rtoCount = 0;
+  tcb->m_tlpCount = 0;
+  tcb->m_congState = TcpSocketState::CA_OPEN;
+  tcb->m_lossDetectionAlarm.Cancel ();
+  subflow->m_challengeSent = Time ();
+}
+
+void
+MpQuicPathManager::SetPathState (Ptr<MpQuicSubFlow> subflow, MpQuicSubFlow::SubflowStates_t state)
+{
+  NS_LOG_FUNCTION (this << subflow->m_flowId << state);
+  subflow->m_subflowState = state;
+  m_pathStateTrace (subflow->m_flowId, state);
+}
+
 
 }
\ No newline at end of file
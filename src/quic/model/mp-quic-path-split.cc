@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-path-split.h"
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+const uint8_t MpQuicPathSplit::MAX_PATHS;
+
+MpQuicPathSplit::MpQuicPathSplit ()
+  : m_size (0)
+{
+}
+
+void
+MpQuicPathSplit::Clear (void)
+{
+  m_size = 0;
+}
+
+void
+MpQuicPathSplit::Add (uint8_t pathId, uint32_t budget)
+{
+  NS_ASSERT_MSG (m_size < MAX_PATHS, "Path split table full");
+  m_entries[m_size].m_pathId = pathId;
+  m_entries[m_size].m_budget = budget;
+  m_entries[m_size].m_duplicate = false;
+  m_size++;
+}
+
+void
+MpQuicPathSplit::AddDuplicate (uint8_t pathId)
+{
+  NS_ASSERT_MSG (m_size > 0, "A duplicate needs a first path");
+  NS_ASSERT_MSG (m_size < MAX_PATHS, "Path split table full");
+  m_entries[m_size].m_pathId = pathId;
+  m_entries[m_size].m_budget = 0;
+  m_entries[m_size].m_duplicate = true;
+  m_size++;
+}
+
+uint8_t
+MpQuicPathSplit::GetSize (void) const
+{
+  return m_size;
+}
+
+const MpQuicPathSplit::Entry &
+MpQuicPathSplit::Get (uint8_t index) const
+{
+  NS_ASSERT (index < m_size);
+  return m_entries[index];
+}
+
+} // namespace ns3
@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-reinjection.h"
+
+#include "ns3/log.h"
+#include "ns3/integer.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "mp-quic-subflow.h"
+#include "quic-socket-tx-buffer.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicReinjection");
+
+NS_OBJECT_ENSURE_REGISTERED (MpQuicReinjection);
+
+TypeId
+MpQuicReinjection::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MpQuicReinjection")
+    .SetParent<Object> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<MpQuicReinjection> ()
+    .AddAttribute ("Policy",
+                   "Path of the lost frames (0 - same path, 1 - path with the lowest RTT, 2 - also reinject the frames of stalled paths)",
+                   IntegerValue (SAME_PATH),
+                   MakeIntegerAccessor (&MpQuicReinjection::m_policy),
+                   MakeIntegerChecker<int16_t> (SAME_PATH, PROACTIVE))
+    .AddAttribute ("RttRatio",
+                   "Ratio of the smoothed RTT of the path the frames were lost on to the lowest one above which they are also sent on the fastest path",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&MpQuicReinjection::m_rttRatio),
+                   MakeDoubleChecker<double> (1.0))
+    .AddAttribute ("StallThreshold",
+                   "Age of the oldest packet in flight on a path, in smoothed RTTs, above which its frames are reinjected",
+                   DoubleValue (2.0),
+                   MakeDoubleAccessor (&MpQuicReinjection::m_stallThreshold),
+                   MakeDoubleChecker<double> (0))
+    .AddTraceSource ("Reinjection",
+                     "Frames in flight on a path were put back in the application buffer",
+                     MakeTraceSourceAccessor (&MpQuicReinjection::m_reinjectionTrace),
+                     "ns3::MpQuicReinjection::ReinjectionTracedCallback")
+  ;
+  return tid;
+}
+
+MpQuicReinjection::MpQuicReinjection ()
+  : Object (),
+    m_socket (0),
+    m_policy (SAME_PATH),
+    m_rttRatio (1.0),
+    m_stallThreshold (2.0),
+    m_requeuedBytes (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+MpQuicReinjection::~MpQuicReinjection ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void
+MpQuicReinjection::SetSocket (Ptr<QuicSocketBase> sock)
+{
+  NS_LOG_FUNCTION (this);
+  m_socket = sock;
+}
+
+MpQuicReinjection::ReinjectionPolicy_t
+MpQuicReinjection::GetPolicy (void) const
+{
+  return m_policy;
+}
+
+uint8_t
+MpQuicReinjection::GetReinjectionPath (uint8_t lostPathId) const
+{
+  if (m_policy == SAME_PATH)
+    {
+      return lostPathId;
+    }
+  int16_t fastPathId = FindFastestPath (lostPathId);
+  double fastRtt = 0;
+  double lostRtt = 0;
+  for (Ptr<MpQuicSubFlow> subflow : m_socket->GetActiveSubflows ())
+    {
+      if (subflow->m_flowId == fastPathId)
+        {
+          fastRtt = subflow->m_tcb->m_smoothedRtt.GetSeconds ();
+        }
+      else if (subflow->m_flowId == lostPathId)
+        {
+          lostRtt = subflow->m_tcb->m_smoothedRtt.GetSeconds ();
+        }
+    }
+  return fastPathId >= 0 and lostRtt > m_rttRatio * fastRtt ? fastPathId : lostPathId;
+}
+
+void
+MpQuicReinjection::MaybeReinject (void)
+{
+  if (m_policy != PROACTIVE)
+    {
+      return;
+    }
+
+  int16_t fastPathId = FindFastestPath (-1);
+  uint32_t spare = fastPathId < 0 ? 0 : m_socket->AvailableWindow (fastPathId);
+  if (spare < m_socket->GetSegSize ())
+    {
+      return;
+    }
+
+  Time now = Simulator::Now ();
+  for (Ptr<MpQuicSubFlow> subflow : m_socket->GetActiveSubflows ())
+    {
+      uint8_t pathId = subflow->m_flowId;
+      Time srtt = subflow->m_tcb->m_smoothedRtt;
+      if (pathId == fastPathId or srtt.IsZero ())
+        {
+          continue;
+        }
+      Time oldest = m_socket->GetTxBuffer ()->GetOldestUnackedSent (pathId);
+      if (oldest == Time::Max () or (now - oldest).GetSeconds () <= m_stallThreshold * srtt.GetSeconds ())
+        {
+          continue;
+        }
+      NS_LOG_INFO ("Path " << (uint16_t) pathId << " stalled since " << oldest.GetSeconds ()
+                   << ", path " << fastPathId << " has " << spare << " bytes to spare");
+      spare -= Requeue (pathId, spare);
+      if (spare < m_socket->GetSegSize ())
+        {
+          break;
+        }
+    }
+}
+
+void
+MpQuicReinjection::OnRetransmissionTimeout (uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  if (m_policy == SAME_PATH)
+    {
+      return;
+    }
+
+  int16_t fastPathId = FindFastestPath (pathId);
+  if (fastPathId >= 0)
+    {
+      Requeue (pathId, m_socket->AvailableWindow (fastPathId));
+    }
+}
+
+uint64_t
+MpQuicReinjection::GetRequeuedBytes (void) const
+{
+  return m_requeuedBytes;
+}
+
+int16_t
+MpQuicReinjection::FindFastestPath (int16_t exclude) const
+{
+  int16_t bestPathId = -1;
+  Time bestRtt = Time::Max ();
+  for (Ptr<MpQuicSubFlow> subflow : m_socket->GetActiveSubflows ())
+    {
+      Time srtt = subflow->m_tcb->m_smoothedRtt;
+      if (subflow->m_flowId != exclude and !srtt.IsZero () and srtt < bestRtt)
+        {
+          bestRtt = srtt;
+          bestPathId = subflow->m_flowId;
+        }
+    }
+  return bestPathId;
+}
+
+uint32_t
+MpQuicReinjection::Requeue (uint8_t pathId, uint32_t maxBytes)
+{
+  uint32_t bytes = m_socket->GetTxBuffer ()->Reinject (pathId, maxBytes);
+  if (bytes > 0)
+    {
+      NS_LOG_INFO ("Put back " << bytes << " bytes in flight on path " << (uint16_t) pathId);
+      m_requeuedBytes += bytes;
+      m_reinjectionTrace (pathId, bytes);
+    }
+  return bytes;
+}
+
+} // namespace ns3
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICREINJECTION_H
+#define MPQUICREINJECTION_H
+
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+#include "quic-socket-base.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Policy deciding on which path the lost or stalled frames are sent again
+ *
+ * The frames lost on a path are always retransmitted on that path right away,
+ * which keeps its RTT and congestion window up to date. With the BEST_PATH
+ * policy, they are also copied on the path with the lowest smoothed RTT when
+ * the lossy path is RttRatio times slower, and the frames in flight on a path
+ * whose retransmission timer expires are put back in the application buffer
+ * ahead of new data, up to the window of the fastest other path, for the
+ * MpQuicScheduler to send them. The PROACTIVE policy also puts back the
+ * oldest frames in flight on a stalled path, i.e. one whose oldest
+ * unacknowledged packet was sent more than StallThreshold smoothed RTTs ago,
+ * whenever the fastest path has window left.
+ *
+ * The packets whose frames are reinjected stay in flight on their path, but
+ * are no longer retransmitted if they are lost.
+ */
+class MpQuicReinjection : public Object
+{
+public:
+  typedef enum
+    {
+      SAME_PATH,
+      BEST_PATH,
+      PROACTIVE
+    } ReinjectionPolicy_t;
+
+  /**
+   * \brief TracedCallback signature for the frames put back in the application buffer
+   *
+   * \param [in] pathId the path the frames were in flight on
+   * \param [in] bytes the bytes put back
+   */
+  typedef void (*ReinjectionTracedCallback)(uint8_t pathId, uint32_t bytes);
+
+  /**
+   * Get the type ID.
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicReinjection (void);
+  virtual ~MpQuicReinjection (void);
+
+  /**
+   * \param sock the socket whose frames are reinjected
+   */
+  void SetSocket (Ptr<QuicSocketBase> sock);
+
+  /**
+   * \return the policy in use
+   */
+  ReinjectionPolicy_t GetPolicy (void) const;
+
+  /**
+   * \brief Get the path to reinject the frames lost on a path on
+   *
+   * \param lostPathId the path the frames were lost on
+   * \return the fastest path if the policy reinjects them and it is
+   * RttRatio times faster, the path they were lost on otherwise
+   */
+  uint8_t GetReinjectionPath (uint8_t lostPathId) const;
+
+  /**
+   * \brief Reinject the frames of the stalled paths, if the policy is PROACTIVE
+   *
+   * Called before the socket sends pending data.
+   */
+  void MaybeReinject (void);
+
+  /**
+   * \brief Reinject the frames in flight on a path whose retransmission timer expired
+   *
+   * \param pathId the path
+   */
+  void OnRetransmissionTimeout (uint8_t pathId);
+
+  /**
+   * \return the bytes taken from stalled or timed out paths and put back in the application buffer
+   */
+  uint64_t GetRequeuedBytes (void) const;
+
+private:
+  /**
+   * \brief Find the active path with the lowest smoothed RTT
+   *
+   * \param exclude a path not to consider
+   * \return the path, or -1 if no other path has an RTT sample
+   */
+  int16_t FindFastestPath (int16_t exclude) const;
+
+  /**
+   * \brief Put back the oldest frames in flight on a path
+   *
+   * \param pathId the path
+   * \param maxBytes the maximum number of bytes to put back
+   * \return the number of bytes put back
+   */
+  uint32_t Requeue (uint8_t pathId, uint32_t maxBytes);
+
+  Ptr<QuicSocketBase> m_socket;       //!< The socket
+  ReinjectionPolicy_t m_policy;       //!< The policy
+  double m_rttRatio;                  //!< Ratio of the smoothed RTT of the lossy path to the lowest one above which the lost frames change path
+  double m_stallThreshold;            //!< Age of the oldest packet in flight, in smoothed RTTs, above which a path is stalled
+  uint64_t m_requeuedBytes;           //!< Bytes put back in the application buffer
+  TracedCallback<uint8_t, uint32_t> m_reinjectionTrace;  //!< Trace of the frames put back
+};
+
+} // namespace ns3
+
+#endif /* MPQUICREINJECTION_H */
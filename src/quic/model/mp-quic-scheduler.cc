@@ -26,6 +26,7 @@
 #include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/nstime.h"
+#include "ns3/simulator.h"
 #include "quic-stream.h"
 #include "ns3/node.h"
 #include "ns3/string.h"
@@ -83,7 +84,20 @@ MpQuicScheduler::GetTypeId (void)
                    UintegerValue (0),
                    MakeUintegerAccessor (&MpQuicScheduler::m_select),
                    MakeUintegerChecker<uint16_t> ())            
-     
+    .AddAttribute ("RedundantLatency",
+                   "Latency bound up to which the streams are copied on every path by the selective redundant scheduler (0 to disable)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MpQuicScheduler::m_redundantLatency),
+                   MakeTimeChecker ())
+    .AddAttribute ("RedundantRttVarRatio",
+                   "Ratio of RTT variance to smoothed RTT above which the selective redundant scheduler copies packets on every path (0 to disable)",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&MpQuicScheduler::m_redundantRttVarRatio),
+                   MakeDoubleChecker<double> (0))
+    .AddTraceSource ("PredictedDeadlineMiss",
+                     "No path is expected to deliver a frame of a stream before its deadline",
+                     MakeTraceSourceAccessor (&MpQuicScheduler::m_predictedMissTrace),
+                     "ns3::MpQuicScheduler::PredictedDeadlineMissTracedCallback")
   ;
   return tid;
 }
@@ -92,6 +106,7 @@ MpQuicScheduler::MpQuicScheduler ()
   : Object (),
   m_socket(0),
   m_lastUsedPathId(0),
+  m_subflows(0),
   m_select(0)
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -106,97 +121,131 @@ MpQuicScheduler::~MpQuicScheduler ()
 
 
 
-std::vector<double> 
-MpQuicScheduler::GetNextPathIdToUse()
+void
+MpQuicScheduler::GetNextPathIdToUse (uint32_t bytes, MpQuicPathSplit &split)
 {
-  m_subflows = m_socket->GetActiveSubflows();
-  std::vector<double> tosend(m_subflows.size(), 0.0);
-  if (m_subflows.empty())
+  NS_LOG_FUNCTION (this << bytes);
+  const std::vector<Ptr<MpQuicSubFlow> > &active = m_socket->GetActiveSubflows ();
+  split.Clear ();
+  if (active.empty())
   {
-    tosend.push_back(1.0);
-    return tosend;
+    split.Add (0, bytes);
+    return;
   }
+
+  // A path held back by pacing cannot send now, so the decision is taken
+  // among the other paths. When pacing holds back every path, nothing is
+  // sent until a pacing timer expires and calls SendPendingData again.
+  m_candidates.clear ();
+  for (const Ptr<MpQuicSubFlow> &subflow : active)
+    {
+      if (!m_socket->IsPacingBlocked (subflow->m_flowId))
+        {
+          m_candidates.push_back (subflow);
+        }
+    }
+  if (m_candidates.empty ())
+    {
+      NS_LOG_LOGIC ("Every active path is held back by pacing");
+      return;
+    }
+  m_subflows = &m_candidates;
+
+  uint8_t pathId;
+  bool duplicate = false;
   switch (m_schedulerType)
   {
     case ROUND_ROBIN:
-      tosend = RoundRobin();
+      pathId = RoundRobin();
       break;
 
     case MIN_RTT:
-      tosend = MinRtt();
+      pathId = MinRtt();
       break;
     
     case BLEST:
-      tosend = Blest();
+      pathId = Blest();
       break;
 
     case ECF:
-      tosend = Ecf();
+      pathId = Ecf();
       break;
 
     case PEEKABOO:
-      tosend = Peekaboo();
+      pathId = Peekaboo();
+      break;
+
+    case DEADLINE:
+      // one segment at a time, so that each head-of-line frame gets its own path
+      pathId = Deadline();
+      bytes = std::min (bytes, m_socket->GetSegSize ());
+      break;
+
+    case REDUNDANT:
+    case SELECTIVE_REDUNDANT:
+      pathId = MinRtt();
+      duplicate = m_schedulerType == REDUNDANT or IsLatencyCritical (pathId);
+      if (duplicate)
+        {
+          // one segment at a time, each copied on the other paths
+          bytes = std::min (bytes, m_socket->GetSegSize ());
+        }
       break;
 
     default:
-      tosend = RoundRobin();
+      pathId = RoundRobin();
       break;
       
   }
 
-  return tosend;
+  split.Add (pathId, bytes);
+  for (uint8_t i = 0; duplicate and i < m_subflows->size () and split.GetSize () < MpQuicPathSplit::MAX_PATHS; i++)
+    {
+      uint8_t copyPathId = (*m_subflows)[i]->m_flowId;
+      if (copyPathId != pathId)
+        {
+          split.AddDuplicate (copyPathId);
+        }
+    }
 }
 
-std::vector<double>
+uint8_t
 MpQuicScheduler::RoundRobin()
 {
-  std::vector<double> tosend(m_subflows.size(), 0.0);
-  if (m_subflows.size() <= 1){
-    m_lastUsedPathId = 0;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
-  }
-
-  m_lastUsedPathId = (m_lastUsedPathId + 1) % m_subflows.size();
+  // the active paths are in path ID order: take the next one after the
+  // last path used, or wrap around to the first
+  for (const Ptr<MpQuicSubFlow> &subflow : *m_subflows)
+    {
+      if (subflow->m_flowId > m_lastUsedPathId)
+        {
+          m_lastUsedPathId = subflow->m_flowId;
+          return m_lastUsedPathId;
+        }
+    }
+  m_lastUsedPathId = (*m_subflows)[0]->m_flowId;
 
-  tosend[m_lastUsedPathId] = 1.0;
-  return tosend;
+  return m_lastUsedPathId;
 }
 
-std::vector<double>
+uint8_t
 MpQuicScheduler::MinRtt()
 {
   NS_LOG_FUNCTION (this);
-  std::vector<double> tosend(m_subflows.size(), 0.0);
 
-  if (m_subflows.size() <= 1){
-    m_lastUsedPathId = 0;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  if (m_subflows->size () <= 1){
+    m_lastUsedPathId = (*m_subflows)[0]->m_flowId;
+    return m_lastUsedPathId;
   }
 
-  if (m_subflows[1]->m_tcb->m_lastRtt.Get().GetSeconds() == 0) {
-    m_lastUsedPathId = 1;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  int16_t unmeasured = FindUnmeasuredPath ();
+  if (unmeasured >= 0) {
+    m_lastUsedPathId = unmeasured;
+    return m_lastUsedPathId;
   }
 
-  Time rttS;
-  Time rttF;
-  uint8_t fastPathId = 1;
-  uint8_t slowPathId = 0;
-
-  if (m_subflows[0]->m_tcb->m_lastRtt >= m_subflows[1]->m_tcb->m_lastRtt){
-    rttS = m_subflows[0]->m_tcb->m_lastRtt;
-    rttF = m_subflows[1]->m_tcb->m_lastRtt;
-    slowPathId = 0;
-    fastPathId = 1;
-  } else {
-    rttS = m_subflows[1]->m_tcb->m_lastRtt;
-    rttF = m_subflows[0]->m_tcb->m_lastRtt;
-    slowPathId = 1;
-    fastPathId = 0;
-  }
+  uint8_t fastPathId;
+  uint8_t slowPathId;
+  GetFastAndSlowPaths (fastPathId, slowPathId);
 
   if (m_socket->AvailableWindow (fastPathId) > 0){
     m_lastUsedPathId = fastPathId;
@@ -204,8 +253,7 @@ MpQuicScheduler::MinRtt()
     m_lastUsedPathId = slowPathId;
   }
 
-  tosend[m_lastUsedPathId] = 1.0;
-  return tosend;
+  return m_lastUsedPathId;
 }
 
 void
@@ -215,48 +263,93 @@ MpQuicScheduler::SetSocket(Ptr<QuicSocketBase> sock)
   m_socket = sock;
 }
 
+const Ptr<MpQuicSubFlow> &
+MpQuicScheduler::GetPath (uint8_t pathId) const
+{
+  return m_socket->GetSubflows ()[pathId];
+}
+
+int16_t
+MpQuicScheduler::FindUnmeasuredPath () const
+{
+  for (uint16_t i = 1; i < m_subflows->size (); i++)
+    {
+      if ((*m_subflows)[i]->m_tcb->m_smoothedRtt.IsZero ())
+        {
+          return (*m_subflows)[i]->m_flowId;
+        }
+    }
+  return -1;
+}
 
-std::vector<double>
-MpQuicScheduler::Blest() //only allow two subflows
+void
+MpQuicScheduler::GetFastAndSlowPaths (uint8_t &fastPathId, uint8_t &slowPathId)
 {
   NS_LOG_FUNCTION (this);
-  std::vector<double> tosend(m_subflows.size(), 0.0);
+  NS_ASSERT (m_subflows->size () > 1);
+
+  m_pathsByRtt.resize (m_subflows->size ());
+  std::iota (m_pathsByRtt.begin (), m_pathsByRtt.end (), 0);
+  // ties are broken by path index, as std::stable_sort would, without its temporary buffer
+  std::sort (m_pathsByRtt.begin (), m_pathsByRtt.end (),
+             [this] (uint8_t a, uint8_t b)
+             {
+               const Time &rttA = (*m_subflows)[a]->m_tcb->m_smoothedRtt;
+               const Time &rttB = (*m_subflows)[b]->m_tcb->m_smoothedRtt;
+               return rttA < rttB || (rttA == rttB && a < b);
+             });
+  for (uint8_t &path : m_pathsByRtt)
+    {
+      path = (*m_subflows)[path]->m_flowId;
+    }
 
-  if (m_subflows.size() <= 1){
-    m_lastUsedPathId = 0;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  fastPathId = m_pathsByRtt[0];
+  slowPathId = m_pathsByRtt[1];
+  if (m_socket->AvailableWindow (fastPathId) > 0)
+    {
+      slowPathId = fastPathId;
+      return;
+    }
+  for (uint16_t i = 1; i < m_pathsByRtt.size (); i++)
+    {
+      if (m_socket->AvailableWindow (m_pathsByRtt[i]) > 0)
+        {
+          slowPathId = m_pathsByRtt[i];
+          break;
+        }
+    }
+  NS_LOG_LOGIC ("Fast path " << (uint16_t) fastPathId << " slow path " << (uint16_t) slowPathId);
+}
+
+
+uint8_t
+MpQuicScheduler::Blest()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_subflows->size () <= 1){
+    m_lastUsedPathId = (*m_subflows)[0]->m_flowId;
+    return m_lastUsedPathId;
   }
 
-  if (m_subflows[1]->m_tcb->m_lastRtt.Get().GetSeconds() == 0) {
-    m_lastUsedPathId = 1;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  int16_t unmeasured = FindUnmeasuredPath ();
+  if (unmeasured >= 0) {
+    m_lastUsedPathId = unmeasured;
+    return m_lastUsedPathId;
   }
   
-  Time rttS;
-  Time rttF;
-  uint8_t fastPathId = 1;
-  uint8_t slowPathId = 0;
+  uint8_t fastPathId;
+  uint8_t slowPathId;
+  GetFastAndSlowPaths (fastPathId, slowPathId);
+  const Time &rttS = GetPath (slowPathId)->m_tcb->m_smoothedRtt;
+  const Time &rttF = GetPath (fastPathId)->m_tcb->m_smoothedRtt;
   uint32_t mss = m_socket->GetSegSize();
 
-  if (m_subflows[0]->m_tcb->m_lastRtt > m_subflows[1]->m_tcb->m_lastRtt){
-    rttS = m_subflows[0]->m_tcb->m_lastRtt;
-    rttF = m_subflows[1]->m_tcb->m_lastRtt;
-    slowPathId = 0;
-    fastPathId = 1;
-  } else {
-    rttS = m_subflows[1]->m_tcb->m_lastRtt;
-    rttF = m_subflows[0]->m_tcb->m_lastRtt;
-    slowPathId = 1;
-    fastPathId = 0;
-  }
-
   if (m_socket->AvailableWindow (fastPathId) > 0){
     m_lastUsedPathId = fastPathId;
   } else {
     double_t rtts = rttS.GetSeconds()/rttF.GetSeconds();
-    double_t cwndF = m_subflows[fastPathId]->m_tcb->m_cWnd/mss;
+    double_t cwndF = GetPath (fastPathId)->m_tcb->m_cWnd/mss;
     double_t X = mss * (cwndF + (rtts-1)/2) * rtts;
     double_t comp = m_socket->GetTxAvailable() - (m_socket->BytesInFlight(slowPathId)+mss);
     m_lambda = m_lambda + m_bVar;
@@ -267,58 +360,40 @@ MpQuicScheduler::Blest() //only allow two subflows
     }
   }
   
-  tosend[m_lastUsedPathId] = 1.0;
-  return tosend;
+  return m_lastUsedPathId;
 }
 
 
-std::vector<double>
-MpQuicScheduler::Ecf() //only allow two subflows
+uint8_t
+MpQuicScheduler::Ecf()
 {
   NS_LOG_FUNCTION (this);
-  std::vector<double> tosend(m_subflows.size(), 0.0);
-  if (m_subflows.size() <= 1){
-    m_lastUsedPathId = 0;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  if (m_subflows->size () <= 1){
+    m_lastUsedPathId = (*m_subflows)[0]->m_flowId;
+    return m_lastUsedPathId;
   }
 
-  if (m_subflows[1]->m_tcb->m_lastRtt.Get().GetSeconds() == 0) {
-    m_lastUsedPathId = (m_lastUsedPathId + 1) % m_subflows.size();
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  if (FindUnmeasuredPath () >= 0) {
+    return RoundRobin ();
   } 
   
-  
-  Time rttS;
-  Time rttF;
-  uint8_t fastPathId = 1;
-  uint8_t slowPathId = 0;
-
-  if (m_subflows[0]->m_tcb->m_lastRtt > m_subflows[1]->m_tcb->m_lastRtt){
-    rttS = m_subflows[0]->m_tcb->m_lastRtt;
-    rttF = m_subflows[1]->m_tcb->m_lastRtt;
-    slowPathId = 0;
-    fastPathId = 1;
-  } else {
-    rttS = m_subflows[1]->m_tcb->m_lastRtt;
-    rttF = m_subflows[0]->m_tcb->m_lastRtt;
-    slowPathId = 1;
-    fastPathId = 0;
-  }
+  uint8_t fastPathId;
+  uint8_t slowPathId;
+  GetFastAndSlowPaths (fastPathId, slowPathId);
+  const Time &rttS = GetPath (slowPathId)->m_tcb->m_smoothedRtt;
+  const Time &rttF = GetPath (fastPathId)->m_tcb->m_smoothedRtt;
 
   if (m_socket->AvailableWindow (fastPathId) > 0){
     m_lastUsedPathId = fastPathId;
   }else {
     uint32_t k = m_socket->GetBytesInBuffer();
-    double n = 1 + k/m_subflows[fastPathId]->m_tcb->m_cWnd.Get();
-    double delta = max(m_subflows[fastPathId]->m_tcb->m_rttVar.GetSeconds(),m_subflows[slowPathId]->m_tcb->m_rttVar.GetSeconds());
+    double n = 1 + k/GetPath (fastPathId)->m_tcb->m_cWnd.Get();
+    double delta = max(GetPath (fastPathId)->m_tcb->m_rttVar.GetSeconds(),GetPath (slowPathId)->m_tcb->m_rttVar.GetSeconds());
     if (n*rttF.GetSeconds() < (1+m_waiting*1)*(rttS.GetSeconds()+delta)){
-      if (k/m_subflows[slowPathId]->m_tcb->m_cWnd.Get() * rttS.GetSeconds() >= 2*rttF.GetSeconds()+delta){
+      if (k/GetPath (slowPathId)->m_tcb->m_cWnd.Get() * rttS.GetSeconds() >= 2*rttF.GetSeconds()+delta){
         m_waiting = 1;
         m_lastUsedPathId = fastPathId;
-        tosend[m_lastUsedPathId] = 1.0;
-        return tosend;
+        return m_lastUsedPathId;
       } else {
         m_lastUsedPathId = slowPathId;
       }
@@ -328,72 +403,207 @@ MpQuicScheduler::Ecf() //only allow two subflows
     }
   }  
 
-  tosend[m_lastUsedPathId] = 1.0;
-  return tosend;
+  return m_lastUsedPathId;
+}
+
+uint8_t
+MpQuicScheduler::Deadline()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_subflows->size () <= 1){
+    m_lastUsedPathId = (*m_subflows)[0]->m_flowId;
+    return m_lastUsedPathId;
+  }
+
+  int16_t unmeasured = FindUnmeasuredPath ();
+  if (unmeasured >= 0) {
+    m_lastUsedPathId = unmeasured;
+    return m_lastUsedPathId;
+  }
+
+  Ptr<QuicSocketTxBuffer> txBuffer = m_socket->GetTxBuffer ();
+  uint64_t streamId;
+  uint32_t size;
+  double deadline;
+  bool deprioritized;
+  while (txBuffer->PeekNextDeadline (streamId, size, deadline, deprioritized))
+    {
+      double budget = deadline - Simulator::Now ().GetSeconds ();
+      int16_t sendPathId = -1;
+      int16_t waitPathId = -1;
+      double sendDelay = 0;
+      double waitDelay = 0;
+      for (const Ptr<MpQuicSubFlow> &subflow : *m_subflows)
+        {
+          uint8_t pathId = subflow->m_flowId;
+          double delay = EstimateDelay (pathId, size);
+          if (delay > budget)
+            {
+              continue;
+            }
+          if (m_socket->AvailableWindow (pathId) > 0)
+            {
+              if (sendPathId < 0 or delay < sendDelay)
+                {
+                  sendPathId = pathId;
+                  sendDelay = delay;
+                }
+            }
+          else if (waitPathId < 0 or delay < waitDelay)
+            {
+              waitPathId = pathId;
+              waitDelay = delay;
+            }
+        }
+
+      if (sendPathId >= 0 or waitPathId >= 0)
+        {
+          m_lastUsedPathId = sendPathId >= 0 ? sendPathId : waitPathId;
+          NS_LOG_LOGIC ("Stream " << streamId << " deadline " << deadline
+                        << " met on path " << (uint16_t) m_lastUsedPathId);
+          return m_lastUsedPathId;
+        }
+
+      // a frame that already missed its deadline is sent as soon as possible
+      if (deprioritized)
+        {
+          break;
+        }
+
+      uint32_t misses = ++m_predictedMisses[streamId];
+      NS_LOG_INFO ("Stream " << streamId << " deadline " << deadline
+                   << " cannot be met, " << misses << " predicted misses");
+      m_predictedMissTrace (streamId, misses);
+      if (!txBuffer->DeprioritizeNext ())
+        {
+          break;
+        }
+    }
+
+  m_lastUsedPathId = EarliestDelivery (m_socket->GetSegSize ());
+  return m_lastUsedPathId;
+}
+
+double
+MpQuicScheduler::EstimateDelay (uint8_t pathId, uint32_t size) const
+{
+  Ptr<QuicSocketState> tcb = GetPath (pathId)->m_tcb;
+  double srtt = tcb->m_smoothedRtt.GetSeconds ();
+  uint32_t cWnd = std::max (tcb->m_cWnd.Get (), tcb->m_segmentSize);
+  uint32_t queued = m_socket->BytesInFlight (pathId) + size;
+  double wait = 0;
+  if (queued > cWnd)
+    {
+      wait = srtt * (queued - cWnd) / cWnd;
+    }
+  return wait + srtt / 2 + tcb->m_rttVar.GetSeconds ();
+}
+
+uint8_t
+MpQuicScheduler::EarliestDelivery (uint32_t size) const
+{
+  int16_t bestPathId = -1;
+  bool bestHasWindow = false;
+  double bestDelay = 0;
+  for (const Ptr<MpQuicSubFlow> &subflow : *m_subflows)
+    {
+      uint8_t pathId = subflow->m_flowId;
+      bool hasWindow = m_socket->AvailableWindow (pathId) > 0;
+      double delay = EstimateDelay (pathId, size);
+      if (bestPathId < 0 or (hasWindow and !bestHasWindow)
+          or (hasWindow == bestHasWindow and delay < bestDelay))
+        {
+          bestPathId = pathId;
+          bestHasWindow = hasWindow;
+          bestDelay = delay;
+        }
+    }
+  return bestPathId;
+}
+
+bool
+MpQuicScheduler::IsLatencyCritical (uint8_t pathId)
+{
+  Ptr<QuicSocketState> tcb = GetPath (pathId)->m_tcb;
+  if (m_redundantRttVarRatio > 0
+      and tcb->m_rttVar.GetSeconds () > m_redundantRttVarRatio * tcb->m_smoothedRtt.GetSeconds ())
+    {
+      return true;
+    }
+
+  uint64_t streamId;
+  if (m_redundantLatency.IsStrictlyPositive () and m_socket->GetTxBuffer ()->PeekNextStream (streamId))
+    {
+      Time latency = m_socket->GetTxBuffer ()->GetLatency (streamId);
+      return latency.IsStrictlyPositive () and latency <= m_redundantLatency;
+    }
+  return false;
+}
+
+uint32_t
+MpQuicScheduler::GetPredictedDeadlineMisses (uint64_t streamId) const
+{
+  std::map<uint64_t, uint32_t>::const_iterator it = m_predictedMisses.find (streamId);
+  return it == m_predictedMisses.end () ? 0 : it->second;
 }
 
-std::vector<double>
+MpQuicLinUcbArm::Vector
+MpQuicScheduler::GetPeekabooContext (uint8_t fastPathId, uint8_t slowPathId) const
+{
+  MpQuicLinUcbArm::Vector x = MpQuicLinUcbArm::Vector::Zero ();
+  if (fastPathId < m_peekFeatures.size ())
+    {
+      x.head<3> () = m_peekFeatures[fastPathId];
+    }
+  if (slowPathId < m_peekFeatures.size ())
+    {
+      x.tail<3> () = m_peekFeatures[slowPathId];
+    }
+  return x;
+}
+
+uint8_t
 MpQuicScheduler::Peekaboo()
 {
   NS_LOG_FUNCTION (this);
-  uint8_t K = m_subflows.size();
-  if(EPR.size() < K)
+  uint8_t K = m_socket->GetSubflows ().size ();
+  if (m_peekArms.size() < K)
   {
-    EPR.push_back(0.0);
-    A.push_back(MatrixXd::Identity(6,6));
-    b.push_back(VectorXd::Constant(6,0));
+    m_peekArms.resize(K, MpQuicLinUcbArm (0.8));
   }
-  std::vector<double> tosend(m_subflows.size(), 0.0);
 
-  if (m_subflows.size() <= 1){
-    m_lastUsedPathId = 0;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  if (m_subflows->size () <= 1){
+    m_lastUsedPathId = (*m_subflows)[0]->m_flowId;
+    return m_lastUsedPathId;
   }
-  if (m_subflows[1]->m_tcb->m_lastRtt.Get().GetSeconds() == 0) {
-    m_lastUsedPathId = 1;
-    tosend[m_lastUsedPathId] = 1.0;
-    return tosend;
+  int16_t unmeasured = FindUnmeasuredPath ();
+  if (unmeasured >= 0) {
+    m_lastUsedPathId = unmeasured;
+    return m_lastUsedPathId;
   }
 
-  Time rttS;
-  Time rttF;
-  uint8_t fastPathId = 1;
-  uint8_t slowPathId = 0;
-
-  if (m_subflows[0]->m_tcb->m_lastRtt >= m_subflows[1]->m_tcb->m_lastRtt){
-    rttS = m_subflows[0]->m_tcb->m_lastRtt;
-    rttF = m_subflows[1]->m_tcb->m_lastRtt;
-    slowPathId = 0;
-    fastPathId = 1;
-  } else {
-    rttS = m_subflows[1]->m_tcb->m_lastRtt;
-    rttF = m_subflows[0]->m_tcb->m_lastRtt;
-    slowPathId = 1;
-    fastPathId = 0;
-  }
+  uint8_t fastPathId;
+  uint8_t slowPathId;
+  GetFastAndSlowPaths (fastPathId, slowPathId);
 
   if (m_socket->AvailableWindow (fastPathId) > 0){
     m_lastUsedPathId = fastPathId;
   }else {
-    for (int i = 0; i < 2; i++){
-      MatrixXd zeta = A[i]*b[i];
-      EPR[i] = (peek_x.transpose() * zeta).value() + 0.8 * std::sqrt(peek_x.transpose() * A[i].inverse() * peek_x);
-    }
-
-    if(EPR[fastPathId] > EPR[slowPathId]){
+    MpQuicLinUcbArm::Vector peek_x = GetPeekabooContext (fastPathId, slowPathId);
+    // the expected reward is the LinUCB estimate x' A^-1 b; the scheduler
+    // used x' A b before MpQuicLinUcbArm, which decided differently
+    if(m_peekArms[fastPathId].GetScore(peek_x) > m_peekArms[slowPathId].GetScore(peek_x)){
       m_lastUsedPathId = fastPathId; //wait
     } else {
       m_lastUsedPathId = slowPathId; //transmit on slow path
     }
 
-    A[m_lastUsedPathId] = A[m_lastUsedPathId] + peek_x * peek_x.transpose();
-    b[m_lastUsedPathId] = b[m_lastUsedPathId] + R * peek_x;
+    m_peekArms[m_lastUsedPathId].Update(peek_x, R);
 
   }
 
-  tosend[m_lastUsedPathId] = 1.0;
-  return tosend;
+  return m_lastUsedPathId;
 
 }
 
@@ -402,23 +612,28 @@ void
 MpQuicScheduler::PeekabooReward(uint8_t pathId, Time lastActTime)
 {
   NS_LOG_FUNCTION (this);
+  const std::vector<Ptr<MpQuicSubFlow> > &subflows = m_socket->GetSubflows ();
+  if (pathId >= subflows.size ())
+    {
+      return;
+    }
+  if (m_peekRtt.size () < subflows.size ())
+    {
+      m_peekRtt.resize (subflows.size (), 10);     // initialize the rtt of unmeasured paths with 10ns
+      m_peekFeatures.resize (subflows.size (), Eigen::Vector3d::Zero ());
+    }
   
-  rtt[pathId] = m_subflows[pathId]->m_tcb->m_lastRtt.Get().GetDouble();
-  if (rtt[0]==0) rtt[0] = 10;     // initialize rtt0 with 20ms
-  if (rtt[1]==0) rtt[1] = 10;     // initialize rtt0 with 20ms
-  if(pathId == 0){
-    peek_x[0] = m_subflows[pathId]->m_tcb->m_cWnd.Get()/rtt[pathId];
-    peek_x[1] = m_subflows[pathId]->m_tcb->m_bytesInFlight.Get()/rtt[pathId];
-    peek_x[2] = m_subflows[pathId]->m_tcb->m_cWnd.Get()/rtt[pathId];
-  } else{
-    peek_x[3] = m_subflows[pathId]->m_tcb->m_cWnd.Get()/rtt[pathId];
-    peek_x[4] = m_subflows[pathId]->m_tcb->m_bytesInFlight.Get()/rtt[pathId];
-    peek_x[5] = m_subflows[pathId]->m_tcb->m_cWnd.Get()/rtt[pathId];
-  }
-
+  double rtt = subflows[pathId]->m_tcb->m_lastRtt.Get().GetDouble();
+  if (rtt != 0)
+    {
+      m_peekRtt[pathId] = rtt;
+    }
+  m_peekFeatures[pathId][0] = subflows[pathId]->m_tcb->m_cWnd.Get()/m_peekRtt[pathId];
+  m_peekFeatures[pathId][1] = subflows[pathId]->m_tcb->m_bytesInFlight.Get()/m_peekRtt[pathId];
+  m_peekFeatures[pathId][2] = subflows[pathId]->m_tcb->m_cWnd.Get()/m_peekRtt[pathId];
 
-  double rtt_f = std::min(rtt[0], rtt[1]);
-  double rtt_s = std::max(rtt[0], rtt[1]);
+  double rtt_f = *std::min_element(m_peekRtt.begin(), m_peekRtt.end());
+  double rtt_s = *std::max_element(m_peekRtt.begin(), m_peekRtt.end());
 
   T_r = std::max(2*rtt_f, rtt_s);
   T_e = (Now () - lastActTime).GetMilliSeconds();
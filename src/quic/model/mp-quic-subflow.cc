@@ -57,6 +57,10 @@ MpQuicSubFlow::GetTypeId (void)
                      "The QUIC connection's congestion window",
                      MakeTraceSourceAccessor (&MpQuicSubFlow::m_cWndTrace),
                      "ns3::TracedValueCallback::Uint32")
+        .AddTraceSource ("DeliveryRate",
+                     "The delivery rate sampled on the path",
+                     MakeTraceSourceAccessor (&MpQuicSubFlow::m_deliveryRate),
+                     "ns3::TracedValueCallback::DataRate")
         ;
       return tid;
 }
@@ -65,12 +69,20 @@ MpQuicSubFlow::MpQuicSubFlow()
     : m_flowId (0),
       m_lastMaxData(0),
       m_maxDataInterval(10),
-      m_rounds(1)
+      m_advertisedMaxData(0),
+      m_pacingTokens(0),
+      m_pacingLastRefill(Seconds (0)),
+      m_controlRtt(Seconds (0)),
+      m_windowUpdatePacket(0),
+      m_windowUpdateSent(Seconds (0)),
+      m_rounds(1),
+      m_lastReceived(Seconds (0)),
+      m_challengeSent(Seconds (0)),
+      m_failedSince(Seconds (0))
 {
 
     m_numPacketsReceivedSinceLastAckSent = 0;
     m_queue_ack = false;
-    m_receivedPacketNumbers = std::vector<SequenceNumber32> ();
 
     //For congestion control
     m_tcb = CreateObject<QuicSocketState> ();
@@ -36,6 +36,7 @@
 
 #include "quic-socket-tx-buffer.h"
 #include "quic-socket-base.h"
+#include "quic-ack-range-tracker.h"
 
 #ifndef MP_QUIC_SUBFLOW_H
 #define MP_QUIC_SUBFLOW_H
@@ -52,6 +53,7 @@ public:
     {
       Validating,       //!< subflow is initialed, cannot send data yet
       Active,           //!< sublfow is fully active
+      Failed,           //!< subflow stopped answering, probed until it does again
       Closeing,         //!< subflow is closing
       Closed            //!< subflow is fully closed
     } SubflowStates_t;
@@ -82,8 +84,8 @@ public:
     EventId m_drainingPeriodEvent;              //!< Event triggered upon idle timeout or immediate connection close, when it expires all closes
     TracedValue<Time> m_rto;                    //!< Retransmit timeout
     TracedValue<Time> m_drainingPeriodTimeout;  //!< Draining Period timeout
-    EventId m_sendAckEvent;                     //!< Send ACK timeout event
-    EventId m_delAckEvent;                      //!< Delayed ACK timeout event
+    QuicLazyTimer m_sendAckTimer;               //!< Send ACK timer
+    QuicLazyTimer m_delAckTimer;                //!< Delayed ACK timer
     bool m_flushOnClose;                        //!< Control behavior on connection close
     bool m_closeOnEmpty;                        //!< True if the socket will close after sending the buffered packets
 
@@ -93,13 +95,25 @@ public:
     uint32_t m_numPacketsReceivedSinceLastAckSent;  //!< Number of packets received since last ACK sent
     uint32_t m_lastMaxData;                         //!< Last MaxData ACK
     uint32_t m_maxDataInterval;                     //!< Interval between successive MaxData frames in ACKs
-
-    // Pacing timer
-    Timer m_pacingTimer       {Timer::REMOVE_ON_DESTROY};   //!< Pacing Event
-    std::vector<SequenceNumber32> m_receivedPacketNumbers;  //!< Received packet number vector
+    uint64_t m_advertisedMaxData;                   //!< Last MAX_DATA attached to an ACK of the path
+
+    // Pacing
+    Timer m_pacingTimer       {Timer::REMOVE_ON_DESTROY};   //!< Pacing Event, running while the path waits for pacing tokens
+    int64_t m_pacingTokens;                                 //!< Bytes the path can still send back-to-back
+    Time m_pacingLastRefill;                                //!< Last time the pacing tokens were refilled
+    QuicAckRangeTracker m_receivedPacketNumbers;            //!< Ranges of the received packet numbers
+    TracedValue<DataRate> m_deliveryRate;                   //!< Last delivery rate sampled on the path
+    Time m_controlRtt;                                      //!< Last RTT sampled from an ACK carrying a window update
+    SequenceNumber32 m_windowUpdatePacket;                  //!< Packet number of the ACK carrying a window update
+    Time m_windowUpdateSent;                                //!< Time that ACK was sent, zero once acknowledged
 
     uint32_t m_rounds;
 
+    // Liveness
+    Time m_lastReceived;                        //!< Last time a packet was received on the path
+    Time m_challengeSent;                       //!< Time the unanswered PATH_CHALLENGE was sent, zero if none
+    Time m_failedSince;                         //!< Time the path was declared failed
+
 private:
   TracedCallback<uint32_t, uint32_t> m_cWndTrace;
 
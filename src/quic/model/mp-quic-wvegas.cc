@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "mp-quic-wvegas.h"
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MpQuicWVegas");
+
+NS_OBJECT_ENSURE_REGISTERED (MpQuicWVegas);
+
+TypeId
+MpQuicWVegas::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MpQuicWVegas")
+    .SetParent<MpQuicCongestionOps> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<MpQuicWVegas> ()
+    .AddAttribute ("TotalAlpha", "Packets that all the paths of the connection keep queued",
+                   DoubleValue (10),
+                   MakeDoubleAccessor (&MpQuicWVegas::m_totalAlpha),
+                   MakeDoubleChecker<double> (0))
+    .AddAttribute ("Gamma", "Packets queued by a path that end its slow start",
+                   DoubleValue (1),
+                   MakeDoubleAccessor (&MpQuicWVegas::m_gamma),
+                   MakeDoubleChecker<double> (0))
+  ;
+  return tid;
+}
+
+MpQuicWVegas::MpQuicWVegas (void)
+  : MpQuicCongestionOps (),
+    m_totalAlpha (10),
+    m_gamma (1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicWVegas::MpQuicWVegas (const MpQuicWVegas& sock)
+  : MpQuicCongestionOps (sock),
+    m_totalAlpha (sock.m_totalAlpha),
+    m_gamma (sock.m_gamma)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MpQuicWVegas::~MpQuicWVegas (void)
+{}
+
+std::string
+MpQuicWVegas::GetName () const
+{
+  return "MpQuicCongestionControl_wVegas";
+}
+
+Ptr<TcpCongestionOps>
+MpQuicWVegas::Fork ()
+{
+  return CopyObject<MpQuicWVegas> (this);
+}
+
+bool
+MpQuicWVegas::EndOfEpoch (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                          uint8_t pathId, double &diff)
+{
+  if (pathId >= m_epochs.size ())
+    {
+      PathEpoch epoch = {tcbd->m_highTxMark, Time::Max ()};
+      m_epochs.resize (pathId + 1, epoch);
+    }
+
+  PathEpoch &epoch = m_epochs[pathId];
+  if (!tcbd->m_lastRtt.Get ().IsZero ())
+    {
+      epoch.m_minRtt = std::min (epoch.m_minRtt, tcbd->m_lastRtt.Get ());
+    }
+  if (ackedPacket->m_packetNumber < epoch.m_end || epoch.m_minRtt == Time::Max ())
+    {
+      return false;
+    }
+
+  double rtt = epoch.m_minRtt.GetSeconds ();
+  double baseRtt = std::min (tcbd->m_minRtt, epoch.m_minRtt).GetSeconds ();
+  diff = tcbd->m_cWnd.Get () / (double) tcbd->m_segmentSize * (rtt - baseRtt) / rtt;
+
+  epoch.m_end = tcbd->m_highTxMark;
+  epoch.m_minRtt = Time::Max ();
+  return true;
+}
+
+void
+MpQuicWVegas::SlowStart (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                         uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  double diff;
+  if (EndOfEpoch (tcbd, ackedPacket, pathId, diff) && diff > m_gamma)
+    {
+      NS_LOG_LOGIC ("wVegas path " << (uint16_t) pathId << " queues " << diff << " packets, leave slow start");
+      tcbd->m_ssThresh = tcbd->m_cWnd;
+      return;
+    }
+  MpQuicCongestionOps::SlowStart (tcbd, ackedPacket, pathId, coupled);
+}
+
+void
+MpQuicWVegas::CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                   uint8_t pathId, const MpQuicCoupledState &coupled)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  double diff;
+  if (!EndOfEpoch (tcbd, ackedPacket, pathId, diff))
+    {
+      return;
+    }
+
+  // each path keeps queued a share of TotalAlpha proportional to its rate
+  double weight = 1;
+  double rtt = tcbd->m_smoothedRtt.GetSeconds ();
+  if (rtt > 0 && coupled.GetSumRate () > 0)
+    {
+      weight = std::min (tcbd->m_cWnd.Get () / rtt / coupled.GetSumRate (), 1.0);
+    }
+  double alpha = m_totalAlpha * weight;
+
+  NS_LOG_LOGIC ("wVegas path " << (uint16_t) pathId << " queues " << diff << " packets, target " << alpha);
+  if (diff < alpha)
+    {
+      AddToCwnd (tcbd, tcbd->m_segmentSize);
+    }
+  else if (diff > alpha)
+    {
+      AddToCwnd (tcbd, -1.0 * tcbd->m_segmentSize);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef MPQUICWVEGAS_H
+#define MPQUICWVEGAS_H
+
+#include <vector>
+#include "mp-quic-congestion-ops.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup congestionOps
+ *
+ * \brief Weighted Vegas (wVegas), a delay-based coupled congestion control
+ *
+ * Once per RTT, each path estimates the packets it keeps in the bottleneck
+ * queue, diff = cWnd / MSS * (rtt - baseRtt) / rtt, and compares it with its
+ * share of TotalAlpha, weighted by its share of the connection rate. The
+ * window grows by one segment if diff is below the share, and shrinks by one
+ * if above. Slow start ends as soon as diff exceeds Gamma. Losses halve the
+ * window of the path, as in NewReno.
+ */
+class MpQuicWVegas : public MpQuicCongestionOps
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  MpQuicWVegas ();
+  MpQuicWVegas (const MpQuicWVegas& sock);
+  ~MpQuicWVegas ();
+
+  std::string GetName () const;
+  Ptr<TcpCongestionOps> Fork ();
+
+protected:
+  virtual void SlowStart (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                          uint8_t pathId, const MpQuicCoupledState &coupled);
+  virtual void CongestionAvoidance (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                                    uint8_t pathId, const MpQuicCoupledState &coupled);
+
+private:
+  /**
+   * \brief Measurement of a path over the current RTT
+   */
+  struct PathEpoch
+  {
+    SequenceNumber32 m_end;   //!< Packet number ending the epoch
+    Time m_minRtt;            //!< Smallest RTT sample of the epoch
+  };
+
+  /**
+   * \brief Record the RTT sample of an ACK, and close the epoch of the path if it ended
+   *
+   * \param tcbd the state of the path
+   * \param ackedPacket the acked packet
+   * \param pathId the path
+   * \param diff set to the packets queued by the path, if the epoch ended
+   * \return true if the epoch of the path ended
+   */
+  bool EndOfEpoch (Ptr<QuicSocketState> tcbd, Ptr<QuicSocketTxItem> ackedPacket,
+                   uint8_t pathId, double &diff);
+
+  double m_totalAlpha;              //!< Packets that all the paths together keep queued
+  double m_gamma;                   //!< Packets queued that end slow start
+  std::vector<PathEpoch> m_epochs;  //!< Current epoch of each path
+};
+
+} // namespace ns3
+
+#endif /* MPQUICWVEGAS_H */
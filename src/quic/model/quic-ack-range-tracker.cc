@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "quic-ack-range-tracker.h"
+
+#include <iterator>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QuicAckRangeTracker");
+
+QuicAckRangeTracker::QuicAckRangeTracker ()
+  : m_outOfOrder (false)
+{
+}
+
+bool
+QuicAckRangeTracker::Add (SequenceNumber32 seq)
+{
+  NS_LOG_FUNCTION (this << seq);
+  uint32_t pn = seq.GetValue ();
+
+  if (m_ranges.empty ())
+    {
+      m_ranges[pn] = pn;
+      m_outOfOrder = false;
+      return true;
+    }
+
+  m_outOfOrder = (pn != m_ranges.rbegin ()->second + 1);
+
+  // First range starting after pn, and the one before it (if any)
+  RangeMap::iterator next = m_ranges.upper_bound (pn);
+  RangeMap::iterator prev = m_ranges.end ();
+  if (next != m_ranges.begin ())
+    {
+      prev = std::prev (next);
+      if (prev->second >= pn)
+        {
+          NS_LOG_LOGIC ("Duplicate packet number " << pn);
+          return false;
+        }
+    }
+
+  bool joinPrev = (prev != m_ranges.end () && prev->second + 1 == pn);
+  bool joinNext = (next != m_ranges.end () && next->first == pn + 1);
+
+  if (joinPrev && joinNext)
+    {
+      prev->second = next->second;
+      m_ranges.erase (next);
+    }
+  else if (joinPrev)
+    {
+      prev->second = pn;
+    }
+  else if (joinNext)
+    {
+      uint32_t last = next->second;
+      m_ranges.erase (next);
+      m_ranges[pn] = last;
+    }
+  else
+    {
+      m_ranges[pn] = pn;
+    }
+  return true;
+}
+
+bool
+QuicAckRangeTracker::IsEmpty (void) const
+{
+  return m_ranges.empty ();
+}
+
+SequenceNumber32
+QuicAckRangeTracker::GetLargest (void) const
+{
+  NS_ASSERT (!m_ranges.empty ());
+  return SequenceNumber32 (m_ranges.rbegin ()->second);
+}
+
+uint32_t
+QuicAckRangeTracker::GetNumRanges (void) const
+{
+  return m_ranges.size ();
+}
+
+bool
+QuicAckRangeTracker::IsOutOfOrder (void) const
+{
+  return m_outOfOrder;
+}
+
+void
+QuicAckRangeTracker::GetAckBlocks (QuicAckBlocks &gaps,
+                                   QuicAckBlocks &additionalAckBlocks,
+                                   uint32_t maxGaps) const
+{
+  NS_LOG_FUNCTION (this << maxGaps);
+  gaps.clear ();
+  additionalAckBlocks.clear ();
+
+  if (m_ranges.empty ())
+    {
+      return;
+    }
+
+  RangeMap::const_reverse_iterator curr = m_ranges.rbegin ();
+  RangeMap::const_reverse_iterator next = std::next (curr);
+  for (; next != m_ranges.rend () && gaps.size () < maxGaps; ++curr, ++next)
+    {
+      additionalAckBlocks.push_back (next->second);
+      gaps.push_back (curr->first - 1);
+    }
+}
+
+void
+QuicAckRangeTracker::Prune (uint32_t maxRanges)
+{
+  NS_LOG_FUNCTION (this << maxRanges);
+  if (maxRanges == 0)
+    {
+      return;
+    }
+
+  while (m_ranges.size () > maxRanges)
+    {
+      RangeMap::iterator oldest = m_ranges.begin ();
+      RangeMap::iterator second = std::next (oldest);
+      oldest->second = second->second;
+      m_ranges.erase (second);
+    }
+}
+
+void
+QuicAckRangeTracker::Clear (void)
+{
+  m_ranges.clear ();
+  m_outOfOrder = false;
+}
+
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+
+#ifndef QUICALLOCCOUNTER_H
+#define QUICALLOCCOUNTER_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Count the heap allocations of a program
+ *
+ * The benchmarks and tests use it to measure, or check the absence of, the
+ * allocations of a code path. The counting operator new and delete replace
+ * the global ones for the whole program, so they are only defined in the
+ * file that defines QUIC_ALLOC_COUNTER before including this header, which
+ * must be exactly one translation unit of the program. Every allocation made
+ * with operator new or new[] is counted.
+ */
+class QuicAllocCounter
+{
+public:
+  /**
+   * \return the number of allocations since the program started
+   */
+  static uint64_t GetAllocations (void);
+};
+
+} // namespace ns3
+
+#ifdef QUIC_ALLOC_COUNTER
+
+#include <cstdlib>
+#include <new>
+
+static uint64_t g_quicAllocations = 0;  //!< Number of calls to operator new
+
+uint64_t
+ns3::QuicAllocCounter::GetAllocations (void)
+{
+  return g_quicAllocations;
+}
+
+void *
+operator new (std::size_t size)
+{
+  g_quicAllocations++;
+  void *p = std::malloc (size ? size : 1);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete[] (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+#endif /* QUIC_ALLOC_COUNTER */
+
+#endif /* QUICALLOCCOUNTER_H */
@@ -136,6 +136,11 @@ protected:
    */
   friend class QuicBbrCheckGainValuesTest;
 
+  /**
+   * \brief MpQuicBbr couples the pacing gain of the paths it runs.
+   */
+  friend class MpQuicBbr;
+
   /**
    * \brief Advances pacing gain using cycle gain algorithm, while in BBR_PROBE_BW state
    */
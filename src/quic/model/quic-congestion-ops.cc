@@ -167,8 +167,8 @@ QuicCongestionOps::UpdateRtt (Ptr<TcpSocketState> tcb, Time latestRtt,
     {
       Time rttVarSample = Time (
         std::abs ((tcbd->m_smoothedRtt - latestRtt).GetDouble ()));
-      tcbd->m_rttVar = 3 / 4 * tcbd->m_rttVar + 1 / 4 * rttVarSample;
-      tcbd->m_smoothedRtt = 7 / 8 * tcbd->m_smoothedRtt + 1 / 8 * latestRtt;
+      tcbd->m_rttVar = tcbd->m_rttVar * 3 / 4 + rttVarSample / 4;
+      tcbd->m_smoothedRtt = tcbd->m_smoothedRtt * 7 / 8 + latestRtt / 8;
     }
 
 }
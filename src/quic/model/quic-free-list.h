@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef QUICFREELIST_H
+#define QUICFREELIST_H
+
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief Recycles the storage of the objects of a class
+ *
+ * A class routes its operator new and operator delete through
+ * QuicFreeList<Class>::Allocate and Release. Released blocks are kept in a
+ * singly linked list, threaded through the blocks themselves, and handed
+ * back by the next allocations, so that the objects created and destroyed
+ * for every frame do not reach the heap in the steady state. At most
+ * MAX_FREE blocks are kept; blocks of another size (i.e., of a subclass)
+ * always go to the heap.
+ *
+ * The list is shared by all the instances of the class: objects may outlive
+ * the socket that created them, and the simulator is single-threaded.
+ */
+template <typename T>
+class QuicFreeList
+{
+public:
+  static const uint32_t MAX_FREE = 8192;  //!< Maximum number of blocks kept for reuse
+
+  /**
+   * \brief Get storage for an object
+   * \param size the size of the object
+   * \return the storage
+   */
+  static void* Allocate (std::size_t size)
+  {
+    Store &store = GetStore ();
+    if (size != sizeof (T) || store.m_head == 0)
+      {
+        return ::operator new (size);
+      }
+    Node *node = store.m_head;
+    store.m_head = node->m_next;
+    store.m_size--;
+    return node;
+  }
+
+  /**
+   * \brief Give back the storage of a destroyed object
+   * \param p the storage
+   * \param size the size of the object
+   */
+  static void Release (void *p, std::size_t size)
+  {
+    Store &store = GetStore ();
+    if (p == 0)
+      {
+        return;
+      }
+    if (size != sizeof (T) || store.m_size >= MAX_FREE)
+      {
+        ::operator delete (p);
+        return;
+      }
+    Node *node = static_cast<Node *> (p);
+    node->m_next = store.m_head;
+    store.m_head = node;
+    store.m_size++;
+  }
+
+  /**
+   * \return the number of blocks kept for reuse
+   */
+  static uint32_t GetSize (void)
+  {
+    return GetStore ().m_size;
+  }
+
+private:
+  /**
+   * \brief A released block
+   */
+  struct Node
+  {
+    Node *m_next;   //!< next released block
+  };
+
+  /**
+   * \brief The list of released blocks
+   */
+  struct Store
+  {
+    Node *m_head;     //!< first released block
+    uint32_t m_size;  //!< number of released blocks
+  };
+
+  /**
+   * \brief Get the list, which is never destroyed so that objects released
+   * during static destruction still find it
+   * \return the list
+   */
+  static Store& GetStore (void)
+  {
+    static Store *store = new Store {0, 0};
+    return *store;
+  }
+};
+
+} // namespace ns3
+
+#endif /* QUICFREELIST_H */
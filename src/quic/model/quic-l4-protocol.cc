@@ -165,6 +165,8 @@ QuicL4Protocol::~QuicL4Protocol ()
 {
   NS_LOG_FUNCTION (this);
   m_quicUdpBindingList.clear ();
+  m_connectionIdIndex.clear ();
+  m_pathBindingIndex.clear ();
 }
 
 void
@@ -412,8 +414,11 @@ QuicL4Protocol::SetListener (Ptr<QuicSocketBase> sock)
   if (sock != nullptr and m_quicUdpBindingList.size () == 1)
     {
       m_isServer = true;
+      UnindexBinding (m_quicUdpBindingList.front ());
       m_quicUdpBindingList.front ()->m_quicSocket = sock;
       m_quicUdpBindingList.front ()->m_listenerBinding = true;
+      IndexBinding (m_quicUdpBindingList.front ());
+      m_connectionIdIndex[sock->GetConnectionId ()] = sock;
       return true;
     }
 
@@ -426,12 +431,36 @@ QuicL4Protocol::IsServer (void)  const
   return m_isServer;
 }
 
-const std::vector<Address>&
+const std::unordered_set<Ipv4Address, Ipv4AddressHash>&
 QuicL4Protocol::GetAuthAddresses () const
 {
   return m_authAddresses;
 }
 
+bool
+QuicL4Protocol::IsAuthenticated (Ipv4Address address) const
+{
+  return m_authAddresses.find (address) != m_authAddresses.end ();
+}
+
+Ptr<QuicSocketBase>
+QuicL4Protocol::FindSocket (uint64_t connectionId)
+{
+  NS_LOG_FUNCTION (this << connectionId);
+  auto it = m_connectionIdIndex.find (connectionId);
+  if (it == m_connectionIdIndex.end ())
+    {
+      return 0;
+    }
+  if (it->second->GetConnectionId () != connectionId)
+    {
+      NS_LOG_LOGIC ("Socket " << it->second << " no longer uses connection ID " << connectionId);
+      m_connectionIdIndex.erase (it);
+      return 0;
+    }
+  return it->second;
+}
+
 void
 QuicL4Protocol::ForwardUp (Ptr<Socket> sock)
 {
@@ -488,17 +517,7 @@ QuicL4Protocol::ForwardUp (Ptr<Socket> sock)
                           " if source and destination IP address and port are sufficient to identify a connection");
         }
 
-      QuicUdpBindingList::iterator it;
-      Ptr<QuicSocketBase> socket;
-      for (it = m_quicUdpBindingList.begin (); it != m_quicUdpBindingList.end (); ++it)
-        {
-          Ptr<QuicUdpBinding> item = *it;
-          if (item->m_quicSocket->GetConnectionId () == connectionId)
-            {
-              socket = item->m_quicSocket;
-              break;
-            }
-        }
+      Ptr<QuicSocketBase> socket = FindSocket (connectionId);
 
       NS_LOG_LOGIC ((socket == nullptr));
       /*NS_LOG_INFO ("Initial " << header.IsInitial ());
@@ -512,7 +531,7 @@ QuicL4Protocol::ForwardUp (Ptr<Socket> sock)
         {
           NS_LOG_LOGIC (this << " Cloning listening socket " << m_quicUdpBindingList.front ()->m_quicSocket);
           socket = CloneSocket (m_quicUdpBindingList.front ()->m_quicSocket);
-          socket->SetConnectionId (connectionId);
+          SetConnectionId (socket, connectionId);
           socket->Connect (from);
           socket->SetupCallback ();
 
@@ -521,23 +540,23 @@ QuicL4Protocol::ForwardUp (Ptr<Socket> sock)
         {
           NS_LOG_LOGIC ("CONNECTION AUTHENTICATED - Server authenticated Client " << InetSocketAddress::ConvertFrom (from).GetIpv4 () << " port " <<
                         InetSocketAddress::ConvertFrom (from).GetPort () << "");
-          m_authAddresses.push_back (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the list of authenticated sockets
+          m_authAddresses.insert (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the set of authenticated sockets
         }
       else if (header.IsHandshake () and !m_isServer and socket != nullptr)
         {
           NS_LOG_LOGIC ("CONNECTION AUTHENTICATED - Client authenticated Server " << InetSocketAddress::ConvertFrom (from).GetIpv4 () << " port " <<
                         InetSocketAddress::ConvertFrom (from).GetPort () << "");
-          m_authAddresses.push_back (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the list of authenticated sockets
+          m_authAddresses.insert (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the set of authenticated sockets
         }
       else if (header.IsORTT () and m_isServer)
         {
-          auto result = std::find (m_authAddresses.begin (), m_authAddresses.end (), InetSocketAddress::ConvertFrom (from).GetIpv4 ());
+          bool authenticated = IsAuthenticated (InetSocketAddress::ConvertFrom (from).GetIpv4 ());
           // check if a 0-RTT is allowed with this endpoint - or if the attribute m_0RTTHandshakeStart has been forced to be true
-          if (result == m_authAddresses.end () && m_0RTTHandshakeStart)
+          if (!authenticated && m_0RTTHandshakeStart)
             {
-              m_authAddresses.push_back (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the list of authenticated sockets
+              m_authAddresses.insert (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the set of authenticated sockets
             }
-          else if (result == m_authAddresses.end () && !m_0RTTHandshakeStart)
+          else if (!authenticated && !m_0RTTHandshakeStart)
             {
               NS_LOG_WARN ( this << " CONNECTION ABORTED: 0RTT Packet from unauthenticated address " << InetSocketAddress::ConvertFrom (from).GetIpv4 () << " port " <<
                             InetSocketAddress::ConvertFrom (from).GetPort ());
@@ -548,20 +567,20 @@ QuicL4Protocol::ForwardUp (Ptr<Socket> sock)
                         InetSocketAddress::ConvertFrom (from).GetPort () << "");
           NS_LOG_LOGIC ( this << " Cloning listening socket " << m_quicUdpBindingList.front ()->m_quicSocket);
           socket = CloneSocket (m_quicUdpBindingList.front ()->m_quicSocket);
-          socket->SetConnectionId (connectionId);
+          SetConnectionId (socket, connectionId);
           socket->Connect (from);
           socket->SetupCallback ();
 
         }
       else if (header.IsShort ())
         {
-          auto result = std::find (m_authAddresses.begin (), m_authAddresses.end (), InetSocketAddress::ConvertFrom (from).GetIpv4 ());
+          bool authenticated = IsAuthenticated (InetSocketAddress::ConvertFrom (from).GetIpv4 ());
 
-          if (result == m_authAddresses.end () && m_0RTTHandshakeStart)
+          if (!authenticated && m_0RTTHandshakeStart)
             {
-              m_authAddresses.push_back (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the list of authenticated sockets
+              m_authAddresses.insert (InetSocketAddress::ConvertFrom (from).GetIpv4 ()); //add to the set of authenticated sockets
             }
-          else if (result == m_authAddresses.end () && !m_0RTTHandshakeStart)
+          else if (!authenticated && !m_0RTTHandshakeStart)
             {
               NS_LOG_WARN ( this << " CONNECTION ABORTED: Short Packet from unauthenticated address " << InetSocketAddress::ConvertFrom (from).GetIpv4 () << " port " <<
                             InetSocketAddress::ConvertFrom (from).GetPort ());
@@ -570,10 +589,11 @@ QuicL4Protocol::ForwardUp (Ptr<Socket> sock)
         }
 
       // Handle callback for the correct socket
-      if (!m_socketHandlers[socket].IsNull ())
+      auto handler = m_socketHandlers.find (socket);
+      if (handler != m_socketHandlers.end () && !handler->second.IsNull ())
         {
           NS_LOG_LOGIC (this << " waking up handler of socket " << socket);
-          m_socketHandlers[socket] (packet, header, from);
+          handler->second (packet, header, from);
         }
       else
         {
@@ -641,6 +661,9 @@ QuicL4Protocol::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   m_quicUdpBindingList.clear ();
+  m_connectionIdIndex.clear ();
+  m_pathBindingIndex.clear ();
+  m_socketHandlers.clear ();
 
   m_node = 0;
 //  m_downTarget.Nullify ();
@@ -660,10 +683,46 @@ QuicL4Protocol::CloneSocket (Ptr<QuicSocketBase> oldsock)
   udpBinding->m_quicSocket = newsock;
   udpBinding->m_pathId = 0;
   m_quicUdpBindingList.insert (m_quicUdpBindingList.end (), udpBinding);
+  IndexBinding (udpBinding);
 
   return newsock;
 }
 
+void
+QuicL4Protocol::SetConnectionId (Ptr<QuicSocketBase> socket, uint64_t connectionId)
+{
+  NS_LOG_FUNCTION (this << socket << connectionId);
+
+  // A clone still carries the connection ID of the listener, which keeps its entry
+  auto it = m_connectionIdIndex.find (socket->GetConnectionId ());
+  if (it != m_connectionIdIndex.end () && it->second == socket)
+    {
+      m_connectionIdIndex.erase (it);
+    }
+  socket->SetConnectionId (connectionId);
+  m_connectionIdIndex[connectionId] = socket;
+}
+
+void
+QuicL4Protocol::IndexBinding (Ptr<QuicUdpBinding> binding)
+{
+  NS_LOG_FUNCTION (this << binding);
+  PathBindingKey key = std::make_pair (PeekPointer (binding->m_quicSocket), binding->m_pathId);
+  m_pathBindingIndex.insert (std::make_pair (key, binding));
+}
+
+void
+QuicL4Protocol::UnindexBinding (Ptr<QuicUdpBinding> binding)
+{
+  NS_LOG_FUNCTION (this << binding);
+  PathBindingKey key = std::make_pair (PeekPointer (binding->m_quicSocket), binding->m_pathId);
+  auto it = m_pathBindingIndex.find (key);
+  if (it != m_pathBindingIndex.end () && it->second == binding)
+    {
+      m_pathBindingIndex.erase (it);
+    }
+}
+
 
 
 Ptr<Socket>
@@ -698,29 +757,20 @@ QuicL4Protocol::CreateSocket (TypeId congestionTypeId)
   // sockets associated to this L4 protocol
   Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
 
-  bool found = false;
   uint64_t connectionId;
-  while (not found)
+  do
     {
       connectionId = uint64_t (rand->GetValue (0, pow (2, 64) - 1));
-      found = true;
-      for (auto it = m_quicUdpBindingList.begin (); it != m_quicUdpBindingList.end (); ++it)
-        {
-          found = false;
-          if (connectionId == (*it)->m_quicSocket->GetConnectionId ())
-            {
-              break;
-            }
-          found = true;
-        }
     }
-  socket->SetConnectionId (connectionId);
+  while (FindSocket (connectionId) != nullptr);
+  SetConnectionId (socket, connectionId);
   Ptr<QuicUdpBinding> udpBinding = Create<QuicUdpBinding> ();
   udpBinding->m_budpSocket = nullptr;
   udpBinding->m_budpSocket6 = nullptr;
   udpBinding->m_quicSocket = socket;
   udpBinding->m_pathId = 0;
   m_quicUdpBindingList.insert (m_quicUdpBindingList.end (), udpBinding);
+  IndexBinding (udpBinding);
 
   return socket;
 }
@@ -812,25 +862,49 @@ QuicL4Protocol::SendPacket (Ptr<QuicSocketBase> socket, Ptr<Packet> pkt, const Q
   
   NS_LOG_INFO ("Sending Packet Through UDP Socket");
 
-  // Given the presence of multiple subheaders in pkt,
-  // we create a new packet, add the new QUIC header and
-  // then add pkt as payload
-  Ptr<Packet> packetSent = Create<Packet> ();
-  packetSent->AddHeader (outgoing);
-  packetSent->AddAtEnd (pkt);
+  auto it = m_pathBindingIndex.find (std::make_pair (PeekPointer (socket), pathId));
+  if (it != m_pathBindingIndex.end ())
+    {
+      UdpSend (it->second->m_budpSocket, BuildPacket (pkt, outgoing), 0);
+    }
+}
 
-  QuicUdpBindingList::const_iterator it;
-  for (it = m_quicUdpBindingList.begin (); it != m_quicUdpBindingList.end (); ++it)
+void
+QuicL4Protocol::SendPackets (Ptr<QuicSocketBase> socket, const std::vector<std::pair<Ptr<Packet>, QuicHeader> > &batch) const
+{
+  NS_LOG_FUNCTION (this << socket << batch.size ());
+
+  Ptr<Socket> udpSocket = 0;
+  uint8_t pathId = 0;
+  for (auto &entry : batch)
     {
-      Ptr<QuicUdpBinding> item = *it;
-      if (item->m_quicSocket == socket && item->m_pathId == pathId)
+      if (udpSocket == 0 or entry.second.GetPathId () != pathId)
         {
-          UdpSend (item->m_budpSocket, packetSent, 0);
-          break;
+          pathId = entry.second.GetPathId ();
+          auto it = m_pathBindingIndex.find (std::make_pair (PeekPointer (socket), pathId));
+          udpSocket = (it != m_pathBindingIndex.end ()) ? it->second->m_budpSocket : 0;
+          if (udpSocket == 0)
+            {
+              continue;
+            }
         }
+      NS_LOG_LOGIC (this << " send packet #" << entry.second.GetPacketNumber ()
+                         << " on path " << (uint16_t) pathId << " data size " << entry.first->GetSize ());
+      UdpSend (udpSocket, BuildPacket (entry.first, entry.second), 0);
     }
 }
 
+Ptr<Packet>
+QuicL4Protocol::BuildPacket (Ptr<const Packet> pkt, const QuicHeader &outgoing) const
+{
+  // The socket keeps pkt (e.g., in its sent list): add the QUIC header
+  // on a copy, which shares the payload instead of duplicating it
+  Ptr<Packet> packetSent = pkt->Copy ();
+  packetSent->RemoveAllPacketTags ();
+  packetSent->AddHeader (outgoing);
+  return packetSent;
+}
+
 
 bool
 QuicL4Protocol::RemoveSocket (Ptr<QuicSocketBase> socket)
@@ -851,12 +925,28 @@ QuicL4Protocol::RemoveSocket (Ptr<QuicSocketBase> socket)
             {
               closedListener = true;
             }
+          UnindexBinding (item);
           m_quicUdpBindingList.erase (iter);
 
           break;
         }
     }
 
+  // Stop demultiplexing to the socket once none of its bindings is left
+  if (found)
+    {
+      bool bound = false;
+      for (iter = m_quicUdpBindingList.begin (); iter != m_quicUdpBindingList.end () && !bound; ++iter)
+        {
+          bound = ((*iter)->m_quicSocket == socket);
+        }
+      auto idIt = m_connectionIdIndex.find (socket->GetConnectionId ());
+      if (!bound && idIt != m_connectionIdIndex.end () && idIt->second == socket)
+        {
+          m_connectionIdIndex.erase (idIt);
+        }
+    }
+
   //if closing the listener, close all the clone ones
   if (closedListener)
     {
@@ -1016,6 +1106,7 @@ QuicL4Protocol::AddPath(uint8_t pathId, Ptr<QuicSocketBase> socket, Address loca
       udpBinding->m_quicSocket = socket;
       udpBinding->m_pathId = pathId;
       m_quicUdpBindingList.insert(m_quicUdpBindingList.end (),udpBinding);
+      IndexBinding (udpBinding);
       return res;
     }
   else if (Inet6SocketAddress::IsMatchingType (localAddress))
@@ -1030,6 +1121,7 @@ QuicL4Protocol::AddPath(uint8_t pathId, Ptr<QuicSocketBase> socket, Address loca
       udpBinding->m_quicSocket = socket;
       udpBinding->m_pathId = pathId;
       m_quicUdpBindingList.insert(m_quicUdpBindingList.end (),udpBinding);
+      IndexBinding (udpBinding);
       return res;
     }
   return -1;
@@ -28,6 +28,9 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include "ns3/node.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
@@ -184,6 +187,15 @@ public:
    */
   int UdpSend (Ptr<Socket> udpSocket, Ptr<Packet> p, uint32_t flags) const;
 
+  /**
+   * \brief Build the packet sent on the UDP socket, i.e., a QUIC header followed by the frames
+   *
+   * \param pkt the frames
+   * \param outgoing the QuicHeader of the packet
+   * \return the packet to be sent
+   */
+  Ptr<Packet> BuildPacket (Ptr<const Packet> pkt, const QuicHeader &outgoing) const;
+
   /**
    * \brief Receive a packet from the underlying UDP socket
    *
@@ -239,11 +251,27 @@ public:
   void BindToNetDevice (Ptr<QuicSocketBase> socket, Ptr<NetDevice> netdevice);
 
   /**
-   * \brief Get the authenticated addresses vector
+   * \brief Get the authenticated addresses set
    *
-   * \return The authenticated addresses vector for this L4 Protocol
+   * \return The authenticated addresses set for this L4 Protocol
    */
-  const std::vector<Address >& GetAuthAddresses () const;
+  const std::unordered_set<Ipv4Address, Ipv4AddressHash>& GetAuthAddresses () const;
+
+  /**
+   * \brief Check if an address has been authenticated by this L4 Protocol
+   *
+   * \param address the address to be checked
+   * \return true if the address is in the authenticated addresses set
+   */
+  bool IsAuthenticated (Ipv4Address address) const;
+
+  /**
+   * \brief Find the socket that owns a connection ID
+   *
+   * \param connectionId the connection ID
+   * \return the socket, or 0 if no socket of this L4 Protocol uses the connection ID
+   */
+  Ptr<QuicSocketBase> FindSocket (uint64_t connectionId);
 
   /**
    * \brief This method is called by the underlying UDP socket upon receiving a packet
@@ -269,6 +297,17 @@ public:
    */
   void SendPacket (Ptr<QuicSocketBase> socket, Ptr<Packet> pkt, const QuicHeader &outgoing) const;
 
+  /**
+   * \brief Called by the socket implementation to send a batch of packets
+   *
+   * The packets are sent in order, and the UDP binding of a path is only
+   * looked up when the path changes along the batch.
+   *
+   * \param socket the QuicSocketBase that would send the packets
+   * \param batch the packets, each with its QuicHeader
+   */
+  void SendPackets (Ptr<QuicSocketBase> socket, const std::vector<std::pair<Ptr<Packet>, QuicHeader> > &batch) const;
+
   /**
    * \brief Remove a socket (and its clones if it is a listener)
    *  If no sockets are left, close the UDP connection
@@ -437,14 +476,64 @@ private:
    */
   Ptr<QuicSocketBase> CloneSocket (Ptr<QuicSocketBase> oldsock);
 
+  /**
+   * \brief Assign a connection ID to a socket and index it for the demultiplexing
+   *
+   * \param socket the socket
+   * \param connectionId the connection ID
+   */
+  void SetConnectionId (Ptr<QuicSocketBase> socket, uint64_t connectionId);
+
+  /**
+   * \brief Add a binding to the (socket, path) index used when sending
+   *
+   * The first binding added for a (socket, path) pair is the one used.
+   *
+   * \param binding the binding
+   */
+  void IndexBinding (Ptr<QuicUdpBinding> binding);
+
+  /**
+   * \brief Remove a binding from the (socket, path) index
+   *
+   * \param binding the binding
+   */
+  void UnindexBinding (Ptr<QuicUdpBinding> binding);
+
+  typedef std::pair<const QuicSocketBase *, uint8_t> PathBindingKey;  //!< (socket, path) pair
+
+  /**
+   * \brief Hash function for the (socket, path) pairs
+   */
+  struct PathBindingKeyHash
+  {
+    std::size_t operator() (const PathBindingKey &key) const
+    {
+      return std::hash<const QuicSocketBase *> () (key.first) ^ (std::size_t (key.second) << 1);
+    }
+  };
+
+  /**
+   * \brief Hash function for the smart pointers to sockets
+   */
+  struct SocketHash
+  {
+    std::size_t operator() (const Ptr<Socket> &socket) const
+    {
+      return std::hash<const Socket *> () (PeekPointer (socket));
+    }
+  };
+
   Ptr<Node> m_node;           //!< The node this stack is associated with
   TypeId m_rttTypeId;         //!< The type of RttEstimator objects
   TypeId m_congestionTypeId;  //!< The socket type of QUIC objects
   bool m_0RTTHandshakeStart;  //!< A flag indicating if the L4 Protocol allows the 0-RTT Hansdhake start
-  std::map <Ptr<Socket>, Callback<void, Ptr<Packet>, const QuicHeader&, Address& > > m_socketHandlers;  //!< Callback handlers for sockets
+  std::unordered_map <Ptr<Socket>, Callback<void, Ptr<Packet>, const QuicHeader&, Address& >, SocketHash> m_socketHandlers;  //!< Callback handlers for sockets
 
-  std::vector<Address > m_authAddresses;    //!< Authenticated addresses for this L4 Protocol
+  std::unordered_set<Ipv4Address, Ipv4AddressHash> m_authAddresses;    //!< Authenticated addresses for this L4 Protocol
   QuicUdpBindingList m_quicUdpBindingList;  //!< List of QuicUdp bindings
+  std::unordered_map<uint64_t, Ptr<QuicSocketBase> > m_connectionIdIndex;  //!< Sockets indexed by connection ID
+  std::unordered_map<PathBindingKey, Ptr<QuicUdpBinding>, PathBindingKeyHash> m_pathBindingIndex;  //!< Bindings indexed by (socket, path)
   bool m_isServer;                          //!< A flag indicating if the L4 Protocol is server
 
   Ipv4EndPointDemux *m_endPoints;   //!< A list of IPv4 end points.
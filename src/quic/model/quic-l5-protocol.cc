@@ -31,6 +31,7 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/simulator.h"
+#include <limits>
 // #include "ns3/ipv4-route.h"
 // #include "ns3/ipv6-route.h"
 
@@ -75,7 +76,8 @@ QuicL5Protocol::GetTypeId (void)
 QuicL5Protocol::QuicL5Protocol ()
   : m_socket (0),
   m_node (0),
-  m_connectionId ()
+  m_connectionId (),
+  m_maxData (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
   NS_LOG_LOGIC ("Made a QuicL5Protocol " << this);
@@ -121,6 +123,10 @@ QuicL5Protocol::CreateStream (
   if (stream->GetStreamId () > 0)
     {
       stream->SetMaxStreamData (m_socket->GetInitialMaxStreamData ());
+      if (m_socket->GetRcvBufAutoTuning () and stream->GetStreamRcvBufSize () < m_socket->GetRcvWindow ())
+        {
+          stream->SetStreamRcvBufSize (m_socket->GetRcvWindow ());
+        }
     }
   else
     {
@@ -174,7 +180,7 @@ QuicL5Protocol::DispatchSend (Ptr<Packet> data)
   int sentData = 0;
 
   // if the streams are not created yet, open the streams
-  if (m_streams.size () != m_socket->GetMaxStreamId ())
+  if (m_streams.size () <= m_socket->GetMaxStreamId ())
     {
       NS_LOG_INFO ("Create the missing streams");
       CreateStream (QuicStream::SENDER, m_socket->GetMaxStreamId ());   // TODO open up to max_stream_uni and max_stream_bidi
@@ -219,9 +225,13 @@ QuicL5Protocol::DispatchSend (Ptr<Packet> data, uint64_t streamId)
   if (stream == nullptr)
     {
       CreateStream (QuicStream::SENDER, streamId);
+      stream = SearchStream (streamId);
+      if (stream == nullptr)
+        {
+          return 0;
+        }
     }
 
-  stream = SearchStream (streamId);
   int sentData = 0;
 
   if (stream->GetStreamDirectionType () == QuicStream::SENDER
@@ -237,41 +247,45 @@ int
 QuicL5Protocol::DispatchRecv (Ptr<Packet> data, Address &address)
 {
   NS_LOG_FUNCTION (this);
-  auto disgregated = DisgregateRecv (data);
-
-  if (m_socket->CheckIfPacketOverflowMaxDataLimit (disgregated))
-    {
-      NS_LOG_WARN ("Maximum data limit overflow");
-      // put here this check instead of in QuicSocketBase due to framework mismatch in packet->Copy()
-      SignalAbortConnection (
-        QuicSubheader::TransportErrorCodes_t::FLOW_CONTROL_ERROR,
-        "Received more data w.r.t. Max Data limit");
-      return -1;
-    }
+  std::vector<QuicRxFrame> frames = DisgregateRecv (data);
 
   bool onlyAckFrames = true;
   uint64_t currStreamNum = m_streams.size () - 1;
-  for (auto &elem : disgregated)
+  uint32_t streamBytes = 0;
+  for (const QuicRxFrame &frame : frames)
     {
-      QuicSubheader sub = elem.second;
-
       // check if this is an ack frame
-      if (!sub.IsAck ())
+      if (!frame.m_sub.IsAck ())
         {
           onlyAckFrames = false;
         }
 
-      if (sub.GetStreamId () > currStreamNum)
+      if (frame.m_sub.GetStreamId () > currStreamNum)
+        {
+          currStreamNum = frame.m_sub.GetStreamId ();
+        }
+
+      if (frame.m_payload != nullptr and frame.m_sub.GetStreamId () != 0)
         {
-          currStreamNum = sub.GetStreamId ();
+          streamBytes += frame.m_payload->GetSize ();
         }
     }
 
+  if (m_socket->CheckIfPacketOverflowMaxDataLimit (streamBytes))
+    {
+      NS_LOG_WARN ("Maximum data limit overflow");
+      // put here this check instead of in QuicSocketBase due to framework mismatch in packet->Copy()
+      SignalAbortConnection (
+        QuicSubheader::TransportErrorCodes_t::FLOW_CONTROL_ERROR,
+        "Received more data w.r.t. Max Data limit");
+      return -1;
+    }
+
   CreateStream (QuicStream::RECEIVER, currStreamNum);
 
-  for (auto it = disgregated.begin (); it != disgregated.end (); ++it)
+  for (QuicRxFrame &frame : frames)
     {
-      QuicSubheader sub = (*it).second;
+      QuicSubheader &sub = frame.m_sub;
 
       if (sub.IsRstStream () or sub.IsMaxStreamData ()
           or sub.IsStreamBlocked () or sub.IsStopSending ()
@@ -279,15 +293,17 @@ QuicL5Protocol::DispatchRecv (Ptr<Packet> data, Address &address)
         {
           Ptr<QuicStreamBase> stream = SearchStream (sub.GetStreamId ());
 
+          // MAX_STREAM_DATA is meant for the sending side of the stream
           if (stream != nullptr
-              and (stream->GetStreamDirectionType () == QuicStream::RECEIVER
+              and (sub.IsMaxStreamData ()
+                   or stream->GetStreamDirectionType () == QuicStream::RECEIVER
                    or stream->GetStreamDirectionType ()
                    == QuicStream::BIDIRECTIONAL))
             {
               NS_LOG_INFO (
                 "Receiving frame on stream " << stream->GetStreamId () <<
                   " trigger stream");
-              stream->Recv ((*it).first, sub, address);
+              stream->Recv (frame.m_payload, sub, address);
             }
         }
       else
@@ -357,54 +373,58 @@ QuicL5Protocol::DisgregateSend (Ptr<Packet> data)
   return disgregated;
 }
 
-std::vector< std::pair<Ptr<Packet>, QuicSubheader> >
+std::vector<QuicRxFrame>
 QuicL5Protocol::DisgregateRecv (Ptr<Packet> data)
 {
   NS_LOG_FUNCTION (this);
 
   uint32_t dataSizeByte = data->GetSize ();
-  std::vector< std::pair<Ptr<Packet>, QuicSubheader> > disgregated;
+  std::vector<QuicRxFrame> frames;
+  // most packets carry a single STREAM frame, or a few control frames
+  frames.reserve (4);
   NS_LOG_INFO ("DisgregateRecv for a packet with size " << dataSizeByte);
-  //data->Print(std::cout);
 
   // the packet could contain multiple frames
-  // each of them starts with a subheader
-  // cycle through the data packet and extract the frames
-  for (uint32_t start = 0; start < dataSizeByte; )
+  // each of them starts with a subheader, which is deserialized in place
+  while (data->GetSize () > 0)
     {
-      QuicSubheader sub;
-      data->RemoveHeader (sub);
-      NS_LOG_INFO ("subheader " << sub << " dataSizeByte " << dataSizeByte
-                                << " remaining " << data->GetSize () << " frame size " << sub.GetLength ());
-      Ptr<Packet> remainingfragment = data->CreateFragment (0, sub.GetLength ());
-      NS_LOG_INFO ("fragment size " << remainingfragment->GetSize ());
-
-      // remove the first portion of the packet
-      data->RemoveAtStart (sub.GetLength ());
-      start += sub.GetSerializedSize () + sub.GetLength ();
-      disgregated.push_back (std::make_pair (remainingfragment, sub));
+      frames.emplace_back ();
+      QuicRxFrame &frame = frames.back ();
+      data->RemoveHeader (frame.m_sub);
+      uint32_t length = frame.m_sub.GetLength ();
+      NS_LOG_INFO ("subheader " << frame.m_sub << " dataSizeByte " << dataSizeByte
+                                << " remaining " << data->GetSize () << " frame size " << length);
+
+      if (!frame.m_sub.IsStream ())
+        {
+          data->RemoveAtStart (length);
+        }
+      else if (length >= data->GetSize ())
+        {
+          // last frame of the packet: its payload is what is left of the packet
+          frame.m_payload = data;
+          break;
+        }
+      else
+        {
+          frame.m_payload = data->CreateFragment (0, length);
+          data->RemoveAtStart (length);
+        }
     }
 
-
-  return disgregated;
+  return frames;
 }
 
 Ptr<QuicStreamBase>
 QuicL5Protocol::SearchStream (uint64_t streamId)
 {
-  NS_LOG_FUNCTION (this);
-  std::vector<Ptr<QuicStreamBase> >::iterator it = m_streams.begin ();
-  Ptr<QuicStreamBase> stream;
-  while (it != m_streams.end ())
+  NS_LOG_FUNCTION (this << streamId);
+  if (streamId >= m_streams.size ())
     {
-      if ((*it)->GetStreamId () == streamId)
-        {
-          stream = *it;
-          break;
-        }
-      ++it;
+      return nullptr;
     }
-  return stream;
+  NS_ASSERT (m_streams[streamId]->GetStreamId () == streamId);
+  return m_streams[streamId];
 }
 
 void
@@ -463,17 +483,81 @@ QuicL5Protocol::UpdateInitialMaxStreamData (uint32_t newMaxStreamData)
     }
 }
 
-uint64_t
-QuicL5Protocol::GetMaxData ()
+void
+QuicL5Protocol::UpdateRcvWindow (uint32_t window)
+{
+  NS_LOG_FUNCTION (this << window);
+  for (auto stream : m_streams)
+    {
+      if (stream->GetStreamId () > 0 and stream->GetStreamRcvBufSize () < window)
+        {
+          stream->SetStreamRcvBufSize (window);
+        }
+    }
+}
+
+bool
+QuicL5Protocol::GetRcvBufAutoTuning () const
+{
+  return m_socket->GetRcvBufAutoTuning ();
+}
+
+uint32_t
+QuicL5Protocol::GetConnectionCredit () const
 {
   NS_LOG_FUNCTION (this);
+  if (!m_socket->GetRcvBufAutoTuning ())
+    {
+      return std::numeric_limits<uint32_t>::max ();
+    }
 
-  uint64_t maxData = 0;
+  uint64_t sent = 0;
   for (auto stream : m_streams)
     {
-      maxData += stream->SendMaxStreamData ();
+      sent += stream->GetSentSize ();
     }
-  return maxData;
+  uint64_t maxData = m_socket->GetConnectionMaxData ();
+  return (sent > maxData) ? 0 : std::min<uint64_t> (maxData - sent, std::numeric_limits<uint32_t>::max ());
+}
+
+void
+QuicL5Protocol::ResumeStreams ()
+{
+  NS_LOG_FUNCTION (this);
+  for (auto stream : m_streams)
+    {
+      if (stream->GetStreamId () > 0)
+        {
+          stream->ResumeSending ();
+        }
+    }
+}
+
+uint64_t
+QuicL5Protocol::GetStreamsTxBufferedSize () const
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t buffered = 0;
+  for (auto stream : m_streams)
+    {
+      buffered += stream->GetStreamTxBufferedSize ();
+    }
+  return buffered;
+}
+
+uint64_t
+QuicL5Protocol::GetMaxData ()
+{
+  NS_LOG_FUNCTION (this);
+  return m_maxData;
+}
+
+void
+QuicL5Protocol::UpdateMaxData (uint32_t oldMaxStreamData, uint32_t newMaxStreamData)
+{
+  NS_LOG_FUNCTION (this << oldMaxStreamData << newMaxStreamData);
+  NS_ASSERT (m_maxData >= oldMaxStreamData);
+  m_maxData = m_maxData - oldMaxStreamData + newMaxStreamData;
 }
 
 } // namespace ns3
@@ -35,6 +35,21 @@ namespace ns3 {
 class QuicSocketBase;
 class QuicStreamBase;
 
+/**
+ * \ingroup quic
+ *
+ * \brief A frame of a received packet
+ *
+ * The subheader is deserialized in place, once, and then handed by reference
+ * to the stream or the socket. The payload is only cut out of the packet for
+ * STREAM frames: it is null for every other frame.
+ */
+struct QuicRxFrame
+{
+  QuicSubheader m_sub;      //!< the subheader of the frame
+  Ptr<Packet> m_payload;    //!< the stream data of a STREAM frame, null otherwise
+};
+
 /**
  * This class handles the creation and management of QUIC streams
  * and is associated to a QuicSocketBase object
@@ -154,18 +169,24 @@ public:
   std::vector<Ptr<Packet> > DisgregateSend (Ptr<Packet> data);
 
   /**
-   * \brief Create a vector of frames, corresponding to frames of different streams aggregated in a single QUIC packet
+   * \brief Parse the frames aggregated in a single QUIC packet, in a single pass
+   *
+   * The packet is consumed. The payload of the last STREAM frame is the
+   * packet itself; the other STREAM frames are fragments of it.
    *
    * \param data a smart pointer to the received packet
-   * \return a vector of pairs with frames as smart pointers to packets and subheaders
+   * \return the frames of the packet, in order
    */
-  std::vector< std::pair<Ptr<Packet>, QuicSubheader> > DisgregateRecv (Ptr<Packet> data);
+  std::vector<QuicRxFrame> DisgregateRecv (Ptr<Packet> data);
 
   /**
    * \brief get the stream associated to the ID
    *
+   * Streams are created in order of ID, with no holes, so the stream with
+   * ID n is the n-th element of m_streams.
+   *
    * \param streamId the ID of the stream
-   * \return a smart pointer to the stream object
+   * \return a smart pointer to the stream object, or null if it does not exist
    */
   Ptr<QuicStreamBase> SearchStream (uint64_t streamId);
 
@@ -221,18 +242,64 @@ public:
    */
   void UpdateInitialMaxStreamData (uint32_t newMaxStreamData);
 
+  /**
+   * \brief Grow the receive buffers of the streams to a new receive window
+   *
+   * \param window the receive window
+   */
+  void UpdateRcvWindow (uint32_t window);
+
+  /**
+   * \brief Check if the socket tunes the receive window of the streams
+   *
+   * \return true if the receive window is autotuned
+   */
+  bool GetRcvBufAutoTuning () const;
+
+  /**
+   * \brief Compute the connection credit left by the MAX_DATA of the peer
+   *
+   * Only enforced when the receive window is autotuned, since the peer then
+   * advertises MAX_DATA as an offset, before the streams are opened.
+   *
+   * \return the amount of new data the streams may still send
+   */
+  uint32_t GetConnectionCredit () const;
+
+  /**
+   * \brief Let the streams send the data they were holding for credit
+   */
+  void ResumeStreams ();
+
+  /**
+   * \brief Get the bytes the streams hold back, for credit or buffer space
+   *
+   * \return the bytes in the TX buffers of the streams, not yet passed to the socket
+   */
+  uint64_t GetStreamsTxBufferedSize () const;
+
   /**
    * \brief Return MAX_DATA for flow control (i.e., the sum of MAX_STREAM_DATA for all streams)
    *
    * \returns the new max data value
    */
   uint64_t GetMaxData ();
+
+  /**
+   * \brief Called by a stream when the MAX_STREAM_DATA it would advertise changes,
+   * to keep the connection MAX_DATA up to date
+   *
+   * \param oldMaxStreamData the previous value for the stream
+   * \param newMaxStreamData the new value for the stream
+   */
+  void UpdateMaxData (uint32_t oldMaxStreamData, uint32_t newMaxStreamData);
 bool vnReceived;
 private:
   Ptr<QuicSocketBase> m_socket;                 //!< The Quic socket this stack is associated with
   Ptr<Node> m_node;                             //!< The node this stack is associated with
   uint64_t m_connectionId;                      //!< The connection id this stack is associated with
-  std::vector<Ptr<QuicStreamBase> > m_streams;  //!< The streams this stack is associated with
+  std::vector<Ptr<QuicStreamBase> > m_streams;  //!< The streams this stack is associated with, indexed by stream ID
+  uint64_t m_maxData;                           //!< Sum of the MAX_STREAM_DATA of all the streams
 };
 
 } // namespace ns3
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "quic-lazy-timer.h"
+#include "quic-timer-wheel.h"
+
+#include <algorithm>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QuicLazyTimer");
+
+QuicLazyTimer::QuicLazyTimer ()
+  : m_impl (0),
+    m_event (),
+    m_eventTime (Seconds (0)),
+    m_end (Seconds (0)),
+    m_running (false),
+    m_wheel (0),
+    m_armOrder (0)
+{
+}
+
+QuicLazyTimer::~QuicLazyTimer ()
+{
+  if (m_wheel != 0)
+    {
+      m_wheel->Detach (this);
+    }
+  m_event.Cancel ();
+  delete m_impl;
+}
+
+void
+QuicLazyTimer::SetWheel (QuicTimerWheel *wheel)
+{
+  NS_LOG_FUNCTION (this << wheel);
+  if (wheel == m_wheel)
+    {
+      return;
+    }
+  if (m_wheel != 0)
+    {
+      m_wheel->Detach (this);
+    }
+  m_event.Cancel ();
+  m_wheel = wheel;
+  if (m_wheel != 0)
+    {
+      m_wheel->Attach (this);
+    }
+  if (m_running)
+    {
+      Schedule (std::max (m_end - Simulator::Now (), Time ()));
+    }
+}
+
+void
+QuicLazyTimer::Schedule (Time delay)
+{
+  NS_LOG_FUNCTION (this << delay);
+  m_end = Simulator::Now () + delay;
+  m_running = true;
+  if (m_wheel != 0)
+    {
+      m_wheel->Update (this);
+      return;
+    }
+  if (m_event.IsRunning ())
+    {
+      if (m_eventTime <= m_end)
+        {
+          // the pending event will find the new deadline when it fires
+          return;
+        }
+      m_event.Cancel ();
+    }
+  m_eventTime = m_end;
+  m_event = Simulator::Schedule (delay, &QuicLazyTimer::Expire, this);
+}
+
+void
+QuicLazyTimer::Cancel (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_running = false;
+}
+
+bool
+QuicLazyTimer::IsRunning (void) const
+{
+  return m_running;
+}
+
+bool
+QuicLazyTimer::IsExpired (void) const
+{
+  return !m_running;
+}
+
+Time
+QuicLazyTimer::GetDelayLeft (void) const
+{
+  return m_running ? m_end - Simulator::Now () : Seconds (0);
+}
+
+void
+QuicLazyTimer::Expire (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_running)
+    {
+      return;
+    }
+  Time now = Simulator::Now ();
+  if (m_end > now)
+    {
+      m_eventTime = m_end;
+      m_event = Simulator::Schedule (m_end - now, &QuicLazyTimer::Expire, this);
+      return;
+    }
+  NS_ASSERT_MSG (m_impl != 0, "No function set for the QuicLazyTimer");
+  m_running = false;
+  m_impl->Invoke ();
+}
+
+} // namespace ns3
@@ -72,7 +72,9 @@
 #include <ns3/core-module.h>
 
 #include "mp-quic-scheduler.h"
+#include "mp-quic-reinjection.h"
 #include "mp-quic-congestion-ops.h"
+#include "quic-trace-recorder.h"
 
 namespace ns3 {
 
@@ -129,6 +131,27 @@ QuicSocketBase::GetTypeId (void)
                    UintegerValue (20),
                    MakeUintegerAccessor (&QuicSocketBase::m_maxTrackedGaps),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("PacingBurst", "Number of segments a path can send back-to-back when pacing",
+                   UintegerValue (2),
+                   MakeUintegerAccessor (&QuicSocketBase::m_pacingBurst),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("TxBatchSize", "Maximum number of packets handed to the L4 protocol in one call",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&QuicSocketBase::m_txBatchSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("RcvBufAutoTuning",
+                   "Grow the receive window of the connection, shared by all the paths, with the delivery rate and the RTT of the slowest path, starting from SocketRcvBufSize",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&QuicSocketBase::m_rcvBufAutoTuning),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxRcvBufSize", "Largest receive window the autotuning may reach (bytes)",
+                   UintegerValue (16777216),                                // 16M
+                   MakeUintegerAccessor (&QuicSocketBase::m_maxRcvBufSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("EnableTimerWheel", "Serve the loss detection and ACK timers of all the paths with a single event",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&QuicSocketBase::m_enableTimerWheel),
+                   MakeBooleanChecker ())
     .AddAttribute ("OmitConnectionId", "Omit ConnectionId field in Short QuicHeader format",
                    BooleanValue (false),
                    MakeBooleanAccessor (&QuicSocketBase::m_omit_connection_id),
@@ -239,7 +262,7 @@ QuicSocketBase::GetTypeId (void)
     //                MakeUintegerAccessor (&QuicSocketBase::m_streamSize),
     //                MakeUintegerChecker<uint8_t> ())
     .AddAttribute ("CcType",
-                   "define the type of the scheduler",
+                   "define the type of the congestion control (0 - QuicNewReno, 1 - OLIA, 2 - LIA, 3 - BALIA, 4 - wVegas, 5 - BBR)",
                    IntegerValue (QuicNewReno),
                    MakeIntegerAccessor (&QuicSocketBase::m_ccType),
                    MakeIntegerChecker<int16_t> ())
@@ -264,6 +287,10 @@ QuicSocketBase::GetTypeId (void)
                      "Last RTT sample",
                      MakeTraceSourceAccessor (&QuicSocketBase::m_lastRtt),
                      "ns3::Time::TracedValueCallback")
+    .AddTraceSource ("RcvWindow",
+                     "Receive window of the streams",
+                     MakeTraceSourceAccessor (&QuicSocketBase::m_rcvWindow),
+                     "ns3::TracedValueCallback::Uint32")
     .AddTraceSource ("NextTxSequence",
                      "Next sequence number to send (SND.NXT)",
                      MakeTraceSourceAccessor (&QuicSocketBase::m_nextTxSequenceTrace),
@@ -374,6 +401,11 @@ QuicSocketState::GetTypeId (void)
                    TimeValue (MilliSeconds (200)),
                    MakeTimeAccessor (&QuicSocketState::m_kMinRTOTimeout),
                    MakeTimeChecker ())
+    .AddAttribute ("kMaxRTOTimeout",
+                   "Maximum time in the future a backed off handshake or RTO alarm may be set for",
+                   TimeValue (Seconds (60)),
+                   MakeTimeAccessor (&QuicSocketState::m_kMaxRTOTimeout),
+                   MakeTimeChecker ())
     .AddAttribute ("kDelayedAckTimeout", "The lenght of the peer's delayed ack timer",
                    TimeValue (MilliSeconds (25)),
                    MakeTimeAccessor (&QuicSocketState::m_kDelayedAckTimeout),
@@ -422,6 +454,7 @@ QuicSocketState::QuicSocketState ()
     m_kMinTLPTimeout (MilliSeconds (10)),
     m_kMinRTOTimeout (
       MilliSeconds (200)),
+    m_kMaxRTOTimeout (Seconds (60)),
     m_kDelayedAckTimeout (MilliSeconds (25)),
     m_alarmType (0),
     m_nextAlarmTrigger (Seconds (100)),
@@ -429,12 +462,11 @@ QuicSocketState::QuicSocketState ()
       MilliSeconds (100)),
     m_kMaxPacketsReceivedBeforeAckSend (20)
 {
-  m_lossDetectionAlarm.Cancel ();
 }
 
 QuicSocketState::QuicSocketState (const QuicSocketState &other)
   : TcpSocketState (other),
-    m_lossDetectionAlarm (other.m_lossDetectionAlarm),
+    m_lossDetectionAlarm (),
     m_handshakeCount (
       other.m_handshakeCount),
     m_tlpCount (other.m_tlpCount),
@@ -469,13 +501,13 @@ QuicSocketState::QuicSocketState (const QuicSocketState &other)
     m_kMinTLPTimeout (
       other.m_kMinTLPTimeout),
     m_kMinRTOTimeout (other.m_kMinRTOTimeout),
+    m_kMaxRTOTimeout (other.m_kMaxRTOTimeout),
     m_kDelayedAckTimeout (
       other.m_kDelayedAckTimeout),
     m_kDefaultInitialRtt (
       other.m_kDefaultInitialRtt),
     m_kMaxPacketsReceivedBeforeAckSend (other.m_kMaxPacketsReceivedBeforeAckSend)
 {
-  m_lossDetectionAlarm.Cancel ();
 }
 
 QuicSocketBase::QuicSocketBase (void)
@@ -521,11 +553,20 @@ QuicSocketBase::QuicSocketBase (void)
     m_lastRtt (Seconds (0.0)),
     m_queue_ack (false),
     m_numPacketsReceivedSinceLastAckSent (0),
-    m_pacingTimer (Timer::REMOVE_ON_DESTROY),
+    m_pacingBurst (2),
+    m_txBatchSize (16),
+    m_rcvBufAutoTuning (true),
+    m_maxRcvBufSize (16777216),
+    m_rcvWindow (0),
+    m_rcvSpaceBytes (0),
+    m_rcvSpaceStart (Seconds (0)),
+    m_peerMaxData (0),
+    m_enableTimerWheel (true),
     m_enableMultipath(false),
     m_pathManager(0),
     m_scheduler (0),
-    m_subflows (0)
+    m_subflows (0),
+    m_activeSubflowsChanged (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -533,9 +574,9 @@ QuicSocketBase::QuicSocketBase (void)
   m_rxBuffer = CreateObject<QuicSocketRxBuffer> ();
   m_txBuffer = CreateObject<QuicSocketTxBuffer> ();
   m_receivedPacketNumbers = std::vector<SequenceNumber32> ();
+  m_idleTimeoutTimer.SetFunction (&QuicSocketBase::Close, this);
 
   m_quicCongestionControlLegacy = false;
-  m_pacingTimer.SetFunction (&QuicSocketBase::NotifyPacingPerformed, this);
 
   // /**
   //  * [IETF DRAFT 10 - Quic Transport: sec 5.7.1]
@@ -555,6 +596,7 @@ QuicSocketBase::QuicSocketBase (void)
   m_subflows = std::vector <Ptr<MpQuicSubFlow>> ();
   CreatePathManager();
   CreateScheduler();
+  CreateReinjection();
 
 }
 
@@ -593,13 +635,23 @@ QuicSocketBase::QuicSocketBase (const QuicSocketBase& sock)   // Copy constructo
     m_numPacketsReceivedSinceLastAckSent (sock.m_numPacketsReceivedSinceLastAckSent),
     m_lastMaxData(0),
     m_maxDataInterval(10),
-    m_pacingTimer (Timer::REMOVE_ON_DESTROY),
+    m_initialPacketSize (sock.m_initialPacketSize),
+    m_pacingBurst (sock.m_pacingBurst),
+    m_txBatchSize (sock.m_txBatchSize),
+    m_rcvBufAutoTuning (sock.m_rcvBufAutoTuning),
+    m_maxRcvBufSize (sock.m_maxRcvBufSize),
+    m_rcvWindow (sock.m_rcvWindow),
+    m_rcvSpaceBytes (0),
+    m_rcvSpaceStart (Seconds (0)),
+    m_peerMaxData (0),
+    m_enableTimerWheel (sock.m_enableTimerWheel),
     m_txTrace (sock.m_txTrace),
     m_rxTrace (sock.m_rxTrace),
     m_enableMultipath(sock.m_enableMultipath),
     m_pathManager(sock.m_pathManager),
     m_scheduler (sock.m_scheduler),
-    m_subflows (sock.m_subflows)
+    m_subflows (sock.m_subflows),
+    m_activeSubflowsChanged (true)
 {
   NS_LOG_FUNCTION (this);
 
@@ -618,9 +670,16 @@ QuicSocketBase::QuicSocketBase (const QuicSocketBase& sock)   // Copy constructo
   // m_txBuffer->SetQuicSocketState (m_tcb);
 
   // m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
-  m_pacingTimer.SetFunction (&QuicSocketBase::NotifyPacingPerformed, this);
+  for (auto subflow : m_subflows)
+    {
+      subflow->m_pacingTimer.SetFunction (&QuicSocketBase::NotifyPacingPerformed, this);
+      SetSubflowTimers (subflow);
+      subflow->m_subflowState.ConnectWithoutContext (MakeCallback (&QuicSocketBase::SubflowStateChanged, this));
+    }
+  m_idleTimeoutTimer.SetFunction (&QuicSocketBase::Close, this);
 
   m_pathManager->SetSocket(this);
+  CreateReinjection ();
 }
 
 QuicSocketBase::~QuicSocketBase (void)
@@ -643,9 +702,14 @@ QuicSocketBase::~QuicSocketBase (void)
       NS_ASSERT (m_endPoint6 == nullptr);
     }
   m_quicl4 = 0;
+  for (auto subflow : m_subflows)
+    {
+      subflow->m_pacingTimer.Cancel ();
+      subflow->m_subflowState.DisconnectWithoutContext (MakeCallback (&QuicSocketBase::SubflowStateChanged, this));
+    }
   m_subflows.clear();
+  m_activeSubflows.clear();
   //CancelAllTimers ();
-  m_pacingTimer.Cancel ();
 }
 
 /* Inherit from Socket class: Bind socket to an end-point in QuicL4Protocol */
@@ -863,11 +927,7 @@ QuicSocketBase::Connect (const Address & address)
     }
 
   // check if the address is in a list of known and authenticated addresses
-  auto result = std::find (
-    m_quicl4->GetAuthAddresses ().begin (), m_quicl4->GetAuthAddresses ().end (),
-    InetSocketAddress::ConvertFrom (address).GetIpv4 ());
-
-  if (result != m_quicl4->GetAuthAddresses ().end ()
+  if (m_quicl4->IsAuthenticated (InetSocketAddress::ConvertFrom (address).GetIpv4 ())
       || m_quicl4->Is0RTTHandshakeAllowed ())
     {
       NS_LOG_INFO (
@@ -941,7 +1001,7 @@ QuicSocketBase::AppendingTx (Ptr<Packet> frame)
         }
       else
         {
-          uint32_t win;
+          uint32_t win = 0;
           for (uint16_t i = 0; i < GetActiveSubflows().size(); i++){
             win += AvailableWindow (i);
           }
@@ -981,6 +1041,11 @@ QuicSocketBase::SendPendingData (bool withAck)
 {
   NS_LOG_FUNCTION (this << withAck);
 
+  if (m_enableMultipath && m_socketState == OPEN)
+    {
+      m_reinjection->MaybeReinject ();
+    }
+
   if (m_txBuffer->AppSize () == 0)
     {
       if (m_closeOnEmpty)
@@ -998,138 +1063,134 @@ QuicSocketBase::SendPendingData (bool withAck)
   while (m_txBuffer->GetNumFrameStream0InBuffer () > 0)
   {
     // check pacing timer
-    if (m_subflows[0]->m_tcb->m_pacing)
-    {
-      NS_LOG_DEBUG ("Pacing is enabled");
-      if (m_pacingTimer.IsRunning ())
-        {
-          NS_LOG_INFO ("Skipping Packet due to pacing - for " << m_pacingTimer.GetDelayLeft ());
-          break;
-        }
-      NS_LOG_DEBUG ("Pacing Timer is not running");
-    }
-
-    uint32_t win = AvailableWindow (0); //just use first subflow to deal with stream 0
-    uint32_t connWin = ConnectionWindow (0);
-    uint32_t bytesInFlight = BytesInFlight (0);
-    
-    NS_LOG_DEBUG (
-    "BEFORE stream 0 Available Window " << win
-                                      << " Connection RWnd " << connWin
-                                      << " BytesInFlight " << bytesInFlight
-                                      << " BufferedSize " << m_txBuffer->AppSize ()
-                                      << " MaxPacketSize " << GetSegSize ());
-
+    if (IsPacingBlocked (0))
+      {
+        NS_LOG_INFO ("Skipping Packet due to pacing - for " << m_subflows[0]->m_pacingTimer.GetDelayLeft ());
+        break;
+      }
 
-    NS_LOG_DEBUG ("Send a frame for stream 0");
+    NS_LOG_DEBUG ("Send a frame for stream 0, BufferedSize " << m_txBuffer->AppSize ()
+                  << " MaxPacketSize " << GetSegSize ());
     SequenceNumber32 next = ++m_subflows[0]->m_tcb->m_nextTxSequence;
     NS_LOG_INFO ("on path 0 SN " << next);
 
     SendDataPacket (next, 0, m_subflows[0]->m_queue_ack, 0);
-    
-    win = AvailableWindow (0);
-    connWin = ConnectionWindow (0);
-    bytesInFlight = BytesInFlight (0);
-    NS_LOG_DEBUG (
-      "AFTER stream 0 Available Window " << win
-                                          << " Connection RWnd " << connWin
-                                          << " BytesInFlight " << bytesInFlight
-                                          << " BufferedSize " << m_txBuffer->AppSize ()
-                                          << " MaxPacketSize " << GetSegSize ());
 
     ++nPacketsSent;
   }
 
 
-  std::vector<double> sendP = m_scheduler->GetNextPathIdToUse();
-
-  for (uint8_t sendingPathId = 0; sendingPathId < sendP.size(); sendingPathId++)
-  {
-    uint32_t availableWindow = AvailableWindow (sendingPathId);
-    uint32_t sendSize = m_txBuffer->AppSize () * sendP[sendingPathId];
-    uint32_t sendNumber = sendSize/GetSegSize();
-    if (sendSize > availableWindow)
+  // Keep asking the scheduler while the paths it picks can send: once a path
+  // runs out of window, the scheduler decides whether to wait for it or to
+  // move on to another path
+  uint32_t nPacketsScheduled;
+  do
     {
-      sendNumber = availableWindow/GetSegSize();
-    } 
+      nPacketsScheduled = 0;
+      m_scheduler->GetNextPathIdToUse (m_txBuffer->AppSize (), m_pathSplit);
 
-    while (sendNumber > 0 and availableWindow > 0 and m_txBuffer->AppSize () > 0)
+      uint32_t firstPathSize = 0;
+      for (uint8_t i = 0; i < m_pathSplit.GetSize (); i++)
       {
-        // check draining period
-        if (m_drainingPeriodEvent.IsRunning ())
+        uint8_t sendingPathId = m_pathSplit.Get (i).m_pathId;
+        if (m_enableMultipath and m_subflows[sendingPathId]->m_subflowState != MpQuicSubFlow::Active)
           {
-            NS_LOG_INFO ("Draining period: no packets can be sent");
-            return false;
+            // the scheduler only picks active paths, but fall back on the
+            // next entry rather than sending on a failed or closed one
+            NS_LOG_INFO ("Path " << (uint16_t) sendingPathId << " is not active");
+            continue;
           }
-
-        // check pacing timer
-        if (m_subflows[sendingPathId]->m_tcb->m_pacing)
+        if (m_pathSplit.Get (i).m_duplicate)
           {
-            NS_LOG_DEBUG ("Pacing is enabled");
-            if (m_pacingTimer.IsRunning ())
+            // copy the packet just sent on the first path, if this path can take it
+            if (firstPathSize > 0 and AvailableWindow (sendingPathId) > 0
+                and !IsPacingBlocked (sendingPathId))
               {
-                NS_LOG_INFO ("Skipping Packet due to pacing - for " << m_pacingTimer.GetDelayLeft ());
-                break;
+                SequenceNumber32 next = ++m_subflows[sendingPathId]->m_tcb->m_nextTxSequence;
+                NS_LOG_INFO ("copy on path " << sendingPathId << " SN " << next);
+                SendDataPacket (next, 0, withAck, sendingPathId, true);
+                ++nPacketsSent;
               }
-            NS_LOG_DEBUG ("Pacing Timer is not running");
+            continue;
           }
+        uint32_t availableWindow = AvailableWindow (sendingPathId);
+        uint32_t sendSize = m_pathSplit.Get (i).m_budget;
+        uint32_t sendNumber = sendSize/GetSegSize();
+        if (sendSize > availableWindow)
+        {
+          sendNumber = availableWindow/GetSegSize();
+        } 
+        else if (sendNumber == 0 and sendSize >= m_txBuffer->AppSize ())
+        {
+          // the tail of the data is shorter than a segment
+          sendNumber = 1;
+        }
 
-        // check the state of the socket!
-        if (m_socketState == CONNECTING_CLT || m_socketState == CONNECTING_SVR)
+        while (sendNumber > 0 and availableWindow > 0 and m_txBuffer->AppSize () > 0)
           {
-            NS_LOG_INFO ("CONNECTING_CLT and CONNECTING_SVR state; no data to transmit");
-            break;
-          }
+            // check draining period
+            if (m_drainingPeriodEvent.IsRunning ())
+              {
+                NS_LOG_INFO ("Draining period: no packets can be sent");
+                FlushTxBatch ();
+                return false;
+              }
 
-        uint32_t availableData = m_txBuffer->AppSize ();
+            // check the pacing timer of this path only, the other paths keep their own pace
+            if (IsPacingBlocked (sendingPathId))
+              {
+                NS_LOG_INFO ("Skipping Packet on path " << (uint16_t) sendingPathId << " due to pacing - for " <<
+                             m_subflows[sendingPathId]->m_pacingTimer.GetDelayLeft ());
+                break;
+              }
 
-        if (availableData < availableWindow and !m_closeOnEmpty)
-          {
-            NS_LOG_INFO ("Ask the app for more data before trying to send");
-            NotifySend (GetTxAvailable ());
-          }
+            // check the state of the socket!
+            if (m_socketState == CONNECTING_CLT || m_socketState == CONNECTING_SVR)
+              {
+                NS_LOG_INFO ("CONNECTING_CLT and CONNECTING_SVR state; no data to transmit");
+                break;
+              }
 
-        if (availableWindow < GetSegSize () and availableData > availableWindow and !m_closeOnEmpty)
-          {
-            NS_LOG_INFO ("Preventing Silly Window Syndrome. Wait to Send.");
-            break;
-          }
+            uint32_t availableData = m_txBuffer->AppSize ();
 
-        SequenceNumber32 next = ++m_subflows[sendingPathId]->m_tcb->m_nextTxSequence;
+            if (availableData < availableWindow and !m_closeOnEmpty)
+              {
+                NS_LOG_INFO ("Ask the app for more data before trying to send");
+                NotifySend (GetTxAvailable ());
+              }
 
-        uint32_t s = std::min (availableWindow, GetSegSize ());
+            if (availableWindow < GetSegSize () and availableData > availableWindow and !m_closeOnEmpty)
+              {
+                NS_LOG_INFO ("Preventing Silly Window Syndrome. Wait to Send.");
+                break;
+              }
 
-        uint32_t win = AvailableWindow (sendingPathId); // mark: to be AvailableWindow (m_lastUsedsFlowIdx)
-        uint32_t connWin = ConnectionWindow (sendingPathId);
-        uint32_t bytesInFlight = BytesInFlight (sendingPathId);
+            SequenceNumber32 next = ++m_subflows[sendingPathId]->m_tcb->m_nextTxSequence;
 
-        NS_LOG_DEBUG (
-          "BEFORE Available Window " << win
-                                    << " Connection RWnd " << connWin
-                                    << " BytesInFlight " << bytesInFlight
-                                    << " BufferedSize " << m_txBuffer->AppSize ()
-                                    << " MaxPacketSize " << GetSegSize ());
+            uint32_t s = std::min (availableWindow, GetSegSize ());
 
-        NS_LOG_INFO ("on path " << sendingPathId << " SN " << next);
-        // uint32_t sz =
-        SendDataPacket (next, s, withAck, sendingPathId);
+            NS_LOG_DEBUG ("Available Window " << availableWindow
+                                              << " BufferedSize " << m_txBuffer->AppSize ()
+                                              << " MaxPacketSize " << GetSegSize ());
 
-        win = AvailableWindow (sendingPathId);
-        connWin = ConnectionWindow (sendingPathId);
-        bytesInFlight = BytesInFlight (sendingPathId);
-        NS_LOG_DEBUG (
-          "AFTER Available Window " << win
-                                    << " Connection RWnd " << connWin
-                                    << " BytesInFlight " << bytesInFlight
-                                    << " BufferedSize " << m_txBuffer->AppSize ()
-                                    << " MaxPacketSize " << GetSegSize ());
+            NS_LOG_INFO ("on path " << sendingPathId << " SN " << next);
+            uint32_t sz = SendDataPacket (next, s, withAck, sendingPathId);
+            if (i == 0)
+              {
+                firstPathSize = sz;
+              }
 
-        ++nPacketsSent;
+            ++nPacketsScheduled;
 
-        availableWindow = AvailableWindow(sendingPathId);
-        sendNumber--;
+            availableWindow = AvailableWindow (sendingPathId);
+            sendNumber--;
+          }
       }
-  }
+      nPacketsSent += nPacketsScheduled;
+    }
+  while (nPacketsScheduled > 0 and m_txBuffer->AppSize () > 0);
+
+  FlushTxBatch ();
 
   if (nPacketsSent > 0)
     {
@@ -1164,7 +1225,7 @@ QuicSocketBase::MaybeQueueAck (uint8_t pathId)
   NS_LOG_INFO ("m_numPacketsReceivedSinceLastAckSent " << m_subflows[pathId]->m_numPacketsReceivedSinceLastAckSent << " m_queue_ack " << m_subflows[pathId]->m_queue_ack);
 
   // handle the list of m_receivedPacketNumbers
-  if (m_subflows[pathId]->m_receivedPacketNumbers.empty ())
+  if (m_subflows[pathId]->m_receivedPacketNumbers.IsEmpty ())
     {
       NS_LOG_INFO ("Nothing to ACK");
       m_subflows[pathId]->m_queue_ack = false;
@@ -1175,19 +1236,19 @@ QuicSocketBase::MaybeQueueAck (uint8_t pathId)
     {
       NS_LOG_INFO ("immediately send ACK - max number of unacked packets reached");
       m_subflows[pathId]->m_queue_ack = true;
-      if (!m_subflows[pathId]->m_sendAckEvent.IsRunning ())
+      if (!m_subflows[pathId]->m_sendAckTimer.IsRunning ())
         {
-          m_subflows[pathId]->m_sendAckEvent = Simulator::Schedule (TimeStep (1), &QuicSocketBase::SendAck, this, pathId);
+          m_subflows[pathId]->m_sendAckTimer.Schedule (TimeStep (1));
         }
     }
 
-  if (HasReceivedMissing ())  // immediately queue the ACK
+  if (HasReceivedMissing (pathId))  // immediately queue the ACK
     {
       NS_LOG_INFO ("immediately send ACK - some packets have been received out of order");
       m_subflows[pathId]->m_queue_ack = true;
-      if (!m_subflows[pathId]->m_sendAckEvent.IsRunning ())
+      if (!m_subflows[pathId]->m_sendAckTimer.IsRunning ())
         {
-          m_subflows[pathId]->m_sendAckEvent = Simulator::Schedule (TimeStep (1), &QuicSocketBase::SendAck, this, pathId);
+          m_subflows[pathId]->m_sendAckTimer.Schedule (TimeStep (1));
         }
     }
 
@@ -1197,19 +1258,18 @@ QuicSocketBase::MaybeQueueAck (uint8_t pathId)
         {
           NS_LOG_INFO ("immediately send ACK - more than 2 packets received");
           m_subflows[pathId]->m_queue_ack = true;
-          if (!m_subflows[pathId]->m_sendAckEvent.IsRunning ())
+          if (!m_subflows[pathId]->m_sendAckTimer.IsRunning ())
             {
-              m_subflows[pathId]->m_sendAckEvent = Simulator::Schedule (TimeStep (1), &QuicSocketBase::SendAck, this, pathId);
+              m_subflows[pathId]->m_sendAckTimer.Schedule (TimeStep (1));
             }
         }
       else
         {
-          if (!m_subflows[pathId]->m_delAckEvent.IsRunning ())
+          if (!m_subflows[pathId]->m_delAckTimer.IsRunning ())
             {
               NS_LOG_INFO ("Schedule a delayed ACK");
               // schedule a delayed ACK
-              m_subflows[pathId]->m_delAckEvent = Simulator::Schedule (
-                m_subflows[pathId]->m_tcb->m_kDelayedAckTimeout, &QuicSocketBase::SendAck, this, pathId);
+              m_subflows[pathId]->m_delAckTimer.Schedule (m_subflows[pathId]->m_tcb->m_kDelayedAckTimeout);
             }
           else
             {
@@ -1220,28 +1280,35 @@ QuicSocketBase::MaybeQueueAck (uint8_t pathId)
 }
 
 bool
-QuicSocketBase::HasReceivedMissing ()
+QuicSocketBase::HasReceivedMissing (uint8_t pathId)
 {
-  // TODO implement this
-  return false;
+  return m_subflows[pathId]->m_receivedPacketNumbers.IsOutOfOrder ();
 }
 
 void
 QuicSocketBase::SendAck (uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
-  m_subflows[pathId]->m_delAckEvent.Cancel ();
-  m_subflows[pathId]->m_sendAckEvent.Cancel ();
+  m_subflows[pathId]->m_delAckTimer.Cancel ();
+  m_subflows[pathId]->m_sendAckTimer.Cancel ();
   m_subflows[pathId]->m_queue_ack = false;
 
   m_subflows[pathId]->m_numPacketsReceivedSinceLastAckSent = 0;
 
   
   Ptr<Packet> p = Create<Packet> ();
-  if (!m_subflows[pathId]->m_receivedPacketNumbers.empty())
+  if (!m_subflows[pathId]->m_receivedPacketNumbers.IsEmpty ())
   {
+    uint64_t advertisedMaxData = m_subflows[pathId]->m_advertisedMaxData;
     p->AddAtEnd (OnSendingAckFrame (pathId));
     SequenceNumber32 packetNumber = ++m_subflows[pathId]->m_tcb->m_nextTxSequence;
+    if (m_subflows[pathId]->m_advertisedMaxData != advertisedMaxData
+        and m_subflows[pathId]->m_windowUpdateSent.IsZero ())
+      {
+        // the window update makes the ACK ack-eliciting
+        m_subflows[pathId]->m_windowUpdatePacket = packetNumber;
+        m_subflows[pathId]->m_windowUpdateSent = Simulator::Now ();
+      }
     QuicHeader head;
     head = QuicHeader::CreateShort (m_connectionId, packetNumber, !m_omit_connection_id, m_keyPhase);
 
@@ -1260,7 +1327,8 @@ QuicSocketBase::SendAck (uint8_t pathId)
 
 
 uint32_t
-QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize, bool withAck, uint8_t pathId)
+QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize, bool withAck, uint8_t pathId,
+                                bool duplicate)
 {
   NS_LOG_FUNCTION (this << packetNumber << maxSize << withAck);
 
@@ -1268,9 +1336,8 @@ QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize,
 
   if (!m_drainingPeriodEvent.IsRunning ())
     {
-      m_idleTimeoutEvent.Cancel ();
       NS_LOG_LOGIC (this << " SendDataPacket Schedule Close at time " << Simulator::Now ().GetSeconds () << " to expire at time " << (Simulator::Now () + m_idleTimeout.Get ()).GetSeconds ());
-      m_idleTimeoutEvent = Simulator::Schedule (m_idleTimeout, &QuicSocketBase::Close, this);
+      m_idleTimeoutTimer.Schedule (m_idleTimeout);
     }
   else
     {
@@ -1280,22 +1347,28 @@ QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize,
 
   Ptr<Packet> p;
 
-  if (m_txBuffer->GetNumFrameStream0InBuffer () > 0)
+  if (duplicate)
+    {
+      NS_LOG_LOGIC (this << " SendDataPacket - sending copy " << packetNumber.GetValue () << " on path " << (uint16_t) pathId);
+      p = m_txBuffer->NextDuplicate (packetNumber, pathId);
+    }
+  else if (pathId == 0 and m_txBuffer->GetNumFrameStream0InBuffer () > 0)
     {
+      // stream 0 only goes on path 0, which pacing may hold back while
+      // another path sends
       p = m_txBuffer->NextStream0Sequence (packetNumber);
       NS_ABORT_MSG_IF (p == 0, "No packet for stream 0 in the buffer!");
     }
   else
     {
       NS_LOG_LOGIC (this << " SendDataPacket - sending packet " << packetNumber.GetValue () << " of size " << maxSize << " at time " << Simulator::Now ().GetSeconds ());
-      m_idleTimeoutEvent = Simulator::Schedule (m_idleTimeout, &QuicSocketBase::Close, this);
       p = m_txBuffer->NextSequence (maxSize, packetNumber, pathId);
     }
 
   uint32_t sz = p->GetSize ();
 
   // check whether the connection is appLimited, i.e. not enough data to fill a packet
-  if (sz < maxSize and m_txBuffer->AppSize () == 0 and m_subflows[pathId]->m_tcb->m_bytesInFlight.Get () < m_subflows[pathId]->m_tcb->m_cWnd)
+  if (sz < maxSize and m_txBuffer->AppSize () == 0 and BytesInFlight (pathId) < m_subflows[pathId]->m_tcb->m_cWnd)
     {
       NS_LOG_LOGIC ("Connection is Application-Limited. sz = " << sz << " < maxSize = " << maxSize);
       m_subflows[pathId]->m_tcb->m_appLimitedUntil = m_subflows[pathId]->m_tcb->m_delivered + m_subflows[pathId]->m_tcb->m_bytesInFlight.Get () ? : 1U;
@@ -1305,26 +1378,23 @@ QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize,
   if (m_subflows[pathId]->m_tcb->m_pacing)
     {
       NS_LOG_DEBUG ("Pacing is enabled");
-      if (m_pacingTimer.IsExpired ())
-        {
-          NS_LOG_DEBUG ("Current Pacing Rate " << m_subflows[pathId]->m_tcb->m_pacingRate);
-          NS_LOG_DEBUG ("Pacing Timer is in expired state, activate it. Expires in " <<
-                        m_subflows[pathId]->m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
-          m_pacingTimer.Schedule (m_subflows[pathId]->m_tcb->m_pacingRate.Get ().CalculateBytesTxTime (sz));
-        }
-      else
-        {
-          NS_LOG_INFO ("Pacing Timer is already in running state");
-        }
+      ConsumePacingTokens (pathId, sz);
     }
 
   bool isAckOnly = ((sz == 0) & (withAck));
 
 
-  if (withAck && !m_subflows[pathId]->m_receivedPacketNumbers.empty ())
+  if (withAck && !m_subflows[pathId]->m_receivedPacketNumbers.IsEmpty ())
     {
+      // p is still referenced by the sent list, which accounts for its size
+      p = p->Copy ();
       p->AddAtEnd (OnSendingAckFrame (pathId));
 
+      // The ACK rides on this packet, a pending standalone ACK is not needed anymore
+      m_subflows[pathId]->m_delAckTimer.Cancel ();
+      m_subflows[pathId]->m_sendAckTimer.Cancel ();
+      m_subflows[pathId]->m_queue_ack = false;
+      m_subflows[pathId]->m_numPacketsReceivedSinceLastAckSent = 0;
     }
 
 
@@ -1370,12 +1440,19 @@ QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize,
   
 
   head.SetPathId(pathId);
-  // m_subflows[pathId]->Add(packetNumber);
-  m_quicl4->SendPacket (this, p, head);
+  m_txBatch.push_back (std::make_pair (p, head));
+  if (m_txBatch.size () >= m_txBatchSize)
+    {
+      FlushTxBatch ();
+    }
   m_txTrace (p, head, this);
-  NotifyDataSent (sz);
+  if (!duplicate)
+    {
+      NotifyDataSent (sz);
+    }
 
   m_txBuffer->UpdatePacketSent (packetNumber, sz, pathId, m_subflows[pathId]->m_tcb);
+  QUIC_TRACE (PACKET_SENT, pathId, packetNumber.GetValue (), sz, m_txBuffer->BytesInFlight (pathId));
   // DynamicCast<MpQuicCongestionOps> (m_congestionControl)->OnPacketSent (m_subflows[pathId]->m_tcb, packetNumber, isAckOnly);
 
   if (!m_quicCongestionControlLegacy)
@@ -1391,6 +1468,78 @@ QuicSocketBase::SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize,
   return sz;
 }
 
+void
+QuicSocketBase::FlushTxBatch (void)
+{
+  NS_LOG_FUNCTION (this << m_txBatch.size ());
+
+  if (!m_txBatch.empty ())
+    {
+      m_quicl4->SendPackets (this, m_txBatch);
+      m_txBatch.clear ();
+    }
+}
+
+void
+QuicSocketBase::AdjustRcvWindow (uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << bytes);
+  if (!m_rcvBufAutoTuning)
+    {
+      return;
+    }
+
+  // The receiver of a transfer only samples the RTT of its window updates
+  Time rtt = Seconds (0);
+  for (Ptr<MpQuicSubFlow> sflow : m_subflows)
+    {
+      if (m_enableMultipath and sflow->m_subflowState != MpQuicSubFlow::Active)
+        {
+          continue;
+        }
+      Time pathRtt = sflow->m_tcb->m_smoothedRtt.IsZero () ? sflow->m_controlRtt : sflow->m_tcb->m_smoothedRtt;
+      rtt = std::max (rtt, pathRtt);
+    }
+
+  Time now = Simulator::Now ();
+  m_rcvSpaceBytes += bytes;
+  if (rtt.IsZero () or now - m_rcvSpaceStart < rtt)
+    {
+      return;
+    }
+
+  double perRtt = m_rcvSpaceBytes * rtt.GetSeconds () / (now - m_rcvSpaceStart).GetSeconds ();
+  uint32_t window = std::min<double> (2 * perRtt, m_maxRcvBufSize);
+  if (window > m_rcvWindow)
+    {
+      NS_LOG_INFO ("Receive window grows from " << m_rcvWindow << " to " << window << " bytes, "
+                   << perRtt << " bytes delivered per RTT of " << rtt.GetMilliSeconds () << " ms");
+      m_rcvWindow = window;
+      m_rxBuffer->SetMaxBufferSize (std::max (m_rxBuffer->GetMaxBufferSize (), window));
+      m_quicl5->UpdateRcvWindow (window);
+    }
+  m_rcvSpaceBytes = 0;
+  m_rcvSpaceStart = now;
+}
+
+/**
+ * \brief Double a timeout once per expiry without an acknowledgment
+ *
+ * \param timeout the timeout
+ * \param count the number of expiries
+ * \param maxTimeout the largest timeout
+ * \return the backed off timeout, at most maxTimeout
+ */
+static Time
+BackOff (Time timeout, uint32_t count, Time maxTimeout)
+{
+  for (uint32_t i = 0; i < count and timeout < maxTimeout; i++)
+    {
+      timeout = timeout * 2;
+    }
+  return std::min (timeout, maxTimeout);
+}
+
 void
 QuicSocketBase::SetReTxTimeout (uint8_t pathId)
 {
@@ -1426,7 +1575,8 @@ QuicSocketBase::SetReTxTimeout (uint8_t pathId)
         }
       alarmDuration = std::max (alarmDuration + m_subflows[pathId]->m_tcb->m_maxAckDelay,
                                 m_subflows[pathId]->m_tcb->m_kMinTLPTimeout);
-      alarmDuration = alarmDuration * (2 ^ m_subflows[pathId]->m_tcb->m_handshakeCount);
+      alarmDuration = BackOff (alarmDuration, m_subflows[pathId]->m_tcb->m_handshakeCount,
+                               m_subflows[pathId]->m_tcb->m_kMaxRTOTimeout);
       m_subflows[pathId]->m_tcb->m_alarmType = 0;
     }
   else if (m_subflows[pathId]->m_tcb->m_lossTime != Seconds (0))
@@ -1439,8 +1589,9 @@ QuicSocketBase::SetReTxTimeout (uint8_t pathId)
   else if (m_subflows[pathId]->m_tcb->m_tlpCount < m_subflows[pathId]->m_tcb->m_kMaxTLPs)
     {
       NS_LOG_LOGIC ("m_subflows[pathId]->m_tcb->m_tlpCount < m_subflows[pathId]->m_tcb->m_kMaxTLPs");
-      // Tail Loss Probe
-      alarmDuration = std::max ((3 / 2) * m_subflows[pathId]->m_tcb->m_smoothedRtt + m_subflows[pathId]->m_tcb->m_maxAckDelay,
+      // Tail Loss Probe, after 1.5 SRTT (scaled as a Time, as the integer
+      // 3 / 2 would be 1)
+      alarmDuration = std::max (m_subflows[pathId]->m_tcb->m_smoothedRtt * 3 / 2 + m_subflows[pathId]->m_tcb->m_maxAckDelay,
                                 m_subflows[pathId]->m_tcb->m_kMinTLPTimeout);
       m_subflows[pathId]->m_tcb->m_alarmType = 2;
     }
@@ -1450,13 +1601,14 @@ QuicSocketBase::SetReTxTimeout (uint8_t pathId)
       alarmDuration = m_subflows[pathId]->m_tcb->m_smoothedRtt + 4 * m_subflows[pathId]->m_tcb->m_rttVar
                     + m_subflows[pathId]->m_tcb->m_maxAckDelay;
       alarmDuration = std::max (alarmDuration, m_subflows[pathId]->m_tcb->m_kMinRTOTimeout);
-      alarmDuration = alarmDuration * (2 ^ m_subflows[pathId]->m_tcb->m_rtoCount);
+      alarmDuration = BackOff (alarmDuration, m_subflows[pathId]->m_tcb->m_rtoCount,
+                               m_subflows[pathId]->m_tcb->m_kMaxRTOTimeout);
       m_subflows[pathId]->m_tcb->m_alarmType = 3;
     }
   NS_LOG_INFO ("Schedule ReTxTimeout at time " << Simulator::Now ().GetSeconds () << " to expire at time " << (Simulator::Now () + alarmDuration).GetSeconds ());
   NS_LOG_INFO ("Alarm after " << alarmDuration.GetSeconds () << " seconds");
   // pass pathId to &QuicSocketBase::ReTxTimeout
-  m_subflows[pathId]->m_tcb->m_lossDetectionAlarm = Simulator::Schedule (alarmDuration, &QuicSocketBase::ReTxTimeout, this, pathId);
+  m_subflows[pathId]->m_tcb->m_lossDetectionAlarm.Schedule (alarmDuration);
   m_subflows[pathId]->m_tcb->m_nextAlarmTrigger = Simulator::Now () + alarmDuration;
 }
 
@@ -1464,6 +1616,12 @@ void
 QuicSocketBase::DoRetransmit (std::vector<Ptr<QuicSocketTxItem> > lostPackets, uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
+  if (m_enableMultipath and m_subflows[pathId]->m_subflowState != MpQuicSubFlow::Active)
+    {
+      // The frames in flight on a failed or closed path were already put
+      // back in the application buffer
+      return;
+    }
   // Get packets to retransmit
   SequenceNumber32 next = ++m_subflows[pathId]->m_tcb->m_nextTxSequence;
   uint32_t toRetx = m_txBuffer->Retransmission (next, pathId);
@@ -1478,9 +1636,23 @@ QuicSocketBase::DoRetransmit (std::vector<Ptr<QuicSocketTxItem> > lostPackets, u
                                << " BufferedSize " << m_txBuffer->AppSize ()
                                << " MaxPacketSize " << GetSegSize ());
 
-  // Send the retransmitted data
+  // Send the retransmitted data, one segment at most: the frames of a burst
+  // of losses would not fit in a UDP datagram, and the rest of them is sent
+  // by SendPendingData as the window allows
   NS_LOG_INFO ("Retransmitted packet, next sequence number " << m_subflows[pathId]->m_tcb->m_nextTxSequence);
-  SendDataPacket (next, toRetx, m_connected,pathId);
+  SendDataPacket (next, std::min (toRetx, GetSegSize ()), m_connected,pathId);
+
+  // Reinject the frames on a faster path too, so that they do not hold back
+  // the data already delivered in order
+  uint8_t reinjectionPathId = m_enableMultipath ? m_reinjection->GetReinjectionPath (pathId) : pathId;
+  if (toRetx > 0 and reinjectionPathId != pathId)
+    {
+      SequenceNumber32 copyNumber = ++m_subflows[reinjectionPathId]->m_tcb->m_nextTxSequence;
+      NS_LOG_INFO ("Reinject the frames lost on path " << (uint16_t) pathId
+                   << " on path " << (uint16_t) reinjectionPathId << " SN " << copyNumber);
+      SendDataPacket (copyNumber, 0, m_connected, reinjectionPathId, true);
+    }
+  FlushTxBatch ();
 }
 
 void
@@ -1493,6 +1665,12 @@ QuicSocketBase::ReTxTimeout (uint8_t pathId)
     }
   NS_LOG_FUNCTION (this);
   NS_LOG_INFO ("ReTxTimeout Expired at time " << Simulator::Now ().GetSeconds ());
+  if (m_enableMultipath and m_socketState == OPEN
+      and m_subflows[pathId]->m_subflowState != MpQuicSubFlow::Active)
+    {
+      NS_LOG_INFO ("Path " << (uint16_t) pathId << " is not active");
+      return;
+    }
   
   // Handshake packets are outstanding)
   if (m_subflows[pathId]->m_tcb->m_alarmType == 0 && (m_socketState == CONNECTING_CLT || m_socketState == CONNECTING_SVR))
@@ -1521,6 +1699,12 @@ QuicSocketBase::ReTxTimeout (uint8_t pathId)
                 m_subflows[pathId]->m_tcb, BytesInFlight (pathId));
             }
         }
+      else if (m_enableMultipath && m_ccType != QuicNewReno)
+        {
+          DynamicCast<MpQuicCongestionOps> (m_congestionControl)->OnPacketsLost (
+            m_subflows[pathId]->m_tcb, lostPackets, pathId, m_coupledState);
+          UpdateCoupledState (pathId);
+        }
       else
         {
           Ptr<QuicCongestionOps> cc = dynamic_cast<QuicCongestionOps*> (&(*m_congestionControl));
@@ -1537,9 +1721,10 @@ QuicSocketBase::ReTxTimeout (uint8_t pathId)
       NS_LOG_INFO ("TLP triggered");
       uint32_t s = std::min (ConnectionWindow (pathId), GetSegSize ());
       // cancel pacing to send packet immediately
-      m_pacingTimer.Cancel ();
+      m_subflows[pathId]->m_pacingTimer.Cancel ();
 
       SendDataPacket (next, s, m_connected,pathId);
+      FlushTxBatch ();
       m_subflows[pathId]->m_tcb->m_tlpCount++;
     }
   else if (m_subflows[pathId]->m_tcb->m_alarmType == 3)
@@ -1555,7 +1740,7 @@ QuicSocketBase::ReTxTimeout (uint8_t pathId)
       uint32_t s = std::min (AvailableWindow (pathId), GetSegSize ());
 
       // cancel pacing to send packet immediately
-      m_pacingTimer.Cancel ();
+      m_subflows[pathId]->m_pacingTimer.Cancel ();
 
       SendDataPacket (next, s, m_connected,pathId);
       next = ++m_subflows[pathId]->m_tcb->m_nextTxSequence;
@@ -1563,11 +1748,19 @@ QuicSocketBase::ReTxTimeout (uint8_t pathId)
       s = std::min (AvailableWindow (pathId), GetSegSize ());
 
       // cancel pacing, again
-      m_pacingTimer.Cancel ();
+      m_subflows[pathId]->m_pacingTimer.Cancel ();
 
       SendDataPacket (next, s, m_connected,pathId);
+      FlushTxBatch ();
 
       m_subflows[pathId]->m_tcb->m_rtoCount++;
+
+      // The frames still in flight on the path may be sent on another one
+      if (m_enableMultipath && m_reinjection->GetPolicy () != MpQuicReinjection::SAME_PATH)
+        {
+          m_reinjection->OnRetransmissionTimeout (pathId);
+          SendPendingData (m_connected);
+        }
     } 
 }
 
@@ -1688,10 +1881,11 @@ QuicSocketBase::Close (void)
   // std::cout << this << " Close at time " << Simulator::Now ().GetSeconds ()<<std::endl;
   m_receivedTransportParameters = false;
 
-  if (m_idleTimeoutEvent.IsRunning () and m_socketState != IDLE
+  if (m_idleTimeoutTimer.IsRunning () and m_socketState != IDLE
       and m_socketState != CLOSING)   //Connection Close from application signal
     {
-      if(!m_txBuffer->SentListIsEmpty()) {
+      // the streams may still hold data back until the peer gives credit
+      if(!m_txBuffer->SentListIsEmpty() or m_quicl5->GetStreamsTxBufferedSize () > 0) {
         m_appCloseSentListNoEmpty = true;
       } else {
         m_appCloseSentListNoEmpty = false;
@@ -1706,7 +1900,7 @@ QuicSocketBase::Close (void)
           }
       } 
     }
-  else if (m_idleTimeoutEvent.IsExpired () and m_socketState != CLOSING
+  else if (m_idleTimeoutTimer.IsExpired () and m_socketState != CLOSING
            and m_socketState != IDLE and m_socketState != LISTENING) //Connection Close due to Idle Period termination
     {
       SetState (CLOSING);
@@ -1717,14 +1911,14 @@ QuicSocketBase::Close (void)
                                                    &QuicSocketBase::DoClose,
                                                    this);
     }
-  else if (m_idleTimeoutEvent.IsExpired ()
+  else if (m_idleTimeoutTimer.IsExpired ()
            and m_drainingPeriodEvent.IsExpired () and m_socketState != CLOSING
            and m_socketState != IDLE) //close last listening sockets
     {
       NS_LOG_LOGIC (this << " Closing listening socket");
       DoClose ();
     }
-  else if (m_idleTimeoutEvent.IsExpired ()
+  else if (m_idleTimeoutTimer.IsExpired ()
            and m_drainingPeriodEvent.IsExpired () and m_socketState == IDLE)
     {
       NS_LOG_LOGIC (this << " Has already been closed");
@@ -1881,6 +2075,7 @@ QuicSocketBase::AppendingRx (Ptr<Packet> frame, Address &address)
     }
   else
     {
+      AdjustRcvWindow (frame->GetSize ());
       NS_LOG_INFO ("Notify Data Recv");
       NotifyDataRecv ();   // trigger the application method
     }
@@ -2113,7 +2308,17 @@ QuicSocketBase::OnReceivedFrame (QuicSubheader &sub)
         // set the maximum amount of data that can be sent
         // on this connection
         NS_LOG_INFO ("Received MAX_DATA frame");
-        SetConnectionMaxData (sub.GetMaxData ());
+        if (!m_rcvBufAutoTuning)
+          {
+            SetConnectionMaxData (sub.GetMaxData ());
+          }
+        else if (sub.GetMaxData () > m_peerMaxData)
+          {
+            // an offset, which frames reordered across the paths must not move back
+            m_peerMaxData = sub.GetMaxData ();
+            SetConnectionMaxData (sub.GetMaxData ());
+            m_quicl5->ResumeStreams ();
+          }
         break;
 
       case QuicSubheader::MAX_STREAM_ID:
@@ -2163,9 +2368,13 @@ QuicSocketBase::OnReceivedFrame (QuicSubheader &sub)
         break;
 
       case QuicSubheader::REMOVE_ADDRESS:
-        // TODO check if it matches what was sent in a PATH_CHALLENGE
-        // otherwise abort with a UNSOLICITED_PATH_RESPONSE error
         NS_LOG_INFO ("Received REMOVE_ADDRESS frame");
+        m_pathManager->ClosePath (sub.GetPathId ());
+        break;
+
+      case QuicSubheader::PATH_ABANDON:
+        NS_LOG_INFO ("Received PATH_ABANDON frame");
+        m_pathManager->ClosePath (sub.GetPathId ());
         break;
 
       case QuicSubheader::MP_ACK:
@@ -2189,44 +2398,21 @@ QuicSocketBase::OnSendingAckFrame (uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
 
-  NS_ABORT_MSG_IF (m_subflows[pathId]->m_receivedPacketNumbers.empty (),
+  NS_ABORT_MSG_IF (m_subflows[pathId]->m_receivedPacketNumbers.IsEmpty (),
                    " Sending Ack Frame without packets to acknowledge");
 
 
   NS_LOG_INFO ("Attach an ACK frame to the packet");
 
-  std::sort (m_subflows[pathId]->m_receivedPacketNumbers.begin (), m_subflows[pathId]->m_receivedPacketNumbers.end (),
-             std::greater<SequenceNumber32> ());
+  SequenceNumber32 largestAcknowledged = m_subflows[pathId]->m_receivedPacketNumbers.GetLargest ();
 
-  SequenceNumber32 largestAcknowledged = *(m_subflows[pathId]->m_receivedPacketNumbers.begin ());
+  // Limit the number of gaps that are sent in an ACK (older packets have already been retransmitted)
+  QuicAckBlocks additionalAckBlocks;
+  QuicAckBlocks gaps;
+  m_subflows[pathId]->m_receivedPacketNumbers.GetAckBlocks (gaps, additionalAckBlocks, m_maxTrackedGaps);
 
-  uint32_t ackBlockCount = 0;
-  std::vector<uint32_t> additionalAckBlocks;
-  std::vector<uint32_t> gaps;
-
-  std::vector<SequenceNumber32>::const_iterator curr_rec_it =
-    m_subflows[pathId]->m_receivedPacketNumbers.begin ();
-  std::vector<SequenceNumber32>::const_iterator next_rec_it =
-    m_subflows[pathId]->m_receivedPacketNumbers.begin () + 1;
-
-  for (; next_rec_it != m_subflows[pathId]->m_receivedPacketNumbers.end ();
-       ++curr_rec_it, ++next_rec_it)
-    {
-
-      if (((*curr_rec_it) - (*next_rec_it) - 1 > 0)
-          and ((*curr_rec_it) != (*next_rec_it)))
-        {
-          //std::clog << "curr " << (*curr_rec_it) << " next " << (*next_rec_it) << " ";
-          additionalAckBlocks.push_back ((*next_rec_it).GetValue ());
-          gaps.push_back ((*curr_rec_it).GetValue () - 1);
-          ackBlockCount++;
-        }
-      // Limit the number of gaps that are sent in an ACK (older packets have already been retransmitted)
-      if (ackBlockCount >= m_maxTrackedGaps)
-        {
-          break;
-        }
-    }
+  // The last block acknowledges everything below it, older ranges need not be kept apart
+  m_subflows[pathId]->m_receivedPacketNumbers.Prune (m_maxTrackedGaps + 1);
 
 
   Time delay = Simulator::Now () - m_lastReceived;
@@ -2239,7 +2425,18 @@ QuicSocketBase::OnSendingAckFrame (uint8_t pathId)
   
   ackFrame->AddHeader (sub);
 
-  if (m_subflows[pathId]->m_lastMaxData < m_subflows[pathId]->m_maxDataInterval)
+  if (m_rcvBufAutoTuning)
+    {
+      // Advertise the connection limit again only once it moved by half a
+      // window, on the ACKs of each path so that every path gets RTT samples
+      uint64_t maxData = m_quicl5->GetMaxData ();
+      if (maxData >= m_subflows[pathId]->m_advertisedMaxData + m_rcvWindow / 2)
+        {
+          ackFrame->AddHeader (QuicSubheader::CreateMaxData (maxData));
+          m_subflows[pathId]->m_advertisedMaxData = maxData;
+        }
+    }
+  else if (m_subflows[pathId]->m_lastMaxData < m_subflows[pathId]->m_maxDataInterval)
     {
       m_subflows[pathId]->m_lastMaxData++;
     }
@@ -2263,7 +2460,7 @@ QuicSocketBase::OnReceivedAckFrame (QuicSubheader &sub)
   uint8_t pathId = sub.GetPathId();
 
    // Generate RateSample
-  struct RateSample * rs = m_txBuffer->GetRateSample ();
+  struct RateSample * rs = m_txBuffer->GetRateSample (pathId);
   rs->m_priorInFlight = m_subflows[pathId]->m_tcb->m_bytesInFlight.Get ();
 
   uint32_t lostOut = m_txBuffer->GetLost (pathId);
@@ -2271,8 +2468,8 @@ QuicSocketBase::OnReceivedAckFrame (QuicSubheader &sub)
 
   uint32_t previousWindow = m_txBuffer->BytesInFlight (pathId);
 
-  std::vector<uint32_t> additionalAckBlocks = sub.GetAdditionalAckBlocks ();
-  std::vector<uint32_t> gaps = sub.GetGaps ();
+  const QuicAckBlocks &additionalAckBlocks = sub.GetAdditionalAckBlocks ();
+  const QuicAckBlocks &gaps = sub.GetGaps ();
   uint32_t largestAcknowledged = sub.GetLargestAcknowledged ();
   m_subflows[pathId]->m_tcb->m_lastAckedSeq = largestAcknowledged;
   uint32_t ackBlockCount = sub.GetAckBlockCount ();
@@ -2290,8 +2487,22 @@ QuicSocketBase::OnReceivedAckFrame (QuicSubheader &sub)
 
   // Count newly acked bytes
   uint32_t ackedBytes = previousWindow - m_txBuffer->BytesInFlight (pathId);
+  if (!m_subflows[pathId]->m_windowUpdateSent.IsZero ()
+      and largestAcknowledged >= m_subflows[pathId]->m_windowUpdatePacket.GetValue ())
+    {
+      // The standalone ACKs of a receiver are not kept in the TX buffer, and
+      // the paths it sends no data on get their only RTT samples from the
+      // window updates carried by these ACKs
+      m_subflows[pathId]->m_controlRtt = Simulator::Now () - m_subflows[pathId]->m_windowUpdateSent
+        - MicroSeconds (sub.GetAckDelay ());
+      m_subflows[pathId]->m_windowUpdateSent = Seconds (0);
+    }
+  QUIC_TRACE (ACK_RECEIVED, pathId, largestAcknowledged, ackedBytes, m_txBuffer->BytesInFlight (pathId));
 
-  m_txBuffer->GenerateRateSample (m_subflows[pathId]->m_tcb);
+  if (m_txBuffer->GenerateRateSample (pathId, m_subflows[pathId]->m_tcb))
+    {
+      m_subflows[pathId]->m_deliveryRate = rs->m_deliveryRate;
+    }
   rs->m_packetLoss = std::abs ((int) lostOut - (int) m_txBuffer->GetLost (pathId));
   m_subflows[pathId]->m_tcb->m_lastAckedSackedBytes = m_subflows[pathId]->m_tcb->m_delivered - delivered;
   // RTO packet acknowledged - IETF Draft QUIC Recovery, Sec. 4.3.3
@@ -2357,6 +2568,12 @@ QuicSocketBase::OnReceivedAckFrame (QuicSubheader &sub)
             }
           NS_ASSERT (m_subflows[pathId]->m_tcb->m_congState == TcpSocketState::CA_RECOVERY);
         }
+      else if (m_enableMultipath && m_ccType != QuicNewReno)
+        {
+          DynamicCast<MpQuicCongestionOps> (m_congestionControl)->OnPacketsLost (
+            m_subflows[pathId]->m_tcb, lostPackets, pathId, m_coupledState);
+          UpdateCoupledState (pathId);
+        }
       else
         {
           DynamicCast<QuicCongestionOps> (m_congestionControl)->OnPacketsLost (
@@ -2372,18 +2589,11 @@ QuicSocketBase::OnReceivedAckFrame (QuicSubheader &sub)
         {
           NS_LOG_INFO ("Update the variables in the congestion control (QUIC)");
           // Process the ACK
-          if(m_enableMultipath && m_ccType == OLIA)
+          if(m_enableMultipath && m_ccType != QuicNewReno)
           {
             m_subflows[pathId]->m_tcb->m_bytesBeforeLost2 += ackedBytes;
-            double alpha = GetOliaAlpha(pathId);
-            double sum_rate = 0;
-            for (uint16_t pid = 0; pid < m_subflows.size(); pid++)
-            {
-              sum_rate += m_subflows[pid]->GetRate();
-            }
-            // DynamicCast<QuicCongestionOps> (m_congestionControl)->OnAckReceived (m_subflows[pathId]->m_tcb, sub, ackedPackets, rs);
-
-            DynamicCast<MpQuicCongestionOps> (m_congestionControl)->OnAckReceived (m_subflows[pathId]->m_tcb, sub, ackedPackets, rs, alpha, sum_rate);
+            DynamicCast<MpQuicCongestionOps> (m_congestionControl)->OnAckReceived (m_subflows[pathId]->m_tcb, sub, ackedPackets, rs, pathId, m_coupledState);
+            UpdateCoupledState (pathId);
           }
           else
           {
@@ -2462,9 +2672,12 @@ QuicSocketBase::OnSendingTransportParameters ()
 {
   NS_LOG_FUNCTION (this);
 
+  // With autotuning, the peer may send one receive window ahead at first
+  uint32_t maxStreamData = m_rcvBufAutoTuning ? std::min (m_initial_max_stream_data, m_rcvWindow.Get ())
+    : m_initial_max_stream_data;
   QuicTransportParameters transportParameters;
   transportParameters = transportParameters.CreateTransportParameters (
-    m_initial_max_stream_data, m_max_data, m_initial_max_stream_id_bidi,
+    maxStreamData, m_max_data, m_initial_max_stream_id_bidi,
     (uint16_t) m_idleTimeout.Get ().GetSeconds (),
     (uint8_t) m_omit_connection_id, m_subflows[0]->m_tcb->m_segmentSize,
     m_ack_delay_exponent, m_initial_max_stream_id_uni);
@@ -2657,10 +2870,10 @@ QuicSocketBase::ReceivedData (Ptr<Packet> p, const QuicHeader& quicHeader,
   NS_LOG_INFO ("Received packet of size " << p->GetSize ());
   if (!m_drainingPeriodEvent.IsRunning ())
     {
-      m_idleTimeoutEvent.Cancel ();   // reset the IDLE timeout
+      // reset the IDLE timeout
       NS_LOG_LOGIC (
         this << " ReceivedData Schedule Close at time " << Simulator::Now ().GetSeconds () << " to expire at time " << (Simulator::Now () + m_idleTimeout.Get ()).GetSeconds ());
-      m_idleTimeoutEvent = Simulator::Schedule (m_idleTimeout, &QuicSocketBase::Close, this);
+      m_idleTimeoutTimer.Schedule (m_idleTimeout);
     }
   else   // If the socket is in Draining Period, discard the packets
     {
@@ -2683,7 +2896,7 @@ QuicSocketBase::ReceivedData (Ptr<Packet> p, const QuicHeader& quicHeader,
       m_couldContainTransportParameters = true;
 
       onlyAckFrames = m_quicl5->DispatchRecv (p, address);
-      m_subflows[pathId]->m_receivedPacketNumbers.push_back (quicHeader.GetPacketNumber ());
+      m_subflows[pathId]->m_receivedPacketNumbers.Add (quicHeader.GetPacketNumber ());
 
       m_connected = true;
       m_keyPhase == QuicHeader::PHASE_ONE ? m_keyPhase =
@@ -2717,7 +2930,7 @@ QuicSocketBase::ReceivedData (Ptr<Packet> p, const QuicHeader& quicHeader,
         }
 
       onlyAckFrames = m_quicl5->DispatchRecv (p, address);
-      m_subflows[pathId]->m_receivedPacketNumbers.push_back (quicHeader.GetPacketNumber ());
+      m_subflows[pathId]->m_receivedPacketNumbers.Add (quicHeader.GetPacketNumber ());
 
       if (IsVersionSupported (quicHeader.GetVersion ()))
         {
@@ -2739,7 +2952,7 @@ QuicSocketBase::ReceivedData (Ptr<Packet> p, const QuicHeader& quicHeader,
       NS_LOG_INFO ("Client receives HANDSHAKE");
 
       onlyAckFrames = m_quicl5->DispatchRecv (p, address);
-      m_subflows[pathId]->m_receivedPacketNumbers.push_back (quicHeader.GetPacketNumber ());
+      m_subflows[pathId]->m_receivedPacketNumbers.Add (quicHeader.GetPacketNumber ());
 
       SetState (OPEN);
       Simulator::ScheduleNow(&QuicSocketBase::ConnectionSucceeded, this);
@@ -2759,7 +2972,7 @@ QuicSocketBase::ReceivedData (Ptr<Packet> p, const QuicHeader& quicHeader,
       CreateNewSubflows();
 
       onlyAckFrames = m_quicl5->DispatchRecv (p, address);
-      m_subflows[pathId]->m_receivedPacketNumbers.push_back (quicHeader.GetPacketNumber ());
+      m_subflows[pathId]->m_receivedPacketNumbers.Add (quicHeader.GetPacketNumber ());
       SetState (OPEN);
       Simulator::ScheduleNow (&QuicSocketBase::ConnectionSucceeded, this);
       m_congestionControl->CongestionStateSet (m_subflows[pathId]->m_tcb,TcpSocketState::CA_OPEN);
@@ -2821,7 +3034,11 @@ QuicSocketBase::ReceivedData (Ptr<Packet> p, const QuicHeader& quicHeader,
       // in this case we cannot explicitely ACK it!
       // check if delayed ACK is used
       
-      m_subflows[pathId]->m_receivedPacketNumbers.push_back (quicHeader.GetPacketNumber ());
+      m_subflows[pathId]->m_receivedPacketNumbers.Add (quicHeader.GetPacketNumber ());
+      if (m_enableMultipath)
+        {
+          m_pathManager->OnPacketReceived (pathId);
+        }
       onlyAckFrames = m_quicl5->DispatchRecv (p, address);
 
     }
@@ -2852,6 +3069,18 @@ QuicSocketBase::GetInitialMaxStreamData () const
   return m_initial_max_stream_data;
 }
 
+bool
+QuicSocketBase::GetRcvBufAutoTuning () const
+{
+  return m_rcvBufAutoTuning;
+}
+
+uint32_t
+QuicSocketBase::GetRcvWindow () const
+{
+  return m_rcvWindow;
+}
+
 uint32_t
 QuicSocketBase::GetConnectionMaxData () const
 {
@@ -2887,6 +3116,15 @@ QuicSocketBase::SetState (TracedValue<QuicStates_t> newstate)
     }
 
   m_socketState = newstate;
+
+  if (m_enableMultipath and newstate == OPEN)
+    {
+      m_pathManager->StartProbing ();
+    }
+  else if (newstate == CLOSING or newstate == IDLE)
+    {
+      m_pathManager->StopProbing ();
+    }
 }
 
 bool
@@ -2982,28 +3220,10 @@ QuicSocketBase::GetReceivedTransportParametersFlag () const
 }
 
 bool
-QuicSocketBase::CheckIfPacketOverflowMaxDataLimit (
-  std::vector<std::pair<Ptr<Packet>, QuicSubheader> > disgregated)
+QuicSocketBase::CheckIfPacketOverflowMaxDataLimit (uint32_t streamBytes)
 {
-  NS_LOG_FUNCTION (this);
-  uint32_t validPacketSize = 0;
-  for (auto frame_recv_it = disgregated.begin ();
-       frame_recv_it != disgregated.end () and !disgregated.empty ();
-       ++frame_recv_it)
-    {
-      QuicSubheader sub = (*frame_recv_it).second;
-      // (*frame_recv_it)->PeekHeader (sub);
-
-      if (sub.IsStream () and sub.GetStreamId () != 0)
-        {
-          validPacketSize += (*frame_recv_it).first->GetSize ();
-        }
-    }
-  if ((m_max_data < m_rxBuffer->Size () + validPacketSize))
-    {
-      return true;
-    }
-  return false;
+  NS_LOG_FUNCTION (this << streamBytes);
+  return m_max_data < m_rxBuffer->Size () + streamBytes;
 }
 
 uint32_t
@@ -3068,6 +3288,7 @@ QuicSocketBase::SetSocketRcvBufSize (uint32_t size)
   NS_LOG_FUNCTION (this << size);
   m_socketRxBufferSize = size;
   m_rxBuffer->SetMaxBufferSize (size);
+  m_rcvWindow = size;
 }
 
 uint32_t
@@ -3189,6 +3410,37 @@ QuicSocketBase::NotifyPacingPerformed (void)
   SendPendingData (m_connected);
 }
 
+bool
+QuicSocketBase::IsPacingBlocked (uint8_t pathId) const
+{
+  return m_subflows[pathId]->m_tcb->m_pacing && m_subflows[pathId]->m_pacingTimer.IsRunning ();
+}
+
+void
+QuicSocketBase::ConsumePacingTokens (uint8_t pathId, uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId << bytes);
+  Ptr<MpQuicSubFlow> subflow = m_subflows[pathId];
+  DataRate rate = subflow->m_tcb->m_pacingRate.Get ();
+  int64_t segSize = subflow->m_tcb->m_segmentSize;
+  int64_t burst = segSize * m_pacingBurst;
+
+  // refill the tokens accrued since the last packet, up to a full burst
+  Time now = Simulator::Now ();
+  double accrued = (now - subflow->m_pacingLastRefill).GetSeconds () * rate.GetBitRate () / 8;
+  subflow->m_pacingTokens = std::min (burst, subflow->m_pacingTokens + static_cast<int64_t> (std::min (accrued, double (burst))));
+  subflow->m_pacingLastRefill = now;
+
+  subflow->m_pacingTokens -= bytes;
+  if (subflow->m_pacingTokens < segSize && !subflow->m_pacingTimer.IsRunning ())
+    {
+      Time refill = rate.CalculateBytesTxTime (burst - subflow->m_pacingTokens);
+      NS_LOG_DEBUG ("Path " << (uint16_t) pathId << " out of pacing tokens at rate " << rate <<
+                    ", next burst in " << refill);
+      subflow->m_pacingTimer.Schedule (refill);
+    }
+}
+
 
 
 void
@@ -3199,6 +3451,14 @@ QuicSocketBase::CreateScheduler ()
   m_scheduler->SetSocket(this);
 }
 
+void
+QuicSocketBase::CreateReinjection ()
+{
+  NS_LOG_FUNCTION (this);
+  m_reinjection = CreateObject<MpQuicReinjection> ();
+  m_reinjection->SetSocket (this);
+}
+
 void
 QuicSocketBase::CreatePathManager()
 {
@@ -3208,15 +3468,20 @@ QuicSocketBase::CreatePathManager()
 }
 
 void 
-QuicSocketBase::CreateNewSubflows ()
+QuicSocketBase::CreateNewSubflows (bool upOnly)
 {
   NS_LOG_FUNCTION (this);
   int16_t addrNum = m_node->GetObject<Ipv4>()->GetNInterfaces();
-  if (m_enableMultipath && addrNum > 2)
+  int16_t first = m_subflows.size () + 1;
+  if (m_enableMultipath && addrNum > first)
   {
     m_quicl4->Allow0RTTHandshake(true);
-    for(int16_t num = 2; num < addrNum; num++)
+    for(int16_t num = first; num < addrNum; num++)
     {
+      if (upOnly and !m_node->GetObject<Ipv4>()->IsUp(num))
+        {
+          break;
+        }
       Ptr<MpQuicSubFlow> subflow = m_pathManager->AddSubflow(InetSocketAddress(m_node->GetObject<Ipv4>()->GetAddress(num,0).GetLocal(), m_endPoint->GetLocalPort()+num-1), m_currentFromAddress, num-1);
     }
   }
@@ -3227,7 +3492,28 @@ void
 QuicSocketBase::SubflowInsert(Ptr<MpQuicSubFlow> sflow)
 {
   NS_LOG_FUNCTION (this);
+  sflow->m_pacingTimer.SetFunction (&QuicSocketBase::NotifyPacingPerformed, this);
+  SetSubflowTimers (sflow);
+  sflow->m_subflowState.ConnectWithoutContext (MakeCallback (&QuicSocketBase::SubflowStateChanged, this));
   m_subflows.insert(m_subflows.end(), sflow);
+  m_activeSubflowsChanged = true;
+}
+
+void
+QuicSocketBase::SetSubflowTimers (Ptr<MpQuicSubFlow> sflow)
+{
+  NS_LOG_FUNCTION (this);
+  uint8_t pathId = sflow->m_flowId;
+  QuicTimerWheel *wheel = m_enableTimerWheel ? &m_timerWheel : 0;
+  sflow->m_sendAckTimer.SetWheel (wheel);
+  sflow->m_delAckTimer.SetWheel (wheel);
+  sflow->m_tcb->m_lossDetectionAlarm.SetWheel (wheel);
+  sflow->m_sendAckTimer.SetFunction (&QuicSocketBase::SendAck, this);
+  sflow->m_sendAckTimer.SetArguments (pathId);
+  sflow->m_delAckTimer.SetFunction (&QuicSocketBase::SendAck, this);
+  sflow->m_delAckTimer.SetArguments (pathId);
+  sflow->m_tcb->m_lossDetectionAlarm.SetFunction (&QuicSocketBase::ReTxTimeout, this);
+  sflow->m_tcb->m_lossDetectionAlarm.SetArguments (pathId);
 }
 
 void
@@ -3238,7 +3524,7 @@ QuicSocketBase::AddPath(Address address, Address from, uint8_t pathId)
 }
 
 void
-QuicSocketBase::SendAddAddress(Address address, uint8_t pathId)
+QuicSocketBase::SendAddAddress(Address address, uint8_t pathId, uint8_t onPathId)
 {
   NS_LOG_FUNCTION (this);
   QuicSubheader sub = QuicSubheader::CreateAddAddress (address, pathId);
@@ -3246,16 +3532,46 @@ QuicSocketBase::SendAddAddress(Address address, uint8_t pathId)
   frame->AddHeader (sub);
   Ptr<Packet> p = Create<Packet> ();
   p->AddAtEnd(frame);
-  SequenceNumber32 packetNumber = ++m_subflows[0]->m_tcb->m_nextTxSequence;
+  SequenceNumber32 packetNumber = ++m_subflows[onPathId]->m_tcb->m_nextTxSequence;
   QuicHeader head;
   head = QuicHeader::CreateShort (m_connectionId, packetNumber,!m_omit_connection_id, m_keyPhase);
-  head.SetPathId(0);
+  head.SetPathId(onPathId);
   NS_LOG_INFO ("Send ADD_ADDRESS packet with header " << head);
   // m_subflows[0]->Add(packetNumber);
   m_quicl4->SendPacket (this, p, head);
 
 }
 
+void
+QuicSocketBase::SendRemoveAddress (Address address, uint8_t pathId, uint8_t onPathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId << (uint16_t) onPathId);
+  QuicSubheader sub = QuicSubheader::CreateRemoveAddress (address, pathId);
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (sub);
+  SequenceNumber32 packetNumber = ++m_subflows[onPathId]->m_tcb->m_nextTxSequence;
+  QuicHeader head;
+  head = QuicHeader::CreateShort (m_connectionId, packetNumber,!m_omit_connection_id, m_keyPhase);
+  head.SetPathId(onPathId);
+  NS_LOG_INFO ("Send REMOVE_ADDRESS packet with header " << head);
+  m_quicl4->SendPacket (this, p, head);
+}
+
+void
+QuicSocketBase::SendPathAbandon (uint8_t pathId, uint8_t onPathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId << (uint16_t) onPathId);
+  QuicSubheader sub = QuicSubheader::CreatePathAbandon (pathId, QuicSubheader::NO_ERROR);
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (sub);
+  SequenceNumber32 packetNumber = ++m_subflows[onPathId]->m_tcb->m_nextTxSequence;
+  QuicHeader head;
+  head = QuicHeader::CreateShort (m_connectionId, packetNumber,!m_omit_connection_id, m_keyPhase);
+  head.SetPathId(onPathId);
+  NS_LOG_INFO ("Send PATH_ABANDON packet with header " << head);
+  m_quicl4->SendPacket (this, p, head);
+}
+
 void
 QuicSocketBase::OnReceivedAddAddressFrame (QuicSubheader &sub)
 {
@@ -3268,6 +3584,12 @@ QuicSocketBase::OnReceivedAddAddressFrame (QuicSubheader &sub)
   Address peerAddr = InetSocketAddress(ipv4, port);
   Address localAddr = InetSocketAddress(m_node->GetObject<Ipv4>()->GetAddress(pathId+1,0).GetLocal(), port);
 
+  if (pathId < m_subflows.size ())
+    {
+      // The peer announces again an address it removed
+      m_pathManager->ReopenPath (pathId, peerAddr);
+      return;
+    }
   m_quicl4->AddPath(pathId, this, localAddr, peerAddr);
   m_quicl4->Allow0RTTHandshake(true);
   m_pathManager->AddSubflowWithPeerAddress(localAddr, peerAddr, pathId);
@@ -3297,7 +3619,7 @@ QuicSocketBase::OnReceivedPathChallengeFrame (QuicSubheader &sub)
 {
   NS_LOG_FUNCTION (this);
   m_subflows[m_currentPathId]->m_peerAddr = m_currentFromAddress;
-  m_subflows[m_currentPathId]->m_subflowState = MpQuicSubFlow::Active;
+  m_pathManager->OnPathValidated (m_currentPathId);
   m_quicl4->ReDoUdpConnect(m_currentPathId, m_currentFromAddress);
   m_txBuffer->AddSentList(m_currentPathId);
   SendPathResponse(m_currentPathId);
@@ -3325,67 +3647,84 @@ void
 QuicSocketBase::OnReceivedPathResponseFrame (QuicSubheader &sub)
 {
   NS_LOG_FUNCTION (this);
-  m_subflows[m_currentPathId]->m_subflowState = MpQuicSubFlow::Active;
+  m_pathManager->OnPathValidated (m_currentPathId);
   m_txBuffer->AddSentList(m_currentPathId);
 }
 
 
-std::vector<Ptr<MpQuicSubFlow>>
+const std::vector<Ptr<MpQuicSubFlow>> &
 QuicSocketBase::GetActiveSubflows()
 {
-  NS_LOG_FUNCTION(this);
-  std::vector<Ptr<MpQuicSubFlow>> sflows;
+  if (!m_activeSubflowsChanged)
+    {
+      return m_activeSubflows;
+    }
+
+  m_activeSubflowsChanged = false;
+  m_activeSubflows.clear ();
   for (uint16_t i = 0; i < m_subflows.size(); i++)
   {
     if (m_subflows[i]->m_subflowState == MpQuicSubFlow::Active){
-      sflows.insert(sflows.end(), m_subflows[i]);
+      m_activeSubflows.push_back (m_subflows[i]);
     }
   }
-  return sflows;
+  return m_activeSubflows;
 }
 
-double
-QuicSocketBase::GetOliaAlpha(uint8_t pathId)
+const std::vector<Ptr<MpQuicSubFlow>> &
+QuicSocketBase::GetSubflows (void) const
 {
-  std::vector<uint8_t> B;
-  std::vector<uint8_t> M;
-  uint32_t maxCwnd = 0;
-  double maxr = 0;
-  for (uint8_t i = 0; i < m_subflows.size(); i++)
-  {
-      if (m_subflows[i]->m_tcb->m_cWnd > maxCwnd)
-      {
-        maxCwnd = m_subflows[i]->m_tcb->m_cWnd;
-        M.push_back(i);
-      }
-      double rate = std::max(m_subflows[i]->m_tcb->m_bytesBeforeLost1,m_subflows[i]->m_tcb->m_bytesBeforeLost2)/pow(m_subflows[i]->m_tcb->m_lastRtt.Get().GetSeconds(),2);
-      if (rate > maxr)
-      {
-        maxr = rate;
-        B.push_back(i);
-      }
-  }
-  std::vector<uint8_t> B_M;
-  for (int x: B)
-  {
-    if(std::find(M.begin(), M.end(), x) == M.end()) {
-      B_M.push_back(x);
+  return m_subflows;
+}
+
+void
+QuicSocketBase::ResumeSending (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_socketState != IDLE and !m_sendPendingDataEvent.IsRunning ())
+    {
+      m_sendPendingDataEvent = Simulator::Schedule (TimeStep (1), &QuicSocketBase::SendPendingData,
+                                                    this, m_connected);
     }
-  }
+}
 
-  if(std::find(B_M.begin(), B_M.end(), pathId) != B_M.end())
-  {
-    return 0.5/B_M.size();
-  } 
-  else if(!B_M.empty() && std::find(M.begin(), M.end(), pathId) != M.end())
-  {
-    return -0.5/M.size();
-  }
-  else
-  {
-    return 0;
-  }
+Ptr<QuicSocketTxBuffer>
+QuicSocketBase::GetTxBuffer (void) const
+{
+  return m_txBuffer;
+}
+
+Ptr<MpQuicReinjection>
+QuicSocketBase::GetReinjection (void) const
+{
+  return m_reinjection;
+}
+
+Ptr<MpQuicPathManager>
+QuicSocketBase::GetPathManager (void) const
+{
+  return m_pathManager;
+}
 
+void
+QuicSocketBase::SubflowStateChanged (MpQuicSubFlow::SubflowStates_t oldState, MpQuicSubFlow::SubflowStates_t newState)
+{
+  NS_LOG_FUNCTION (this << oldState << newState);
+  // The trace fires before the new state is stored, so the set is only
+  // rebuilt on the next call to GetActiveSubflows
+  if ((oldState == MpQuicSubFlow::Active) != (newState == MpQuicSubFlow::Active))
+    {
+      m_activeSubflowsChanged = true;
+    }
+}
+
+void
+QuicSocketBase::UpdateCoupledState (uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) pathId);
+  Ptr<QuicSocketState> tcb = m_subflows[pathId]->m_tcb;
+  m_coupledState.UpdatePath (pathId, tcb->m_cWnd, tcb->m_smoothedRtt.GetSeconds (),
+                             std::max (tcb->m_bytesBeforeLost1, tcb->m_bytesBeforeLost2));
 }
 
 uint32_t 
@@ -40,6 +40,8 @@
 #include "quic-header.h"
 #include "quic-subheader.h"
 #include "quic-transport-parameters.h"
+#include "quic-lazy-timer.h"
+#include "quic-timer-wheel.h"
 // #include "ns3/ipv4-end-point.h"
 #include "ns3/tcp-socket-base.h"
 #include "ns3/tcp-congestion-ops.h"
@@ -50,6 +52,8 @@
 #include "mp-quic-path-manager.h"
 #include "mp-quic-subflow.h"
 #include "mp-quic-scheduler.h"
+#include "mp-quic-path-split.h"
+#include "mp-quic-coupled-state.h"
 
 
 namespace ns3 {
@@ -58,6 +62,7 @@ class QuicL5Protocol;
 class QuicL4Protocol;
 class MpQuicPathManager;
 class MpQuicScheduler;
+class MpQuicReinjection;
 
 /**
  * \brief Data structure that records the congestion state of a connection
@@ -81,7 +86,7 @@ public:
   {}
 
   // Loss Detection variables of interest
-  EventId m_lossDetectionAlarm;            //!< Multi-modal alarm used for loss detection.
+  QuicLazyTimer m_lossDetectionAlarm;      //!< Multi-modal alarm used for loss detection.
   uint32_t m_handshakeCount;               /**< The number of times the handshake packets have been retransmitted
                                             *   without receiving an ack. */
   uint32_t m_tlpCount;                     /**< The number of times a tail loss probe has been sent without
@@ -119,6 +124,7 @@ public:
                                                  *   style loss detection. */
   Time m_kMinTLPTimeout;                        //!< Minimum time in the future a tail loss probe alarm may be set for.
   Time m_kMinRTOTimeout;                        //!< Minimum time in the future an RTO alarm may be set for.
+  Time m_kMaxRTOTimeout;                        //!< Maximum time in the future a backed off alarm may be set for.
   Time m_kDelayedAckTimeout;                    //!< The lenght of the peer's delayed ack timer.
   uint8_t m_alarmType;                          //!< The type of the next alarm
   Time m_nextAlarmTrigger;                      //<! Time of the next alarm
@@ -359,6 +365,14 @@ public:
    */
   uint32_t AvailableWindow (uint8_t pathId);
 
+  /**
+   * \brief Check if pacing currently holds back the packets of a path
+   *
+   * \param pathId the path
+   * \return true if pacing is enabled on the path and its pacing timer is running
+   */
+  bool IsPacingBlocked (uint8_t pathId) const;
+
   /**
    * \brief Get the connection window
    *
@@ -398,6 +412,20 @@ public:
    */
   uint32_t GetInitialMaxStreamData () const;
 
+  /**
+   * \brief Check if the receive window is tuned to the delivery rate and the RTT of the paths
+   *
+   * \return true if the receive window is autotuned
+   */
+  bool GetRcvBufAutoTuning () const;
+
+  /**
+   * \brief Get the receive window of the streams, which is the same for all the paths
+   *
+   * \return the number of bytes the peer may send ahead of the in-order data on a stream
+   */
+  uint32_t GetRcvWindow () const;
+
   /**
    * \brief Get the state in the Congestion state machine
    *
@@ -425,10 +453,10 @@ public:
   /**
    * \brief check if the data received in this connection exceeds MAX_DATA
    *
-   * \param a vector of pairs with received frames and subheaders
+   * \param streamBytes the bytes of stream data (stream 0 excluded) in the received packet
    * \return a boolean, true if the limit was exceeded
    */
-  bool CheckIfPacketOverflowMaxDataLimit (std::vector<std::pair<Ptr<Packet>, QuicSubheader> > disgregated);
+  bool CheckIfPacketOverflowMaxDataLimit (uint32_t streamBytes);
 
   /**
    * \brief Get the maximum of stream ID (i.e., number of streams - 1)
@@ -668,19 +696,100 @@ public:
 
   typedef enum
   {
-    QuicNewReno,       
-    OLIA            
+    QuicNewReno,
+    OLIA,
+    LIA,
+    BALIA,
+    WVEGAS,
+    MPBBR
   } CcType_t;
   
-  void SendAddAddress(Address address, uint8_t pathId);
+  /**
+   * \brief Announce a local address to the peer
+   *
+   * \param address the local address
+   * \param pathId the path the address belongs to
+   * \param onPathId the path the ADD_ADDRESS frame is sent on
+   */
+  void SendAddAddress(Address address, uint8_t pathId, uint8_t onPathId = 0);
+
+  /**
+   * \brief Tell the peer that a local address is no longer available
+   *
+   * \param address the local address
+   * \param pathId the path the address belongs to
+   * \param onPathId the path the REMOVE_ADDRESS frame is sent on
+   */
+  void SendRemoveAddress (Address address, uint8_t pathId, uint8_t onPathId);
+
+  /**
+   * \brief Tell the peer that a path is abandoned
+   *
+   * \param pathId the abandoned path
+   * \param onPathId the path the PATH_ABANDON frame is sent on
+   */
+  void SendPathAbandon (uint8_t pathId, uint8_t onPathId);
   void SendPathChallenge(uint8_t pathId);
   void SendPathResponse (uint8_t pathId);
 
+  /**
+   * \brief Open the paths on the local interfaces without a path yet
+   *
+   * \param upOnly stop at the first interface that is down
+   */
+  void CreateNewSubflows (bool upOnly = false);
+
+  /**
+   * \brief Get all the subflows, whatever their state
+   * \return the subflows, in path ID order
+   */
+  const std::vector<Ptr<MpQuicSubFlow>> &GetSubflows (void) const;
+
+  /**
+   * \brief Schedule the sending of the pending data, e.g. after the frames
+   * of a path were put back in the application buffer
+   */
+  void ResumeSending (void);
+
   void SubflowInsert(Ptr<MpQuicSubFlow> sflow);
+
+  /**
+   * \brief Bind the ACK and loss detection timers of a subflow to this socket
+   *
+   * \param sflow the subflow
+   */
+  void SetSubflowTimers (Ptr<MpQuicSubFlow> sflow);
+
   void AddPath(Address address, Address from, uint8_t pathId);
 
   // For scheduler use
-  std::vector<Ptr<MpQuicSubFlow>> GetActiveSubflows();
+  /**
+   * \brief Get the subflows in the Active state
+   *
+   * The set is only rebuilt after a subflow entered or left the Active
+   * state, and the reference stays valid for the lifetime of the socket.
+   *
+   * \return the active subflows, in path ID order
+   */
+  const std::vector<Ptr<MpQuicSubFlow>> &GetActiveSubflows();
+
+  /**
+   * \brief Get the transmission buffer of the socket
+   * \return the TX buffer
+   */
+  Ptr<QuicSocketTxBuffer> GetTxBuffer (void) const;
+
+  /**
+   * \brief Get the policy deciding on which path the lost frames are sent again
+   * \return the reinjection policy
+   */
+  Ptr<MpQuicReinjection> GetReinjection (void) const;
+
+  /**
+   * \brief Get the path manager, which checks the liveness of the paths
+   * \return the path manager
+   */
+  Ptr<MpQuicPathManager> GetPathManager (void) const;
   uint32_t GetBytesInBuffer();
 
 
@@ -723,10 +832,40 @@ protected:
    * \param seq the sequence number
    * \param maxSize the maximum data block to be transmitted (in bytes)
    * \param withAck forces an ACK to be sent
+   * \param pathId the path to send the packet on
+   * \param duplicate true to send a copy of the last data packet instead of new data
    * \returns the number of bytes sent
    */
   // uint32_t SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize, bool withAck);
-  uint32_t SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize, bool withAck, uint8_t pathId);
+  uint32_t SendDataPacket (SequenceNumber32 packetNumber, uint32_t maxSize, bool withAck, uint8_t pathId,
+                           bool duplicate = false);
+
+  /**
+   * \brief Send the packets built by SendDataPacket down to QuicL4Protocol
+   *
+   * SendDataPacket only queues the packets it builds, so that a burst is
+   * handed to QuicL4Protocol in one call. Callers of SendDataPacket flush
+   * the queue before returning to the simulator, to keep the order of the
+   * packets with those sent directly.
+   */
+  void FlushTxBatch (void);
+
+  /**
+   * \brief Grow the receive window with the data delivered in order
+   *
+   * As in the dynamic right-sizing of Linux, the bytes delivered in order
+   * are counted over one RTT of the slowest path, which is what the receiver
+   * buffers out of order while it waits for that path, and the window grows
+   * to twice that, so that it does not hold back the congestion windows of
+   * the sender. The window never shrinks, and stays under MaxRcvBufSize.
+   *
+   * There is a single window for the connection, shared by all its streams
+   * and paths: the paths are not given windows of their own, the slowest one
+   * only sets how long the deliveries are counted for.
+   *
+   * \param bytes the bytes delivered
+   */
+  void AdjustRcvWindow (uint32_t bytes);
 
   /**
    * \brief Send a Connection Close frame
@@ -791,11 +930,12 @@ protected:
   bool IsVersionSupported (uint32_t version);
 
   /**
-   * \brief Check if there are missing packets in the m_receivedPacketNumbers list
+   * \brief Check if the last packet received on a path was out of order
    *
-   * \return true if there are missing packets
+   * \param pathId the path
+   * \return true if the last packet opened or filled a gap in the received packet numbers
    */
-  bool HasReceivedMissing ();
+  bool HasReceivedMissing (uint8_t pathId);
 
   /**
    * \brief Send an ACK packet
@@ -811,6 +951,27 @@ protected:
    * \brief Notify Pacing
    */
   void NotifyPacingPerformed (void);
+
+  /**
+   * \brief Mark the active subflows as outdated when a subflow enters or leaves the Active state
+   *
+   * \param oldState the previous state of the subflow
+   * \param newState the new state of the subflow
+   */
+  void SubflowStateChanged (MpQuicSubFlow::SubflowStates_t oldState, MpQuicSubFlow::SubflowStates_t newState);
+
+  /**
+   * \brief Charge a packet sent on a path to the pacing tokens of that path
+   *
+   * Tokens accrue at the pacing rate of the path, up to m_pacingBurst segments.
+   * When the path has less than a segment left, its pacing timer is armed for
+   * the time needed to refill the whole burst, so that the path sends its
+   * packets in bursts rather than scheduling an event per packet.
+   *
+   * \param pathId the path
+   * \param bytes the size of the packet sent
+   */
+  void ConsumePacingTokens (uint8_t pathId, uint32_t bytes);
   /**
    * Send the connection close packet and schedule
    * the DoClose method
@@ -862,7 +1023,7 @@ protected:
   // Timers and Events
   EventId m_sendPendingDataEvent;             //!< Micro-delay event to send pending data
   EventId m_retxEvent;                        //!< Retransmission event
-  EventId m_idleTimeoutEvent;                 //!< Event triggered upon receiving or sending a packet, when it expires the connection closes
+  QuicLazyTimer m_idleTimeoutTimer;           //!< Timer pushed forward upon receiving or sending a packet, when it expires the connection closes
   EventId m_drainingPeriodEvent;              //!< Event triggered upon idle timeout or immediate connection close, when it expires all closes
   TracedValue<Time> m_rto;                    //!< Retransmit timeout
   TracedValue<Time> m_drainingPeriodTimeout;  //!< Draining Period timeout
@@ -883,8 +1044,24 @@ protected:
 
   uint32_t m_initialPacketSize; //!< size of the first packet to be sent durin the handshake (at least 1200 bytes, per RFC)
 
-  // Pacing timer
-  Timer m_pacingTimer       {Timer::REMOVE_ON_DESTROY}; //!< Pacing Event
+  // Pacing
+  uint32_t m_pacingBurst;       //!< Number of segments a path can send back-to-back when pacing
+
+  // Batched transmission
+  uint32_t m_txBatchSize;                                     //!< Maximum number of packets handed to QuicL4Protocol at once
+  std::vector<std::pair<Ptr<Packet>, QuicHeader> > m_txBatch;  //!< Packets built by SendDataPacket and not yet sent
+
+  // Receive window autotuning
+  bool m_rcvBufAutoTuning;                //!< True if the receive window follows the delivery rate and the RTT of the slowest path
+  uint32_t m_maxRcvBufSize;               //!< Largest receive window the autotuning may reach
+  TracedValue<uint32_t> m_rcvWindow;      //!< Receive window of the streams
+  uint64_t m_rcvSpaceBytes;               //!< Bytes delivered in order since m_rcvSpaceStart
+  Time m_rcvSpaceStart;                   //!< Start of the current measurement of the delivery rate
+  uint64_t m_peerMaxData;                 //!< Largest MAX_DATA received from the peer
+
+  // Timers
+  bool m_enableTimerWheel;      //!< True if the timers of the paths share the events of the wheel
+  QuicTimerWheel m_timerWheel;  //!< Deadlines of the loss detection and ACK timers of all the paths
 
   /**
   * \brief Callback pointer for cWnd trace chaining
@@ -934,22 +1111,32 @@ protected:
   CcType_t m_ccType;
   Ptr<MpQuicPathManager> m_pathManager;
   Ptr<MpQuicScheduler> m_scheduler;
+  Ptr<MpQuicReinjection> m_reinjection;               //!< Path of the lost and stalled frames
   std::vector <Ptr<MpQuicSubFlow>> m_subflows;
+  std::vector <Ptr<MpQuicSubFlow>> m_activeSubflows;  //!< Subflows in the Active state
+  bool m_activeSubflowsChanged;                       //!< True if m_activeSubflows must be rebuilt
+  MpQuicPathSplit m_pathSplit;                        //!< Scheduler decision, reused by SendPendingData
+  MpQuicCoupledState m_coupledState;                  //!< Paths state shared by the coupled congestion controls
   uint8_t m_currentPathId;
   Address m_currentFromAddress;
   
 
   void CreatePathManager ();
   void CreateScheduler ();
-  void CreateNewSubflows ();
+  void CreateReinjection ();
   void OnReceivedAddAddressFrame (QuicSubheader &sub);
   void OnReceivedPathChallengeFrame (QuicSubheader &sub);
   void OnReceivedPathResponseFrame (QuicSubheader &sub);
   
-  double GetOliaAlpha(uint8_t pathId);
+  /**
+   * \brief Report the window, RTT and loss interval of a path to the coupled congestion control
+   *
+   * \param pathId the path
+   */
+  void UpdateCoupledState (uint8_t pathId);
   
   void UpdateReward (uint32_t oldValue, uint32_t newValue);
-  int m_appCloseSentListNoEmpty;
+  int m_appCloseSentListNoEmpty { 0 };  //!< True if the application closed the socket with packets still in flight or held by the streams
   Time lastAckTime;
 };
 
@@ -79,7 +79,8 @@ QuicSocketRxBuffer::GetTypeId (void)
 }
 
 QuicSocketRxBuffer::QuicSocketRxBuffer ()
-  : m_recvSize (0),
+  : m_headOffset (0),
+  m_recvSize (0),
   m_recvSizeTot (0),
   m_maxBuffer (32768)
 {
@@ -102,7 +103,7 @@ QuicSocketRxBuffer::Add (Ptr<Packet> p)
     {
       if (p->GetSize () > 0)
         {
-          m_socketRecvList.insert (m_socketRecvList.end (), p->Copy ());
+          m_socketRecvList.push_back (p);
           m_recvSize += p->GetSize ();
           m_recvSizeTot += p->GetSize ();
 
@@ -131,42 +132,27 @@ QuicSocketRxBuffer::Extract (uint32_t maxSize)
 
   if (extractSize == 0)
     {
+      NS_LOG_LOGIC ("Nothing extracted.");
       return 0;
     }
 
-  Ptr<Packet> outPkt = Create<Packet> ();
-
-  QuicSocketRxPacketList::iterator it = m_socketRecvList.begin ();
-
-  while (extractSize > 0 && !m_socketRecvList.empty () && it != m_socketRecvList.end ())
+  Ptr<Packet> currentPacket = m_socketRecvList.front ();
+  uint32_t left = currentPacket->GetSize () - m_headOffset;
+  Ptr<Packet> outPkt;
+  if (extractSize < left)
     {
-      it = m_socketRecvList.begin ();
-      Ptr<Packet> currentPacket = *it;
-
-      if (currentPacket->GetSize () + outPkt->GetSize () <= extractSize)   // Merge
-        {
-
-          outPkt->AddAtEnd ((*it));
-          m_socketRecvList.erase (it);
-
-          m_recvSize -= (*it)->GetSize ();
-          extractSize -= (*it)->GetSize ();
-          NS_LOG_LOGIC ("Added packet of size " << (*it)->GetSize ());
-          continue;
-        }
-      else
-        {
-          break;
-        }
-
-      it++;
+      // split the frame, the rest stays at the head of the buffer
+      outPkt = currentPacket->CreateFragment (m_headOffset, extractSize);
+      m_headOffset += extractSize;
     }
-
-  if (outPkt->GetSize () == 0)
+  else
     {
-      NS_LOG_LOGIC ("Nothing extracted.");
-      return 0;
+      outPkt = (m_headOffset == 0) ? currentPacket : currentPacket->CreateFragment (m_headOffset, left);
+      m_socketRecvList.pop_front ();
+      m_headOffset = 0;
     }
+  m_recvSize -= outPkt->GetSize ();
+
   NS_LOG_INFO (
     "Extracted " << outPkt->GetSize () << " bytes from QuicSocketRxBuffer. New buffer size=" << m_recvSize);
   return outPkt;
@@ -26,6 +26,7 @@
 #define QUICSOCKETRXBUFFER_H
 
 #include <map>
+#include <deque>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/sequence-number.h"
@@ -83,6 +84,12 @@ public:
  * \ingroup quic
  *
  * \brief Rx socket buffer for QUIC
+ *
+ * The frames delivered in order by the streams are kept as they were
+ * received, as fragments of the packets that carried them, and are handed to
+ * the application one at a time. A read smaller than the first frame splits
+ * it at the byte boundary, so no data is copied on the way to the
+ * application.
  */
 class QuicSocketRxBuffer : public Object
 {
@@ -141,19 +148,19 @@ public:
   bool Add (Ptr<Packet> p);
 
   /**
-   * Try to extract maxSize bytes from the buffer
+   * Extract the first frame of the buffer, or its first maxSize bytes
    *
-   * \param maxSize the number of bytes to extract
+   * \param maxSize the maximum number of bytes to extract
    * \return a smart pointer to the packet; a pointer to 0 if there is no data to extract
-   * (or the first packet in the buffer is larger than maxSize)
    */
   Ptr<Packet> Extract (uint32_t maxSize);
 
 private:
   typedef std::vector<QuicSocketRxItem*> QuicStreamRxPacketList;  //!< Container for data stored in the buffer
-  typedef std::vector<Ptr<Packet> > QuicSocketRxPacketList;       //!< Container for data stored in the buffer
+  typedef std::deque<Ptr<Packet> > QuicSocketRxPacketList;        //!< Container for data stored in the buffer
 
   QuicSocketRxPacketList m_socketRecvList;  //!< List of received packets with additional info
+  uint32_t m_headOffset;                    //!< Bytes of the first packet already extracted
   uint32_t m_recvSize;                      //!< Current buffer occupancy
   uint32_t m_recvSizeTot;                   //!< Total number of bytes received
   uint32_t m_maxBuffer;                     //!< Maximum buffer size
@@ -42,20 +42,6 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("QuicSocketTxBuffer");
 
-TypeId QuicSocketTxItem::GetTypeId (void)
-{
-  static TypeId tid = TypeId ("ns3::QuicSocketTxItem")
-    .SetParent<Object>()
-    .SetGroupName ("Internet")
-    .AddConstructor<QuicSocketTxItem>()
-//    .AddTraceSource ("UnackSequence",
-//                     "First unacknowledged sequence number (SND.UNA)",
-//                     MakeTraceSourceAccessor (&QuicSocketTxBuffer::m_sentSize),
-//                     "ns3::SequenceNumber32TracedValueCallback")
-  ;
-  return tid;
-}
-
 QuicSocketTxItem::QuicSocketTxItem () 
   : m_packet (0), 
     m_packetNumber (0), 
@@ -71,7 +57,13 @@ QuicSocketTxItem::QuicSocketTxItem ()
 }
 
 QuicSocketTxItem::QuicSocketTxItem (const QuicSocketTxItem &other)
-  : m_packet (other.m_packet),
+  : QuicSocketTxItem (other, other.m_packet->Copy ())
+{
+}
+
+QuicSocketTxItem::QuicSocketTxItem (const QuicSocketTxItem &other, Ptr<Packet> packet)
+  : SimpleRefCount<QuicSocketTxItem> (),
+    m_packet (packet),
     m_packetNumber (other.m_packetNumber), 
     m_lost (other.m_lost), 
     m_retrans (other.m_retrans), 
@@ -82,7 +74,6 @@ QuicSocketTxItem::QuicSocketTxItem (const QuicSocketTxItem &other)
     m_lastSent (other.m_lastSent), 
     m_generated (other.m_generated)
 {
-  m_packet = other.m_packet->Copy ();
 }
 
 void QuicSocketTxItem::Print (std::ostream &os) const
@@ -210,8 +201,7 @@ QuicSocketTxBuffer::QuicSocketTxBuffer () :
     0)
 {
   m_streamZeroList = QuicTxPacketList ();
-  m_subflowSentList.insert(m_subflowSentList.end(), QuicTxPacketList ());
-  m_sentSizeList.insert(m_sentSizeList.end(), 0);
+  m_subflowSentList.insert (m_subflowSentList.end (), SentLedger ());
 }
 
 QuicSocketTxBuffer::~QuicSocketTxBuffer (void)
@@ -219,8 +209,7 @@ QuicSocketTxBuffer::~QuicSocketTxBuffer (void)
   QuicTxPacketList::iterator it;
   m_streamZeroList = QuicTxPacketList ();
   m_streamZeroSize = 0;
-  m_subflowSentList.clear();
-  m_sentSizeList.clear();
+  m_subflowSentList.clear ();
 }
 
 void QuicSocketTxBuffer::Print (std::ostream &os) const
@@ -230,9 +219,13 @@ void QuicSocketTxBuffer::Print (std::ostream &os) const
   std::stringstream ss;
   std::stringstream as;
   
-  for (it = m_subflowSentList[0].begin (); it != m_subflowSentList[0].end (); ++it)
+  const SentLedger &ledger = m_subflowSentList[0];
+  for (auto sent_it = ledger.m_items.begin (); sent_it != ledger.m_items.end (); ++sent_it)
     {
-      (*it)->Print (ss);
+      if (*sent_it != nullptr)
+        {
+          (*sent_it)->Print (ss);
+        }
     }
 
   for (it = m_streamZeroList.begin (); it != m_streamZeroList.end (); ++it)
@@ -242,8 +235,8 @@ void QuicSocketTxBuffer::Print (std::ostream &os) const
 
   os << Simulator::Now ().GetSeconds () << "\nStream 0 list: \n" << as.str ()
      << "\n\nSent list: \n" << ss.str () << "\n\nCurrent Status: "
-     << "\nNumber of transmissions = " << m_subflowSentList[0].size ()
-     << "\nSent Size = " << m_sentSizeList[0]
+     << "\nNumber of transmissions = " << ledger.m_count
+     << "\nSent Size = " << ledger.m_sentSize
      << "\nNumber of stream 0 packets waiting = "
      << m_streamZeroList.size () << "\nStream 0 waiting packet size = "
      << m_streamZeroSize;
@@ -252,29 +245,18 @@ void QuicSocketTxBuffer::Print (std::ostream &os) const
 bool QuicSocketTxBuffer::Add (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << p);
-  QuicSubheader qsb;
-  uint32_t headerSize = p->PeekHeader (qsb);
+  // check to which stream this packet belongs to
+  uint64_t streamId, offset;
+  bool isStream = QuicSubheader::PeekStreamIdAndOffset (p, streamId, offset);
   NS_LOG_INFO (
-    "Try to append " << p->GetSize () << " bytes " << ", availSize=" << Available () << " offset " << qsb.GetOffset () << " on stream " << qsb.GetStreamId ());
+    "Try to append " << p->GetSize () << " bytes " << ", availSize=" << Available () << " offset " << offset << " on stream " << streamId);
 
   if (p->GetSize () <= Available ())
     {
       if (p->GetSize () > 0)
         {
-          Ptr<QuicSocketTxItem> item = CreateObject<QuicSocketTxItem> ();
+          Ptr<QuicSocketTxItem> item = Create<QuicSocketTxItem> ();
           item->m_packet = p;
-          // check to which stream this packet belongs to
-          uint32_t streamId = 0;
-          bool isStream = false;
-          if (headerSize)
-            {
-              streamId = qsb.GetStreamId ();
-              isStream = qsb.IsStream ();
-            }
-          else
-            {
-              NS_ABORT_MSG ("No QuicSubheader in this QUIC frame " << p);
-            }
           item->m_isStream = isStream;
           item->m_isStream0 = (streamId == 0);
           m_numFrameStream0InBuffer += (streamId == 0);
@@ -289,7 +271,7 @@ bool QuicSocketTxBuffer::Add (Ptr<Packet> p)
             }
 
           NS_LOG_INFO (
-            "Update: Application Size = " << m_scheduler->AppSize () << ", offset " << qsb.GetOffset ());
+            "Update: Application Size = " << m_scheduler->AppSize () << ", offset " << offset);
           return true;
         }
       else
@@ -307,7 +289,7 @@ Ptr<Packet> QuicSocketTxBuffer::NextStream0Sequence (
 {
   NS_LOG_FUNCTION (this << seq);
 
-  Ptr<QuicSocketTxItem> outItem = CreateObject<QuicSocketTxItem> ();
+  Ptr<QuicSocketTxItem> outItem = Create<QuicSocketTxItem> ();
 
   QuicTxPacketList::iterator it = m_streamZeroList.begin ();
   if (it != m_streamZeroList.end ())
@@ -319,8 +301,7 @@ Ptr<Packet> QuicSocketTxBuffer::NextStream0Sequence (
       outItem->m_isStream0 = (*it)->m_isStream0;
       m_streamZeroList.erase (it);
       m_streamZeroSize -= currentPacket->GetSize ();
-      m_subflowSentList[0].insert (m_subflowSentList[0].end (), outItem);  //only use path 0 to deal with stream 0
-      m_sentSizeList[0] += outItem->m_packet->GetSize ();
+      InsertSent (outItem, 0);  //only use path 0 to deal with stream 0
       --m_numFrameStream0InBuffer;
       Ptr<Packet> toRet = outItem->m_packet;
       return toRet;
@@ -335,13 +316,11 @@ Ptr<Packet> QuicSocketTxBuffer::NextSequence (uint32_t numBytes,
   NS_LOG_FUNCTION (this << numBytes << seq);
 
 
-  Ptr<QuicSocketTxItem> outItem = GetNewSegment (numBytes, pathId);
+  Ptr<QuicSocketTxItem> outItem = GetNewSegment (numBytes, seq, pathId);
 
   if (outItem != nullptr)
     {
       NS_LOG_INFO ("Extracting " << outItem->m_packet->GetSize () << " bytes");
-      outItem->m_packetNumber = seq;
-      outItem->m_lastSent = Now ();
       Ptr<Packet> toRet = outItem->m_packet;
       // outItem->m_round = currentRound;
       return toRet;
@@ -355,161 +334,198 @@ Ptr<Packet> QuicSocketTxBuffer::NextSequence (uint32_t numBytes,
 }
 
 
-Ptr<QuicSocketTxItem> QuicSocketTxBuffer::GetNewSegment (uint32_t numBytes, uint8_t pathId)
+Ptr<QuicSocketTxItem> QuicSocketTxBuffer::GetNewSegment (uint32_t numBytes,
+                                                         const SequenceNumber32 seq,
+                                                         uint8_t pathId)
 {
-  NS_LOG_FUNCTION (this << numBytes);
+  NS_LOG_FUNCTION (this << numBytes << seq);
 
   Ptr<QuicSocketTxItem> outItem = m_scheduler->GetNewSegment (numBytes,pathId);
+  outItem->m_packetNumber = seq;
+  outItem->m_lastSent = Now ();
+  m_lastSegment = 0;
 
   if (outItem->m_packet->GetSize () > 0)
     {
       NS_LOG_LOGIC ("Adding packet to sent buffer");
-      m_subflowSentList[pathId].insert (m_subflowSentList[pathId].end (), outItem);
-
-      m_sentSizeList[pathId] += outItem->m_packet->GetSize ();
+      if (outItem->m_reinjectedSize > 0)
+        {
+          NS_LOG_INFO (outItem->m_reinjectedSize << " bytes reinjected on path " << (uint32_t) pathId);
+          m_reinjectedBytes += outItem->m_reinjectedSize;
+        }
+      InsertSent (outItem, pathId);
+      m_lastSegment = outItem;
+      m_lastSegmentPathId = pathId;
     }
 
   NS_LOG_INFO (
-    "Update: Sent Size = " << m_sentSizeList[pathId] << " remaining App Size " << m_scheduler->AppSize () << " object size " << outItem->m_packet->GetSize ());
+    "Update: Sent Size = " << m_subflowSentList[pathId].m_sentSize << " remaining App Size " << m_scheduler->AppSize () << " object size " << outItem->m_packet->GetSize ());
 
   //Print(std::cout);
 
   return outItem;
 }
 
+Ptr<Packet> QuicSocketTxBuffer::NextDuplicate (const SequenceNumber32 seq,
+                                               uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << seq << (uint32_t) pathId);
+
+  if (m_lastSegment == nullptr || m_lastSegment->m_sacked || m_lastSegmentPathId == pathId)
+    {
+      NS_LOG_INFO ("Nothing to copy on path " << (uint32_t) pathId);
+      return Create<Packet> ();
+    }
+
+  if (m_lastSegment->m_copies == nullptr)
+    {
+      QuicSocketTxCopies::Copy original = {m_lastSegmentPathId, m_lastSegment->m_packetNumber.GetValue ()};
+      m_lastSegment->m_copies = Create<QuicSocketTxCopies> ();
+      m_lastSegment->m_copies->m_copies.push_back (original);
+    }
+
+  Ptr<QuicSocketTxItem> copy = Create<QuicSocketTxItem> (*m_lastSegment, m_lastSegment->m_packet->Copy ());
+  copy->m_packetNumber = seq;
+  copy->m_lastSent = Now ();
+  copy->m_copies = m_lastSegment->m_copies;
+  copy->m_duplicate = true;
+  QuicSocketTxCopies::Copy entry = {pathId, seq.GetValue ()};
+  copy->m_copies->m_copies.push_back (entry);
+  InsertSent (copy, pathId);
+  if (m_lastSegment->m_lostPathId >= 0 && m_lastSegment->m_lostPathId != pathId)
+    {
+      m_reinjectedBytes += copy->m_packet->GetSize ();
+    }
+
+  NS_LOG_INFO ("Copy of packet " << m_lastSegment->m_packetNumber << " on path " << (uint32_t) m_lastSegmentPathId
+               << " sent as " << seq << " on path " << (uint32_t) pathId);
+  return copy->m_packet;
+}
+
 // add one agurement pathId
 std::vector<Ptr<QuicSocketTxItem> > QuicSocketTxBuffer::OnAckUpdate (
   Ptr<QuicSocketState> tcb, const uint32_t largestAcknowledged,
-  const std::vector<uint32_t> &additionalAckBlocks,
-  const std::vector<uint32_t> &gaps, uint8_t pathId)
+  const QuicAckBlocks &additionalAckBlocks,
+  const QuicAckBlocks &gaps, uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
 
 
-  std::vector<uint32_t> compAckBlocks = additionalAckBlocks;
-  std::vector<uint32_t> compGaps = gaps;
-
   std::vector<Ptr<QuicSocketTxItem> > newlyAcked;
   Ptr<QuicSocketState> tcbd = dynamic_cast<QuicSocketState*> (&(*tcb));
+  SentLedger &ledger = m_subflowSentList[pathId];
 
-  compAckBlocks.insert (compAckBlocks.begin (), largestAcknowledged);
-  uint32_t ackBlockCount = compAckBlocks.size ();
-
-  std::vector<uint32_t>::const_iterator ack_it = compAckBlocks.begin ();
-  std::vector<uint32_t>::const_iterator gap_it = compGaps.begin ();
-
-  std::stringstream gap_print;
-  for (auto i = gaps.begin (); i != gaps.end (); ++i)
-    {
-      gap_print << (*i) << " ";
-    }
+  // The first block ends at the largest acknowledged packet number
+  uint32_t ackBlockCount = additionalAckBlocks.size () + 1;
 
-  std::stringstream block_print;
-  for (auto i = compAckBlocks.begin (); i != compAckBlocks.end (); ++i)
+  if (g_log.IsEnabled (LOG_INFO))
     {
-      block_print << (*i) << " ";
-    }
+      std::stringstream gap_print;
+      for (auto i = gaps.begin (); i != gaps.end (); ++i)
+        {
+          gap_print << (*i) << " ";
+        }
 
-  NS_LOG_INFO (
-    "Largest ACK: " << largestAcknowledged << ", blocks: " << block_print.str () << ", gaps: " << gap_print.str ());
+      std::stringstream block_print;
+      block_print << largestAcknowledged << " ";
+      for (auto i = additionalAckBlocks.begin (); i != additionalAckBlocks.end (); ++i)
+        {
+          block_print << (*i) << " ";
+        }
 
-  // std::cout<<"Largest ACK: " << largestAcknowledged << ", blocks: " << block_print.str () << ", gaps: " << gap_print.str ()<<std::endl;
+      NS_LOG_INFO (
+        "Largest ACK: " << largestAcknowledged << ", blocks: " << block_print.str () << ", gaps: " << gap_print.str ());
+    }
 
-  // Iterate over the ACK blocks and gaps
-  for (uint32_t numAckBlockAnalyzed = 0; numAckBlockAnalyzed < ackBlockCount;
-       ++numAckBlockAnalyzed, ++ack_it, ++gap_it)
+  // Iterate over the ACK blocks and gaps: block i covers the packet numbers
+  // in (gaps[i], additionalAckBlocks[i - 1]], and only those slots of the ledger are visited
+  for (uint32_t numAckBlockAnalyzed = 0; numAckBlockAnalyzed < ackBlockCount
+       && ledger.m_count > 0; ++numAckBlockAnalyzed)
     {
-      for (auto sent_it = m_subflowSentList[pathId].rbegin ();
-           sent_it != m_subflowSentList[pathId].rend () and !m_subflowSentList[pathId].empty (); ++sent_it)                    // Visit sentList in reverse Order for optimization
+      uint32_t block = (numAckBlockAnalyzed == 0) ? largestAcknowledged : additionalAckBlocks[numAckBlockAnalyzed - 1];
+      int64_t high = std::min<int64_t> (block,
+                                        (int64_t) ledger.m_base + ledger.m_items.size () - 1);
+      int64_t low = ledger.m_base;
+      if (numAckBlockAnalyzed < gaps.size ())
         {
-          NS_LOG_LOGIC (
-            "Consider packet " << (*sent_it)->m_packetNumber << " (ACK block " << SequenceNumber32 ((*ack_it)) << ")");
-          // The packet is in the next gap
-          bool inGap = (gap_it < compGaps.end ())
-            && ((*sent_it)->m_packetNumber
-                <= SequenceNumber32 ((*gap_it)));
-          if (inGap)               // Just for optimization we suppose All is perfectly ordered
-            {
-              // (*sent_it)->m_lost = true;
-              NS_LOG_LOGIC (
-                "Packet " << (*sent_it)->m_packetNumber << " missing");
-              break;
-            }
-          // The packet is in the current block: ACK it
-          NS_LOG_LOGIC ("Packet " << (*sent_it)->m_packetNumber << " ACKed");
-          bool notInGap =
-            ((gap_it >= compGaps.end ())
-             || ((*sent_it)->m_packetNumber
-                 > SequenceNumber32 ((*gap_it))));
-
-          if ((*sent_it)->m_packetNumber <= SequenceNumber32 ((*ack_it))
-              and notInGap and (*sent_it)->m_sacked == false)
+          low = std::max<int64_t> (low, (int64_t) gaps[numAckBlockAnalyzed] + 1);
+        }
+
+      // Visit the block in reverse order, as the sent list used to be
+      for (int64_t pn = high; pn >= low; --pn)
+        {
+          Ptr<QuicSocketTxItem> item = ledger.m_items[pn - ledger.m_base];
+          if (item != nullptr && !item->m_sacked)
             {
-              (*sent_it)->m_sacked = true;
-              (*sent_it)->m_ackTime = Now ();
-              newlyAcked.push_back ((*sent_it));
-              UpdateRateSample ((*sent_it), tcb);
+              NS_LOG_LOGIC ("Packet " << item->m_packetNumber << " ACKed");
+              SetSacked (ledger, item);
+              item->m_ackTime = Now ();
+              newlyAcked.push_back (item);
+              UpdateRateSample (item, pathId, tcb);
+              if (item->m_copies != nullptr)
+                {
+                  CancelCopies (item, pathId);
+                }
             }
-
         }
     }
+
   NS_LOG_LOGIC ("Mark lost packets");
   // Mark packets as lost as in RFC (Sec. 4.2.1 of draft-ietf-quic-recovery-15)
-  uint32_t index = m_subflowSentList[pathId].size ();
-  bool lost = false;
-  bool outstanding = false;
-  auto acked_it = m_subflowSentList[pathId].rend ();
-  // Iterate over the sent packet list in reverse
-  for (auto sent_it = m_subflowSentList[pathId].rbegin ();
-       sent_it != m_subflowSentList[pathId].rend () and !m_subflowSentList[pathId].empty ();
-       ++sent_it, --index)
-    {
-      // All previous packets are lost
-      if (lost)
+  Ptr<QuicSocketTxItem> ackedItem = FindSent (SequenceNumber32 (largestAcknowledged), pathId);
+  if (ackedItem != nullptr)
+    {
+      bool lost = false;
+      int64_t firstLost = 0;
+      int64_t low = std::max (ledger.m_base, ledger.m_lostUpTo);
+      // Iterate over the older packets in reverse, stopping where the
+      // previous ACKs already marked everything as lost
+      for (int64_t pn = (int64_t) largestAcknowledged - 1; pn >= low; --pn)
         {
-          if (!(*sent_it)->m_sacked)
+          Ptr<QuicSocketTxItem> item = ledger.m_items[pn - ledger.m_base];
+          if (item == nullptr || item->m_sacked)
             {
-              (*sent_it)->m_lost = true;
-              NS_LOG_LOGIC (
-                "Packet " << (*sent_it)->m_packetNumber << " lost");
+              continue;
             }
-        }
-      else
-        {
-          // The packet is the last ACKed packet
-          if ((*sent_it)->m_packetNumber.GetValue () == largestAcknowledged)
+          // All previous packets are lost
+          if (lost)
             {
-              // Mark the packet as ACKed
-              acked_it = sent_it;
-              outstanding = true;
+              SetLost (ledger, item);
+              NS_LOG_LOGIC ("Packet " << item->m_packetNumber << " lost");
+              continue;
             }
-          else if (outstanding && !(*sent_it)->m_sacked)
+          //ACK-based detection
+          if (largestAcknowledged - item->m_packetNumber.GetValue ()
+              >= tcbd->m_kReorderingThreshold)
             {
-              //ACK-based detection
-              if (largestAcknowledged - (*sent_it)->m_packetNumber.GetValue ()
-                  >= tcbd->m_kReorderingThreshold)
+              SetLost (ledger, item);
+              lost = true;
+              NS_LOG_INFO (
+                "Largest ACK " << largestAcknowledged << ", lost packet " << item->m_packetNumber.GetValue () << " - reordering " << tcbd->m_kReorderingThreshold);
+            }
+          // Time-based detection (optional)
+          if (tcbd->m_kUsingTimeLossDetection)
+            {
+              double lhsComparison = (ackedItem->m_ackTime
+                                      - item->m_lastSent).GetSeconds ();
+              double rhsComparison = tcbd->m_kTimeReorderingFraction
+                * tcbd->m_smoothedRtt.GetSeconds ();
+              if (lhsComparison >= rhsComparison)
                 {
-                  (*sent_it)->m_lost = true;
+                  NS_LOG_UNCOND (
+                    "Largest ACK " << largestAcknowledged << ", lost packet " << item->m_packetNumber.GetValue () << " - time " << rhsComparison);
+                  SetLost (ledger, item);
                   lost = true;
-                  NS_LOG_INFO (
-                    "Largest ACK " << largestAcknowledged << ", lost packet " << (*sent_it)->m_packetNumber.GetValue () << " - reordering " << tcbd->m_kReorderingThreshold);
-                }
-              // Time-based detection (optional)
-              if (tcbd->m_kUsingTimeLossDetection)
-                {
-                  double lhsComparison = ((*acked_it)->m_ackTime
-                                          - (*sent_it)->m_lastSent).GetSeconds ();
-                  double rhsComparison = tcbd->m_kTimeReorderingFraction
-                    * tcbd->m_smoothedRtt.GetSeconds ();
-                  if (lhsComparison >= rhsComparison)
-                    {
-                      NS_LOG_UNCOND (
-                        "Largest ACK " << largestAcknowledged << ", lost packet " << (*sent_it)->m_packetNumber.GetValue () << " - time " << rhsComparison);
-                      (*sent_it)->m_lost = true;
-                      lost = true;
-                    }
                 }
             }
+          if (lost)
+            {
+              firstLost = pn;
+            }
+        }
+      if (lost)
+        {
+          ledger.m_lostUpTo = std::max<uint32_t> (ledger.m_lostUpTo, firstLost + 1);
         }
     }
 
@@ -523,16 +539,19 @@ void QuicSocketTxBuffer::ResetSentList (uint8_t pathId, uint32_t keepItems)
 {
   NS_LOG_FUNCTION (this << keepItems);
   uint32_t kept = 0;
+  SentLedger &ledger = m_subflowSentList[pathId];
 
-
-  for (auto sent_it = m_subflowSentList[pathId].rbegin ();
-       sent_it != m_subflowSentList[pathId].rend () and !m_subflowSentList[pathId].empty ();
-       ++sent_it, kept++)
+  for (auto sent_it = ledger.m_items.rbegin (); sent_it != ledger.m_items.rend (); ++sent_it)
     {
+      if (*sent_it == nullptr)
+        {
+          continue;
+        }
       if (kept >= keepItems && !(*sent_it)->m_sacked)
         {
-          (*sent_it)->m_lost = true;
+          SetLost (ledger, *sent_it);
         }
+      kept++;
     }
 }
 
@@ -540,45 +559,58 @@ void QuicSocketTxBuffer::ResetSentList (uint8_t pathId, uint32_t keepItems)
 bool QuicSocketTxBuffer::MarkAsLost (const SequenceNumber32 seq, uint8_t pathId)
 {
   NS_LOG_FUNCTION (this << seq);
-  bool found = false;
-  for (auto sent_it = m_subflowSentList[pathId].begin ();
-       sent_it != m_subflowSentList[pathId].end () and !m_subflowSentList[pathId].empty (); ++sent_it)
+  Ptr<QuicSocketTxItem> item = FindSent (seq, pathId);
+  if (item != nullptr)
     {
-      if ((*sent_it)->m_packetNumber == seq)
-        {
-          found = true;
-          (*sent_it)->m_lost = true;
-        }
+      SetLost (m_subflowSentList[pathId], item);
+      return true;
     }
-  return found;
+  return false;
 }
 
 uint32_t QuicSocketTxBuffer::Retransmission (SequenceNumber32 packetNumber, uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
   uint32_t toRetx = 0;
+  SentLedger &ledger = m_subflowSentList[pathId];
 
-  // First pass: add lost packets to the application buffer
-  for (auto sent_it = m_subflowSentList[pathId].rbegin (); sent_it != m_subflowSentList[pathId].rend ();
-       ++sent_it)
+  if (ledger.m_lostSize == 0)
     {
-      Ptr<QuicSocketTxItem> item = *sent_it;
-      if (item->m_lost)
+      return toRetx;
+    }
+
+  // Add lost packets to the application buffer and remove them from the sent list
+  for (int64_t index = (int64_t) ledger.m_items.size () - 1; index >= 0; --index)
+    {
+      Ptr<QuicSocketTxItem> item = ledger.m_items[index];
+      if (item != nullptr && item->m_lost)
         {
-          // Add lost packet contents to app buffer
-          Ptr<QuicSocketTxItem> retx = CreateObject<QuicSocketTxItem> ();
-          retx->m_packetNumber = packetNumber++;
-          retx->m_isStream = item->m_isStream;
-          retx->m_isStream0 = item->m_isStream0;
-          retx->m_packet = Create<Packet>();
+          // Remove lost packet from the sent list, then move the item itself
+          // back to the app buffer as a retransmission
+          EraseSent (ledger, index);
+          if (item->m_duplicate)
+            {
+              NS_LOG_INFO ("Lost copy " << item->m_packetNumber << " is not retransmitted");
+              continue;
+            }
+          Ptr<QuicSocketTxItem> retx = item;
+          retx->m_copies = 0;
+          retx->m_lostPathId = pathId;
+          retx->m_reinjectedSize = 0;
           NS_LOG_INFO (
-            "Retx packet " << item->m_packetNumber << " as " << retx->m_packetNumber.GetValue ());
-          // std::cout<<"retx\t"<<(int)pathId<<"\t"<<item->m_packetNumber << "\t" << retx->m_packetNumber.GetValue ()<< std::endl;
-          QuicSocketTxItem::MergeItems (*retx, *item);
+            "Retx packet " << item->m_packetNumber << " as " << packetNumber.GetValue ());
+          retx->m_packetNumber = packetNumber++;
+          retx->m_sacked = false;
+          retx->m_acked = false;
+          retx->m_ackTime = Seconds (0);
           retx->m_lost = false;
           retx->m_retrans = true;
+          retx->m_delivered = 0;
+          retx->m_deliveredTime = Time::Max ();
+          retx->m_firstSentTime = Seconds (0);
+          retx->m_isAppLimited = false;
+          retx->m_ackBytesSent = 0;
           toRetx += retx->m_packet->GetSize ();
-          m_sentSizeList[pathId] -= retx->m_packet->GetSize ();
           if (retx->m_isStream0)
             {
               NS_LOG_INFO ("Lost stream 0 packet, re-inserting in list");
@@ -592,23 +624,6 @@ uint32_t QuicSocketTxBuffer::Retransmission (SequenceNumber32 packetNumber, uint
             }
         }
     }
-
-  NS_LOG_LOGIC ("Remove retransmitted packets from sent list");
-  auto sent_it = m_subflowSentList[pathId].begin ();
-  // Remove lost packets from the sent list
-  while (!m_subflowSentList[pathId].empty () && sent_it != m_subflowSentList[pathId].end ())
-    {
-      Ptr<QuicSocketTxItem> item = *sent_it;
-      if (item->m_lost)
-        {
-          // Remove lost packet from sent vector
-          sent_it = m_subflowSentList[pathId].erase (sent_it);
-        }
-      else
-        {
-          sent_it++;
-        }
-    }
   return toRetx;
 }
 
@@ -616,12 +631,16 @@ std::vector<Ptr<QuicSocketTxItem> > QuicSocketTxBuffer::DetectLostPackets (uint8
 {
   NS_LOG_FUNCTION (this);
   std::vector<Ptr<QuicSocketTxItem> > lost;
+  const SentLedger &ledger = m_subflowSentList[pathId];
 
+  if (ledger.m_lostSize == 0)
+    {
+      return lost;
+    }
 
-  for (auto sent_it = m_subflowSentList[pathId].begin ();
-       sent_it != m_subflowSentList[pathId].end () and !m_subflowSentList[pathId].empty (); ++sent_it)
+  for (auto sent_it = ledger.m_items.begin (); sent_it != ledger.m_items.end (); ++sent_it)
     {
-      if ((*sent_it)->m_lost)
+      if (*sent_it != nullptr && (*sent_it)->m_lost)
         {
           lost.push_back ((*sent_it));
           NS_LOG_INFO ("Packet " << (*sent_it)->m_packetNumber << " is lost");
@@ -633,35 +652,155 @@ std::vector<Ptr<QuicSocketTxItem> > QuicSocketTxBuffer::DetectLostPackets (uint8
 uint32_t QuicSocketTxBuffer::GetLost (uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
-  uint32_t lostCount = 0;
-
-
-  for (auto sent_it = m_subflowSentList[pathId].begin ();
-       sent_it != m_subflowSentList[pathId].end () and !m_subflowSentList[pathId].empty (); ++sent_it)
-    {
-      if ((*sent_it)->m_lost)
-        {
-          lostCount += (*sent_it)->m_packet->GetSize ();
-        }
-    }
-  return lostCount;
+  return m_subflowSentList[pathId].m_lostSize;
 }
 
 void QuicSocketTxBuffer::CleanSentList (uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
-  auto sent_it = m_subflowSentList[pathId].begin ();
+  SentLedger &ledger = m_subflowSentList[pathId];
   // All packets up to here are ACKed (already sent to the receiver app)
-  while (!m_subflowSentList[pathId].empty () && (*sent_it)->m_sacked && !(*sent_it)->m_lost)
+  while (ledger.m_count > 0 && ledger.m_items.front ()->m_sacked
+         && !ledger.m_items.front ()->m_lost)
     {
       // Remove ACKed packet from sent vector
-      Ptr<QuicSocketTxItem> item = *sent_it;
+      Ptr<QuicSocketTxItem> item = ledger.m_items.front ();
       item->m_acked = true;
-      m_sentSizeList[pathId] -= item->m_packet->GetSize ();
-      m_subflowSentList[pathId].erase (sent_it);
       NS_LOG_LOGIC (
-        "Packet " << (*sent_it)->m_packetNumber << " received and ACKed. Removing from sent buffer");
-      sent_it = m_subflowSentList[pathId].begin ();
+        "Packet " << item->m_packetNumber << " received and ACKed. Removing from sent buffer");
+      EraseSent (ledger, 0);
+    }
+}
+
+void
+QuicSocketTxBuffer::InsertSent (Ptr<QuicSocketTxItem> item, uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << item << (uint32_t) pathId);
+  SentLedger &ledger = m_subflowSentList[pathId];
+  uint32_t pn = item->m_packetNumber.GetValue ();
+
+  if (ledger.m_count == 0)
+    {
+      ledger.m_items.clear ();
+      ledger.m_base = pn;
+    }
+  NS_ASSERT_MSG (pn >= ledger.m_base + ledger.m_items.size (),
+                 "Packet " << pn << " sent out of order on path " << (uint32_t) pathId);
+
+  // Packet numbers skipped by ACK-only packets are left empty
+  ledger.m_items.resize (pn - ledger.m_base, nullptr);
+  ledger.m_items.push_back (item);
+  ledger.m_count++;
+
+  uint32_t size = item->m_packet->GetSize ();
+  ledger.m_sentSize += size;
+  if (item->m_lost)
+    {
+      ledger.m_lostSize += size;
+    }
+  if (item->m_sacked)
+    {
+      ledger.m_sackedSize += size;
+    }
+  else if (!item->m_isStream0 && item->m_isStream)
+    {
+      ledger.m_inFlightSize += size;
+    }
+}
+
+Ptr<QuicSocketTxItem>
+QuicSocketTxBuffer::FindSent (SequenceNumber32 seq, uint8_t pathId) const
+{
+  const SentLedger &ledger = m_subflowSentList[pathId];
+  uint32_t pn = seq.GetValue ();
+  if (pn < ledger.m_base || pn - ledger.m_base >= ledger.m_items.size ())
+    {
+      return 0;
+    }
+  return ledger.m_items[pn - ledger.m_base];
+}
+
+void
+QuicSocketTxBuffer::SetLost (SentLedger &ledger, Ptr<QuicSocketTxItem> item)
+{
+  if (!item->m_lost)
+    {
+      item->m_lost = true;
+      ledger.m_lostSize += item->m_packet->GetSize ();
+    }
+}
+
+void
+QuicSocketTxBuffer::SetSacked (SentLedger &ledger, Ptr<QuicSocketTxItem> item)
+{
+  if (!item->m_sacked)
+    {
+      item->m_sacked = true;
+      uint32_t size = item->m_packet->GetSize ();
+      ledger.m_sackedSize += size;
+      if (!item->m_isStream0 && item->m_isStream)
+        {
+          ledger.m_inFlightSize -= size;
+        }
+    }
+}
+
+void
+QuicSocketTxBuffer::CancelCopies (Ptr<QuicSocketTxItem> item, uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << item << (uint32_t) pathId);
+  Ptr<QuicSocketTxCopies> copies = item->m_copies;
+  for (const QuicSocketTxCopies::Copy &copy : copies->m_copies)
+    {
+      if (copy.m_pathId == pathId || copy.m_pathId >= m_subflowSentList.size ())
+        {
+          continue;
+        }
+      // The copy is no longer tracked if it was lost, or retransmitted as a new item
+      Ptr<QuicSocketTxItem> other = FindSent (SequenceNumber32 (copy.m_packetNumber), copy.m_pathId);
+      if (other == nullptr || other->m_copies != copies || other->m_sacked)
+        {
+          continue;
+        }
+      SentLedger &ledger = m_subflowSentList[copy.m_pathId];
+      if (other->m_lost)
+        {
+          other->m_lost = false;
+          ledger.m_lostSize -= other->m_packet->GetSize ();
+        }
+      NS_LOG_LOGIC ("Packet " << other->m_packetNumber << " on path " << (uint32_t) copy.m_pathId
+                    << " cancelled by its copy on path " << (uint32_t) pathId);
+      SetSacked (ledger, other);
+      CleanSentList (copy.m_pathId);
+    }
+}
+
+void
+QuicSocketTxBuffer::EraseSent (SentLedger &ledger, uint32_t index)
+{
+  Ptr<QuicSocketTxItem> item = ledger.m_items[index];
+  uint32_t size = item->m_packet->GetSize ();
+  ledger.m_sentSize -= size;
+  if (item->m_lost)
+    {
+      ledger.m_lostSize -= size;
+    }
+  if (item->m_sacked)
+    {
+      ledger.m_sackedSize -= size;
+    }
+  else if (!item->m_isStream0 && item->m_isStream)
+    {
+      ledger.m_inFlightSize -= size;
+    }
+  ledger.m_items[index] = 0;
+  ledger.m_count--;
+
+  // Keep a tracked item (if any) in the first slot
+  while (!ledger.m_items.empty () && ledger.m_items.front () == nullptr)
+    {
+      ledger.m_items.pop_front ();
+      ledger.m_base++;
     }
 }
 
@@ -695,20 +834,14 @@ uint32_t QuicSocketTxBuffer::BytesInFlight (uint8_t pathId)
 {
   NS_LOG_FUNCTION (this);
 
-  uint32_t inFlight = 0;
-
-
-  for (auto sent_it = m_subflowSentList[pathId].begin ();
-       sent_it != m_subflowSentList[pathId].end () and !m_subflowSentList[pathId].empty (); ++sent_it)
+  // Nothing was sent yet on a path still being validated
+  if (pathId >= m_subflowSentList.size ())
     {
-      if (!(*sent_it)->m_isStream0 && (*sent_it)->m_isStream
-          && !(*sent_it)->m_sacked)
-        {
-          inFlight += (*sent_it)->m_packet->GetSize ();
-        }
+      return 0;
     }
+  uint32_t inFlight = m_subflowSentList[pathId].m_inFlightSize;
 
-  NS_LOG_INFO ("Compute bytes in flight " << inFlight << " m_sentSize " << m_sentSizeList[pathId] << " m_appSize " << m_streamZeroSize + m_scheduler->AppSize ());
+  NS_LOG_INFO ("Compute bytes in flight " << inFlight << " m_sentSize " << m_subflowSentList[pathId].m_sentSize << " m_appSize " << m_streamZeroSize + m_scheduler->AppSize ());
   return inFlight;
 
 }
@@ -741,15 +874,7 @@ void QuicSocketTxBuffer::UpdatePacketSent (SequenceNumber32 seq, uint32_t sz, ui
       m_tcb->m_deliveredTime = Simulator::Now ();
     }
 
-  Ptr<QuicSocketTxItem> item = nullptr;
-  for (auto it = m_subflowSentList[pathId].rbegin (); it != m_subflowSentList[pathId].rend (); ++it)
-    {
-      if ((*it)->m_packetNumber == seq)
-        {
-          item = *it;
-          break;
-        }
-    }
+  Ptr<QuicSocketTxItem> item = FindSent (seq, pathId);
   NS_ASSERT_MSG (item != nullptr, "not found seq " << seq);
   item->m_firstSentTime = m_tcb->m_firstSentTime;
   item->m_deliveredTime = m_tcb->m_deliveredTime;
@@ -771,17 +896,18 @@ QuicSocketTxBuffer::UpdateAckSent (SequenceNumber32 seq, uint32_t sz, Ptr<QuicSo
 }
 
 struct RateSample*
-QuicSocketTxBuffer::GetRateSample ()
+QuicSocketTxBuffer::GetRateSample (uint8_t pathId)
 {
-  NS_LOG_FUNCTION (this);
-  return &m_rs;
+  NS_LOG_FUNCTION (this << (uint32_t) pathId);
+  return &m_subflowSentList[pathId].m_rs;
 }
 
 void
-QuicSocketTxBuffer::UpdateRateSample (Ptr<QuicSocketTxItem> item, Ptr<QuicSocketState> tcb)
+QuicSocketTxBuffer::UpdateRateSample (Ptr<QuicSocketTxItem> item, uint8_t pathId, Ptr<QuicSocketState> tcb)
 {
-  NS_LOG_FUNCTION (this << item);
+  NS_LOG_FUNCTION (this << item << (uint32_t) pathId);
   Ptr<QuicSocketState> m_tcb = tcb;
+  struct RateSample &rs = m_subflowSentList[pathId].m_rs;
   if (m_tcb == nullptr or item->m_deliveredTime == Time::Max ())
     {
       // item already SACKed
@@ -791,15 +917,15 @@ QuicSocketTxBuffer::UpdateRateSample (Ptr<QuicSocketTxItem> item, Ptr<QuicSocket
   m_tcb->m_delivered         += item->m_packet->GetSize ();
   m_tcb->m_deliveredTime      = Simulator::Now ();
 
-  if (item->m_delivered > m_rs.m_priorDelivered)
+  if (item->m_delivered > rs.m_priorDelivered)
     {
-      m_rs.m_priorDelivered   = item->m_delivered;
-      m_rs.m_priorTime        = item->m_deliveredTime;
-      m_rs.m_isAppLimited     = item->m_isAppLimited;
-      m_rs.m_sendElapsed      = item->m_lastSent - item->m_firstSentTime;
-      m_rs.m_ackElapsed       = m_tcb->m_deliveredTime - item->m_deliveredTime;
+      rs.m_priorDelivered   = item->m_delivered;
+      rs.m_priorTime        = item->m_deliveredTime;
+      rs.m_isAppLimited     = item->m_isAppLimited;
+      rs.m_sendElapsed      = item->m_lastSent - item->m_firstSentTime;
+      rs.m_ackElapsed       = m_tcb->m_deliveredTime - item->m_deliveredTime;
       m_tcb->m_firstSentTime  = item->m_lastSent;
-      m_rs.m_priorAckBytesSent  = item->m_ackBytesSent;
+      rs.m_priorAckBytesSent  = item->m_ackBytesSent;
     }
 
   /* Mark the packet as delivered once it is SACKed to avoid
@@ -810,44 +936,45 @@ QuicSocketTxBuffer::UpdateRateSample (Ptr<QuicSocketTxItem> item, Ptr<QuicSocket
 }
 
 bool
-QuicSocketTxBuffer::GenerateRateSample (Ptr<QuicSocketState> tcb)
+QuicSocketTxBuffer::GenerateRateSample (uint8_t pathId, Ptr<QuicSocketState> tcb)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << (uint32_t) pathId);
   Ptr<QuicSocketState> m_tcb = tcb;
+  struct RateSample &rs = m_subflowSentList[pathId].m_rs;
   if (m_tcb == nullptr)
     {
       return false;
     }
 
-  if (m_rs.m_priorTime == Seconds (0))
+  if (rs.m_priorTime == Seconds (0))
     {
       return false;
     }
 
-  m_rs.m_interval = std::max (m_rs.m_sendElapsed, m_rs.m_ackElapsed);
+  rs.m_interval = std::max (rs.m_sendElapsed, rs.m_ackElapsed);
 
-  m_rs.m_delivered = m_tcb->m_delivered - m_rs.m_priorDelivered;
+  rs.m_delivered = m_tcb->m_delivered - rs.m_priorDelivered;
 
 
-  if (m_rs.m_ackBytesSent < m_tcb->m_ackBytesSent - m_rs.m_priorAckBytesSent or++ m_rs.m_ackBytesMaxWin > 5) //quick maxfilter implementation
+  if (rs.m_ackBytesSent < m_tcb->m_ackBytesSent - rs.m_priorAckBytesSent or++ rs.m_ackBytesMaxWin > 5) //quick maxfilter implementation
     {
-      m_rs.m_ackBytesSent = m_tcb->m_ackBytesSent - m_rs.m_priorAckBytesSent;
-      m_rs.m_ackBytesMaxWin = 0;
+      rs.m_ackBytesSent = m_tcb->m_ackBytesSent - rs.m_priorAckBytesSent;
+      rs.m_ackBytesMaxWin = 0;
     }
 
-  uint32_t discountedDelivered = m_rs.m_delivered > m_rs.m_ackBytesSent ? m_rs.m_delivered - m_rs.m_ackBytesSent : 0U;
+  uint32_t discountedDelivered = rs.m_delivered > rs.m_ackBytesSent ? rs.m_delivered - rs.m_ackBytesSent : 0U;
 
-  if (m_rs.m_interval < m_tcb->m_minRtt)
+  if (rs.m_interval < m_tcb->m_minRtt)
     {
-      m_rs.m_interval = Seconds (0);
+      rs.m_interval = Seconds (0);
       return false;
     }
 
-  if (m_rs.m_interval != Seconds (0))
+  if (rs.m_interval != Seconds (0))
     {
-      m_rs.m_deliveryRate = DataRate (discountedDelivered * 8.0 / m_rs.m_interval.GetSeconds ());
+      rs.m_deliveryRate = DataRate (discountedDelivered * 8.0 / rs.m_interval.GetSeconds ());
     }
-  NS_LOG_DEBUG ("computed delivery rate: " << m_rs.m_deliveryRate);
+  NS_LOG_DEBUG ("computed delivery rate: " << rs.m_deliveryRate);
   return true;
 }
 
@@ -888,16 +1015,128 @@ Time QuicSocketTxBuffer::GetDefaultLatency ()
   return GetLatency (0);
 }
 
+uint32_t QuicSocketTxBuffer::Reinject (uint8_t pathId, uint32_t maxBytes)
+{
+  NS_LOG_FUNCTION (this << (uint32_t) pathId << maxBytes);
+  uint32_t reinjected = 0;
+  if (pathId >= m_subflowSentList.size ())
+    {
+      return reinjected;
+    }
+
+  for (const Ptr<QuicSocketTxItem> &item : m_subflowSentList[pathId].m_items)
+    {
+      if (item == nullptr || item->m_lost || !CanReinject (item))
+        {
+          continue;
+        }
+      uint32_t size = item->m_packet->GetSize ();
+      if (reinjected + size > maxBytes)
+        {
+          break;
+        }
+      RequeueSent (item, pathId);
+      reinjected += size;
+    }
+  return reinjected;
+}
+
+uint32_t QuicSocketTxBuffer::ClearSentList (uint8_t pathId)
+{
+  NS_LOG_FUNCTION (this << (uint32_t) pathId);
+  uint32_t requeued = 0;
+  if (pathId >= m_subflowSentList.size ())
+    {
+      return requeued;
+    }
+
+  // The first slot always holds a tracked item
+  SentLedger &ledger = m_subflowSentList[pathId];
+  while (ledger.m_count > 0)
+    {
+      Ptr<QuicSocketTxItem> item = ledger.m_items.front ();
+      if (CanReinject (item))
+        {
+          RequeueSent (item, pathId);
+          requeued += item->m_packet->GetSize ();
+        }
+      EraseSent (ledger, 0);
+    }
+  return requeued;
+}
+
+bool QuicSocketTxBuffer::CanReinject (Ptr<QuicSocketTxItem> item) const
+{
+  return !item->m_sacked && !item->m_duplicate && item->m_copies == nullptr
+         && item->m_isStream && !item->m_isStream0;
+}
+
+void QuicSocketTxBuffer::RequeueSent (Ptr<QuicSocketTxItem> item, uint8_t pathId)
+{
+  // The copy carries the frames from now on, the packet in flight is
+  // treated as a duplicate of it
+  Ptr<QuicSocketTxItem> retx = Create<QuicSocketTxItem> (*item);
+  retx->m_retrans = true;
+  retx->m_lost = false;
+  retx->m_lostPathId = pathId;
+  item->m_duplicate = true;
+  m_scheduler->Add (retx, true);
+  NS_LOG_INFO ("Reinject packet " << item->m_packetNumber << " of path " << (uint32_t) pathId);
+}
+
+Time QuicSocketTxBuffer::GetOldestUnackedSent (uint8_t pathId) const
+{
+  if (pathId < m_subflowSentList.size ())
+    {
+      for (const Ptr<QuicSocketTxItem> &item : m_subflowSentList[pathId].m_items)
+        {
+          if (item != nullptr && !item->m_sacked && !item->m_lost && !item->m_duplicate
+              && item->m_isStream && !item->m_isStream0)
+            {
+              return item->m_lastSent;
+            }
+        }
+    }
+  return Time::Max ();
+}
+
+uint64_t QuicSocketTxBuffer::GetReinjectedBytes (void) const
+{
+  return m_reinjectedBytes;
+}
+
+bool QuicSocketTxBuffer::PeekNextStream (uint64_t &streamId) const
+{
+  Ptr<QuicSocketTxScheduleItem> next = m_scheduler->PeekNextItem ();
+  if (next == nullptr)
+    {
+      return false;
+    }
+  streamId = next->GetStreamId ();
+  return true;
+}
+
+bool QuicSocketTxBuffer::PeekNextDeadline (uint64_t &streamId, uint32_t &size, double &deadline, bool &deprioritized) const
+{
+  // Only relevant for the EDF scheduler
+  Ptr<QuicSocketTxEdfScheduler> edf = DynamicCast<QuicSocketTxEdfScheduler> (m_scheduler);
+  return edf != 0 and edf->PeekNextDeadline (streamId, size, deadline, deprioritized);
+}
+
+bool QuicSocketTxBuffer::DeprioritizeNext (void)
+{
+  // Only relevant for the EDF scheduler
+  Ptr<QuicSocketTxEdfScheduler> edf = DynamicCast<QuicSocketTxEdfScheduler> (m_scheduler);
+  return edf != 0 and edf->DeprioritizeNext ();
+}
+
 
 //For multipath implementation
 
 void QuicSocketTxBuffer::AddSentList(uint8_t pathId)
 {
     while (m_subflowSentList.size() <= pathId){
-      QuicTxPacketList sentList = QuicTxPacketList();
-      m_subflowSentList.insert(m_subflowSentList.end(), sentList);
-      uint32_t sentSize = 0;
-      m_sentSizeList.insert(m_sentSizeList.end(), sentSize);
+      m_subflowSentList.insert(m_subflowSentList.end(), SentLedger ());
     }
 }
 
@@ -906,7 +1145,7 @@ int QuicSocketTxBuffer::SentListIsEmpty()
 {
   NS_LOG_FUNCTION (this);
   for (uint8_t pid = 0; pid < m_subflowSentList.size(); pid++){
-    if (!m_subflowSentList[pid].empty()) {
+    if (m_subflowSentList[pid].m_count > 0) {
       return false;
     }
   }
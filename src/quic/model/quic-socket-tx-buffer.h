@@ -36,6 +36,9 @@
 #include "ns3/tcp-socket-base.h"
 #include "ns3/data-rate.h"
 #include "quic-socket-tx-scheduler.h"
+#include "quic-free-list.h"
+#include "quic-inline-vector.h"
+#include <deque>
 
 namespace ns3 {
 
@@ -61,20 +64,89 @@ struct RateSample
 /**
  * \ingroup quic
  *
- * \brief Item that encloses the application packet and some flags for it
+ * \brief Packets that carry the same frames on different paths
+ *
+ * The redundant schedulers send a copy of a packet on several paths. The
+ * copies share this record, which lists the path and packet number of each
+ * of them, so that the first copy acknowledged cancels the others.
  */
-class QuicSocketTxItem : public Object
+class QuicSocketTxCopies : public SimpleRefCount<QuicSocketTxCopies>
 {
 public:
   /**
-   * \brief Get the type ID.
-   * \return the object TypeId
+   * \brief A copy of the packet
    */
-  static TypeId GetTypeId (void);
+  struct Copy
+  {
+    uint8_t m_pathId;          //!< The path the copy was sent on
+    uint32_t m_packetNumber;   //!< The packet number of the copy on its path
+  };
+
+  /**
+   * \brief Get storage for a record from the free list
+   * \param size the size of the record
+   * \return the storage
+   */
+  static void* operator new (std::size_t size)
+  {
+    return QuicFreeList<QuicSocketTxCopies>::Allocate (size);
+  }
+
+  /**
+   * \brief Give back the storage of a record to the free list
+   * \param p the storage
+   * \param size the size of the record
+   */
+  static void operator delete (void *p, std::size_t size)
+  {
+    QuicFreeList<QuicSocketTxCopies>::Release (p, size);
+  }
+
+  QuicInlineVector<Copy, 4> m_copies;   //!< The copies, the original packet first
+};
 
+/**
+ * \ingroup quic
+ *
+ * \brief Item that encloses the application packet and some flags for it
+ *
+ * Items are created for every frame written, split, sent and retransmitted,
+ * so they are plain reference-counted records whose storage is recycled
+ * through a QuicFreeList.
+ */
+class QuicSocketTxItem : public SimpleRefCount<QuicSocketTxItem>
+{
+public:
   QuicSocketTxItem ();
   QuicSocketTxItem (const QuicSocketTxItem &other);
 
+  /**
+   * \brief Copy the state of an item, enclosing another packet
+   * \param other the item to copy
+   * \param packet the packet of the new item
+   */
+  QuicSocketTxItem (const QuicSocketTxItem &other, Ptr<Packet> packet);
+
+  /**
+   * \brief Get storage for an item from the free list
+   * \param size the size of the item
+   * \return the storage
+   */
+  static void* operator new (std::size_t size)
+  {
+    return QuicFreeList<QuicSocketTxItem>::Allocate (size);
+  }
+
+  /**
+   * \brief Give back the storage of an item to the free list
+   * \param p the storage
+   * \param size the size of the item
+   */
+  static void operator delete (void *p, std::size_t size)
+  {
+    QuicFreeList<QuicSocketTxItem>::Release (p, size);
+  }
+
   /**
    * \brief Merge two QuicSocketTxItem
    *
@@ -114,6 +186,10 @@ public:
   Time m_firstSentTime { Seconds (0) };      //!< Connection's first sent time at the time the packet was sent
   bool m_isAppLimited { false };       //!< Connection's app limited at the time the packet was sent
   uint32_t m_ackBytesSent { 0 };       //!< Connection's ACK-only bytes sent at the time the packet was sent
+  Ptr<QuicSocketTxCopies> m_copies;    //!< Copies of the packet on other paths, if any (not copied with the item)
+  bool m_duplicate { false };          //!< True for a copy of a packet sent on another path, which is never retransmitted
+  int16_t m_lostPathId { -1 };         //!< Path the frames were lost on or reinjected from, -1 for frames not sent yet
+  uint32_t m_reinjectedSize { 0 };     //!< Bytes of the packet carrying frames already sent on another path
 };
 
 /**
@@ -161,6 +237,19 @@ public:
    */
   Ptr<Packet> NextSequence (uint32_t numBytes, const SequenceNumber32 seq, uint8_t pathId);
 
+  /**
+   * \brief Send a copy of the last packet returned by NextSequence on another path
+   *
+   * The copy is tracked in the sent list of its path like any other packet,
+   * but it is never retransmitted, and the first of the copies to be
+   * acknowledged cancels the others.
+   *
+   * \param seq the packet number of the copy on its path
+   * \param pathId the path on which the copy will be sent
+   * \return the copy, or an empty packet if there is nothing to copy
+   */
+  Ptr<Packet> NextDuplicate (const SequenceNumber32 seq, uint8_t pathId);
+
 
   /**
    * \brief Get a block of data not transmitted yet and move it into SentList
@@ -174,10 +263,11 @@ public:
    * \brief Get a block of data not transmitted yet and move it into SentList
    *
    * \param numBytes number of bytes of the QuicSocketTxItem requested
+   * \param seq the packet number the block will be sent with
    * \param pathId the path on which the packet will be sent 
    * \return the item that contains the right packet
    */
-  Ptr<QuicSocketTxItem> GetNewSegment (uint32_t numBytes, uint8_t pathId);
+  Ptr<QuicSocketTxItem> GetNewSegment (uint32_t numBytes, const SequenceNumber32 seq, uint8_t pathId);
 
   /**
    * Process an acknowledgment, set the packets in the send buffer as acknowledged, mark
@@ -194,8 +284,8 @@ public:
    */
   std::vector<Ptr<QuicSocketTxItem> > OnAckUpdate (Ptr<QuicSocketState> tcb,
                                                    const uint32_t largestAcknowledged,
-                                                   const std::vector<uint32_t> &additionalAckBlocks,
-                                                   const std::vector<uint32_t> &gaps,
+                                                   const QuicAckBlocks &additionalAckBlocks,
+                                                   const QuicAckBlocks &gaps,
                                                    uint8_t pathId);
 
   /**
@@ -316,22 +406,25 @@ public:
   void UpdateAckSent (SequenceNumber32 seq, uint32_t sz, Ptr<QuicSocketState> tcb);
 
   /**
-   * Get the current rate sample
+   * Get the current rate sample of a path
+   * \param pathId the path
    * \return A pointer to the current rate sample
    */
-  struct RateSample* GetRateSample ();
+  struct RateSample* GetRateSample (uint8_t pathId);
 
   /**
    * Updates rate samples rate on arrival of each acknowledgement.
    * \param The QuicSocketTxItem containing the acknowledgment
+   * \param pathId the path the item was sent on
    */
-  void UpdateRateSample (Ptr<QuicSocketTxItem> pps, Ptr<QuicSocketState> tcb);
+  void UpdateRateSample (Ptr<QuicSocketTxItem> pps, uint8_t pathId, Ptr<QuicSocketState> tcb);
 
   /**
-   * Calculates delivery rate on arrival of each acknowledgement.
+   * Calculates delivery rate of a path on arrival of each acknowledgement.
+   * \param pathId the path
    * \return True if the calculation is performed correctly
    */
-  bool GenerateRateSample (Ptr<QuicSocketState> tcb);
+  bool GenerateRateSample (uint8_t pathId, Ptr<QuicSocketState> tcb);
 
   /**
    * Set the latency bound for a specified stream
@@ -364,6 +457,78 @@ public:
    */
   Time GetDefaultLatency ();
 
+  /**
+   * \brief Put back in the application buffer the oldest frames in flight on a path
+   *
+   * The frames are queued ahead of new data, so that the path scheduler can
+   * send them again on another path. The packets they were first sent in
+   * remain in flight, but are no longer retransmitted if they are lost.
+   *
+   * \param pathId the path
+   * \param maxBytes the maximum number of bytes to put back
+   * \return the number of bytes put back
+   */
+  uint32_t Reinject (uint8_t pathId, uint32_t maxBytes);
+
+  /**
+   * \brief Stop tracking the packets sent on an abandoned path
+   *
+   * The frames of the packets not acknowledged yet, and not already
+   * reinjected, are put back in the application buffer ahead of new data.
+   *
+   * \param pathId the path
+   * \return the number of bytes put back
+   */
+  uint32_t ClearSentList (uint8_t pathId);
+
+  /**
+   * \brief Get the time the oldest packet still in flight on a path was sent
+   *
+   * Packets marked as lost, and packets whose frames were already reinjected
+   * on another path, are not considered.
+   *
+   * \param pathId the path
+   * \return the send time, or Time::Max () if nothing is in flight
+   */
+  Time GetOldestUnackedSent (uint8_t pathId) const;
+
+  /**
+   * \return the bytes of lost or reinjected frames sent again on a path other than the first one
+   */
+  uint64_t GetReinjectedBytes (void) const;
+
+  /**
+   * \brief Get the stream of the frame that will be sent next
+   *
+   * \param streamId the stream of the head-of-line frame
+   * \return false if the application buffer is empty
+   */
+  bool PeekNextStream (uint64_t &streamId) const;
+
+  /**
+   * \brief Get the deadline of the frame that will be sent next
+   *
+   * Only relevant for the EDF scheduler, see
+   * QuicSocketTxEdfScheduler::PeekNextDeadline.
+   *
+   * \param streamId the stream of the head-of-line frame
+   * \param size the size of the head-of-line frame
+   * \param deadline the deadline of the head-of-line frame, in seconds
+   * \param deprioritized true if the frame was already deprioritized
+   * \return false if there is no head-of-line frame with a deadline
+   */
+  bool PeekNextDeadline (uint64_t &streamId, uint32_t &size, double &deadline, bool &deprioritized) const;
+
+  /**
+   * \brief Deprioritize the frame that will be sent next, as it cannot meet its deadline
+   *
+   * Only relevant for the EDF scheduler, see
+   * QuicSocketTxEdfScheduler::DeprioritizeNext.
+   *
+   * \return true if the head-of-line frame was deprioritized
+   */
+  bool DeprioritizeNext (void);
+
 
   //For multipath Implementation
   
@@ -374,11 +539,94 @@ public:
 private:
   typedef std::list<Ptr<QuicSocketTxItem> > QuicTxPacketList;      //!< container for data stored in the buffer
 
+  /**
+   * \brief Sent packets of a path, indexed by packet number
+   *
+   * Slot i of m_items holds the packet numbered m_base + i, or 0 if that
+   * packet number is not tracked (ACK-only packets, retransmitted items).
+   * The byte counters are kept up to date on every state change of the
+   * tracked items, so that queries do not need to walk the ledger. Each
+   * path also samples its own delivery rate from the items it acknowledges.
+   */
+  struct SentLedger
+  {
+    std::deque<Ptr<QuicSocketTxItem> > m_items;   //!< tracked items, indexed by packet number - m_base
+    uint32_t m_base { 0 };               //!< packet number of the first slot
+    uint32_t m_count { 0 };              //!< number of tracked items
+    uint32_t m_sentSize { 0 };           //!< size of all the tracked items
+    uint32_t m_inFlightSize { 0 };       //!< size of the un-sacked stream frames (stream 0 excluded)
+    uint32_t m_lostSize { 0 };           //!< size of the items marked as lost
+    uint32_t m_sackedSize { 0 };         //!< size of the items already acknowledged
+    uint32_t m_lostUpTo { 0 };           //!< all un-sacked items below this packet number are marked as lost
+    struct RateSample m_rs;              //!< delivery rate sample of the path
+  };
+
   /**
    * Discard acknowledged data from the sent list
    */
   void CleanSentList (uint8_t pathId);
 
+  /**
+   * \brief Append a just-sent item to the ledger of a path
+   *
+   * \param item the item, with its packet number already set
+   * \param pathId the path the item was sent on
+   */
+  void InsertSent (Ptr<QuicSocketTxItem> item, uint8_t pathId);
+
+  /**
+   * \brief Look up a tracked item by packet number
+   *
+   * \param seq the packet number
+   * \param pathId the path the packet was sent on
+   * \return the item, or 0 if the packet number is not tracked
+   */
+  Ptr<QuicSocketTxItem> FindSent (SequenceNumber32 seq, uint8_t pathId) const;
+
+  /**
+   * \brief Mark a tracked item as lost, updating the counters of its ledger
+   */
+  void SetLost (SentLedger &ledger, Ptr<QuicSocketTxItem> item);
+
+  /**
+   * \brief Mark a tracked item as acknowledged, updating the counters of its ledger
+   */
+  void SetSacked (SentLedger &ledger, Ptr<QuicSocketTxItem> item);
+
+  /**
+   * \brief Cancel the copies of an acknowledged item sent on other paths
+   *
+   * The copies still tracked are marked as acknowledged, without being
+   * reported as newly acknowledged to the congestion control of their path,
+   * so that they are neither counted in flight nor retransmitted.
+   *
+   * \param item the acknowledged item
+   * \param pathId the path the item was acknowledged on
+   */
+  void CancelCopies (Ptr<QuicSocketTxItem> item, uint8_t pathId);
+
+  /**
+   * \brief Check whether the frames of a packet sent on a path can be reinjected
+   *
+   * \param item the packet
+   * \return true if it carries stream frames neither acknowledged, nor
+   * already reinjected, nor copied on another path
+   */
+  bool CanReinject (Ptr<QuicSocketTxItem> item) const;
+
+  /**
+   * \brief Put a copy of a sent packet back in the application buffer, ahead of new data
+   *
+   * \param item the packet, which is then treated as a copy of the frames put back
+   * \param pathId the path the packet was sent on
+   */
+  void RequeueSent (Ptr<QuicSocketTxItem> item, uint8_t pathId);
+
+  /**
+   * \brief Stop tracking the item in the given slot, updating the counters of its ledger
+   */
+  void EraseSent (SentLedger &ledger, uint32_t index);
+
 
   QuicTxPacketList m_streamZeroList;       //!< List of waiting stream 0 packets with additional info
   uint32_t m_maxBuffer;            //!< Max number of data bytes in buffer (SND.WND)
@@ -387,14 +635,15 @@ private:
   uint32_t m_numFrameStream0InBuffer;        //!< Number of Stream 0 frames buffered
 
   Ptr<QuicSocketTxScheduler> m_scheduler { nullptr };         //!< Scheduler
+  Ptr<QuicSocketTxItem> m_lastSegment;     //!< Last item returned by GetNewSegment, copied by NextDuplicate
+  uint8_t m_lastSegmentPathId { 0 };       //!< Path the last item returned by GetNewSegment was sent on
+  uint64_t m_reinjectedBytes { 0 };        //!< Bytes of frames sent again on a path other than the first one
   // Ptr<QuicSocketState> m_tcb { nullptr };
-  struct RateSample m_rs;
 
 
   //For multipath Implementation
 
-  std::vector<QuicTxPacketList> m_subflowSentList;
-  std::vector<uint32_t> m_sentSizeList;                       //!< Size of all data in the sent list
+  std::vector<SentLedger> m_subflowSentList;         //!< Sent packets of each path
   
   /**
    * pass m_sentList 0 or m_sentList1 by reference to m_sentList
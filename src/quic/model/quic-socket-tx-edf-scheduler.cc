@@ -80,10 +80,10 @@ void QuicSocketTxEdfScheduler::Add (Ptr<QuicSocketTxItem> item, bool retx)
     {
       if (m_retxFirst)
         {
-          QuicSubheader sub;
-          item->m_packet->PeekHeader (sub);
+          uint64_t streamId, offset;
+          QuicSubheader::PeekStreamIdAndOffset (item->m_packet, streamId, offset);
           NS_LOG_INFO ("Adding retransmitted packet with highest priority");
-          AddScheduleItem (CreateObject<QuicSocketTxScheduleItem> (sub.GetStreamId (), sub.GetOffset (), -1, item), retx);
+          AddScheduleItem (Create<QuicSocketTxScheduleItem> (streamId, offset, -1, item), retx);
         }
       else
         {
@@ -120,31 +120,31 @@ void QuicSocketTxEdfScheduler::Add (Ptr<QuicSocketTxItem> item, bool retx)
                     }
                   nextFragment->AddHeader (sub);
                   start += nextFragment->GetSize ();
-                  Ptr<QuicSocketTxItem> it = CreateObject<QuicSocketTxItem> (
-                    *item);
+                  Ptr<QuicSocketTxItem> it = Create<QuicSocketTxItem> (
+                    *item, nextFragment);
                   uint64_t streamId = sub.GetStreamId ();
                   uint64_t offset = sub.GetOffset ();
-                  it->m_packet = nextFragment;
                   NS_LOG_INFO (
                     "Added retx fragment on stream " << streamId << " with offset " << offset << " and length " << it->m_packet->GetSize () << ", pointer " << GetPointer (it->m_packet));
-                  AddScheduleItem (CreateObject<QuicSocketTxScheduleItem> (streamId, offset, GetDeadline (it).GetSeconds (), it), false);
+                  AddScheduleItem (Create<QuicSocketTxScheduleItem> (streamId, offset, GetDeadline (it).GetSeconds (), it), false);
                 }
             }
           else
             {
               NS_LOG_INFO (
                 "Added retx packet on stream " << sub.GetStreamId () << " with offset " << sub.GetOffset ());
-              AddScheduleItem (CreateObject<QuicSocketTxScheduleItem> (sub.GetStreamId (), sub.GetOffset (), GetDeadline (item).GetSeconds (), item), false);
+              AddScheduleItem (Create<QuicSocketTxScheduleItem> (sub.GetStreamId (), sub.GetOffset (), GetDeadline (item).GetSeconds (), item), false);
             }
         }
     }
   else
     {
-      QuicSubheader sub;
-      item->m_packet->PeekHeader (sub);
+      uint64_t streamId, offset;
+      QuicSubheader::PeekStreamIdAndOffset (item->m_packet, streamId, offset);
       NS_LOG_INFO (
-        "Added packet on stream " << sub.GetStreamId () << " with offset " << sub.GetOffset ());
-      AddScheduleItem (CreateObject<QuicSocketTxScheduleItem> (sub.GetStreamId (), sub.GetOffset (), GetDeadline (item).GetSeconds (), item), retx);
+        "Added packet on stream " << streamId << " with offset " << offset);
+      Time deadline = item->m_generated + GetLatency (streamId);
+      AddScheduleItem (Create<QuicSocketTxScheduleItem> (streamId, offset, deadline.GetSeconds (), item), retx);
     }
 }
 
@@ -180,10 +180,42 @@ const Time QuicSocketTxEdfScheduler::GetDefaultLatency ()
 
 Time QuicSocketTxEdfScheduler::GetDeadline (Ptr<QuicSocketTxItem> item)
 {
-  Ptr<Packet> packet = item->m_packet;
-  QuicSubheader sub;
-  packet->PeekHeader (sub);
-  return item->m_generated + GetLatency (sub.GetStreamId ());
+  uint64_t streamId, offset;
+  QuicSubheader::PeekStreamIdAndOffset (item->m_packet, streamId, offset);
+  return item->m_generated + GetLatency (streamId);
+}
+
+bool QuicSocketTxEdfScheduler::PeekNextDeadline (uint64_t &streamId, uint32_t &size, double &deadline, bool &deprioritized) const
+{
+  Ptr<QuicSocketTxScheduleItem> next = PeekNextItem ();
+  if (next == 0 or next->GetPriority () < 0)
+    {
+      return false;
+    }
+  streamId = next->GetStreamId ();
+  size = next->GetItem ()->m_packet->GetSize ();
+  deadline = next->GetPriority ();
+  deprioritized = next->HasMissedDeadline ();
+  return true;
+}
+
+bool QuicSocketTxEdfScheduler::DeprioritizeNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint64_t streamId;
+  uint32_t size;
+  double deadline;
+  bool deprioritized;
+  if (!PeekNextDeadline (streamId, size, deadline, deprioritized) or deprioritized)
+    {
+      return false;
+    }
+  double newDeadline = std::max ((Simulator::Now () + GetLatency (streamId)).GetSeconds (), deadline);
+  NS_LOG_INFO ("Deprioritize frame on stream " << streamId << ", deadline "
+               << deadline << " -> " << newDeadline);
+  PeekNextItem ()->SetMissedDeadline ();
+  SetNextItemPriority (newDeadline);
+  return true;
 }
 
 }
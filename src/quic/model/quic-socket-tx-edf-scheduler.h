@@ -92,6 +92,31 @@ public:
    */
   const Time GetDefaultLatency ();
 
+  /**
+   * \brief Get the deadline of the frame that will be sent next
+   *
+   * Retransmissions that are prioritized regardless of stream have no
+   * deadline.
+   *
+   * \param streamId the stream of the head-of-line frame
+   * \param size the size of the head-of-line frame
+   * \param deadline the deadline of the head-of-line frame, in seconds
+   * \param deprioritized true if the frame already missed its deadline and was deprioritized
+   * \return false if the buffer is empty or the head-of-line frame has no deadline
+   */
+  bool PeekNextDeadline (uint64_t &streamId, uint32_t &size, double &deadline, bool &deprioritized) const;
+
+  /**
+   * \brief Move the frame that will be sent next behind the frames that can still meet their deadline
+   *
+   * The frame is marked as late and gets the deadline it would have if it
+   * was generated now, so that it is still sent once the more urgent frames
+   * are out. A frame is only deprioritized once.
+   *
+   * \return true if the head-of-line frame was deprioritized
+   */
+  bool DeprioritizeNext (void);
+
 private:
   /**
    * Gets the deadline for a transmission item
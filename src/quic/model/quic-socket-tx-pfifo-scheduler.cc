@@ -71,18 +71,18 @@ void
 QuicSocketTxPFifoScheduler::Add (Ptr<QuicSocketTxItem> item, bool retx)
 {
   NS_LOG_FUNCTION (this << item);
-  QuicSubheader qsb;
-  item->m_packet->PeekHeader (qsb);
-  NS_LOG_INFO ("Adding packet on stream " << qsb.GetStreamId ());
+  uint64_t streamId, offset;
+  QuicSubheader::PeekStreamIdAndOffset (item->m_packet, streamId, offset);
+  NS_LOG_INFO ("Adding packet on stream " << streamId);
   if (!retx)
     {
-      NS_LOG_INFO ("Standard item, add at end (offset " << qsb.GetOffset () << ")");
+      NS_LOG_INFO ("Standard item, add at end (offset " << offset << ")");
     }
   else
     {
-      NS_LOG_INFO ("Retransmitted item, add at beginning (offset " << qsb.GetOffset () << ")");
+      NS_LOG_INFO ("Retransmitted item, add at beginning (offset " << offset << ")");
     }
-  AddScheduleItem (CreateObject<QuicSocketTxScheduleItem> (qsb.GetStreamId (), qsb.GetOffset (), 0, item), (retx && m_retxFirst));
+  AddScheduleItem (Create<QuicSocketTxScheduleItem> (streamId, offset, 0, item), (retx && m_retxFirst));
 }
 
 
@@ -35,24 +35,13 @@
 #include "quic-subheader.h"
 #include "quic-socket-tx-buffer.h"
 #include "quic-socket-base.h"
+#include "quic-trace-recorder.h"
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("QuicSocketTxScheduler");
 
 NS_OBJECT_ENSURE_REGISTERED (QuicSocketTxScheduler);
-NS_OBJECT_ENSURE_REGISTERED (QuicSocketTxScheduleItem);
-
-TypeId
-QuicSocketTxScheduleItem::GetTypeId (void)
-{
-  static TypeId tid = TypeId ("ns3::QuicSocketTxScheduleItem")
-    .SetParent<Object> ()
-    .SetGroupName ("Internet")
-  ;
-  return tid;
-}
-
 int
 QuicSocketTxScheduleItem::Compare (const QuicSocketTxScheduleItem & o) const
 {
@@ -78,15 +67,18 @@ QuicSocketTxScheduleItem::QuicSocketTxScheduleItem (uint64_t id, uint64_t off, d
   : m_streamId (id), 
     m_offset (off), 
     m_priority (p), 
+    m_missedDeadline (false),
     m_item (it)
 {}
 
 QuicSocketTxScheduleItem::QuicSocketTxScheduleItem (const QuicSocketTxScheduleItem &other)
-  : m_streamId (other.m_streamId), 
+  : SimpleRefCount<QuicSocketTxScheduleItem> (),
+    m_streamId (other.m_streamId), 
     m_offset (other.m_offset), 
-    m_priority (other.m_priority)
+    m_priority (other.m_priority),
+    m_missedDeadline (other.m_missedDeadline)
 {
-  m_item = CreateObject<QuicSocketTxItem> (*(other.m_item));
+  m_item = Create<QuicSocketTxItem> (*(other.m_item));
 }
 
 
@@ -121,6 +113,18 @@ QuicSocketTxScheduleItem::SetPriority (double priority)
   m_priority = priority;
 }
 
+bool
+QuicSocketTxScheduleItem::HasMissedDeadline () const
+{
+  return m_missedDeadline;
+}
+
+void
+QuicSocketTxScheduleItem::SetMissedDeadline ()
+{
+  m_missedDeadline = true;
+}
+
 
 
 TypeId
@@ -155,20 +159,20 @@ void
 QuicSocketTxScheduler::Add (Ptr<QuicSocketTxItem> item, bool retx)
 {
   NS_LOG_FUNCTION (this << item);
-  QuicSubheader qsb;
-  item->m_packet->PeekHeader (qsb);
+  uint64_t streamId, offset;
+  QuicSubheader::PeekStreamIdAndOffset (item->m_packet, streamId, offset);
   double priority = -1;
-  NS_LOG_INFO ("Adding packet on stream " << qsb.GetStreamId ());
+  NS_LOG_INFO ("Adding packet on stream " << streamId);
   if (!retx)
     {
-      NS_LOG_INFO ("Standard item, add at end (offset " << qsb.GetOffset () << ")");
+      NS_LOG_INFO ("Standard item, add at end (offset " << offset << ")");
       priority = Simulator::Now ().GetSeconds ();
     }
   else
     {
-      NS_LOG_INFO ("Retransmitted item, add at beginning (offset " << qsb.GetOffset () << ")");
+      NS_LOG_INFO ("Retransmitted item, add at beginning (offset " << offset << ")");
     }
-  Ptr<QuicSocketTxScheduleItem> sched = CreateObject<QuicSocketTxScheduleItem> (qsb.GetStreamId (), qsb.GetOffset (), priority, item);
+  Ptr<QuicSocketTxScheduleItem> sched = Create<QuicSocketTxScheduleItem> (streamId, offset, priority, item);
   AddScheduleItem (sched, retx);
 }
 
@@ -179,16 +183,14 @@ QuicSocketTxScheduler::AddScheduleItem (Ptr<QuicSocketTxScheduleItem> item, bool
   NS_LOG_FUNCTION (this << item);
   m_appList.push (item);
   m_appSize += item->GetItem ()->m_packet->GetSize ();
-  QuicSubheader qsb;
-  item->GetItem ()->m_packet->PeekHeader (qsb);
-  NS_LOG_INFO ("Adding packet on stream " << qsb.GetStreamId () << " with priority " << item->GetPriority ());
+  NS_LOG_INFO ("Adding packet on stream " << item->GetStreamId () << " with priority " << item->GetPriority ());
   if (!retx)
     {
-      NS_LOG_INFO ("Standard item, add at end (offset " << qsb.GetOffset () << ")");
+      NS_LOG_INFO ("Standard item, add at end (offset " << item->GetOffset () << ")");
     }
   else
     {
-      NS_LOG_INFO ("Retransmitted item, add at beginning (offset " << qsb.GetOffset () << ")");
+      NS_LOG_INFO ("Retransmitted item, add at beginning (offset " << item->GetOffset () << ")");
     }
 }
 
@@ -200,7 +202,7 @@ QuicSocketTxScheduler::GetNewSegment (uint32_t numBytes, uint8_t pathId)
   bool firstSegment = true;
   Ptr<Packet> currentPacket = 0;
   Ptr<QuicSocketTxItem> currentItem = 0;
-  Ptr<QuicSocketTxItem> outItem = CreateObject<QuicSocketTxItem>();
+  Ptr<QuicSocketTxItem> outItem = Create<QuicSocketTxItem> ();
   outItem->m_isStream = true;   // Packets sent with this method are always stream packets
   outItem->m_isStream0 = false;
   outItem->m_packet = Create<Packet> ();
@@ -221,14 +223,22 @@ QuicSocketTxScheduler::GetNewSegment (uint32_t numBytes, uint8_t pathId)
                         << currentItem->m_packet->GetSize ()
                         << " m_appSize " << m_appSize);
 
-          QuicSubheader qsb;
-          currentPacket->PeekHeader (qsb);
-          NS_LOG_INFO ("Packet: stream " << qsb.GetStreamId () << ", offset " << qsb.GetOffset ());
+          uint64_t streamId, offset;
+          QuicSubheader::PeekStreamIdAndOffset (currentPacket, streamId, offset);
+          NS_LOG_INFO ("Packet: stream " << streamId << ", offset " << offset);
 
           // std::cout<<"Packet: stream " << qsb.GetStreamId () << ", offset " << qsb.GetOffset ()<<std::endl;
 
           QuicSocketTxItem::MergeItems (*outItem, *currentItem);
           outItemSize += currentItem->m_packet->GetSize ();
+          if (currentItem->m_lostPathId >= 0)
+            {
+              outItem->m_lostPathId = currentItem->m_lostPathId;
+              if (currentItem->m_lostPathId != pathId)
+                {
+                  outItem->m_reinjectedSize += currentItem->m_packet->GetSize ();
+                }
+            }
 
           NS_LOG_LOGIC ("Updating application buffer size: " << m_appSize);
           continue;
@@ -258,8 +268,40 @@ QuicSocketTxScheduler::GetNewSegment (uint32_t numBytes, uint8_t pathId)
               currentPacket->RemoveHeader (qsb);
               uint32_t newPacketSize = (uint32_t)newPacketSizeInt;
 
-              NS_LOG_LOGIC ("Add incomplete frame to the outItem");
+              // A retransmitted item holds all the frames of the lost packet:
+              // only its first frame is split, the others follow its second part
               uint32_t totPacketSize = currentItem->m_packet->GetSize ();
+              Ptr<Packet> otherFrames = 0;
+              if (qsb.GetLength () > 0 && qsb.GetLength () < totPacketSize)
+                {
+                  otherFrames = currentItem->m_packet->CreateFragment (qsb.GetLength (),
+                                                                       totPacketSize - qsb.GetLength ());
+                  totPacketSize = qsb.GetLength ();
+                }
+
+              if (otherFrames != 0 && newPacketSize >= totPacketSize)
+                {
+                  NS_LOG_LOGIC ("Add the first frame of the item to the outItem");
+                  Ptr<Packet> firstFrame = currentItem->m_packet->CreateFragment (0, totPacketSize);
+                  firstFrame->AddHeader (qsb);
+                  currentItem->m_packet = firstFrame;
+                  QuicSocketTxItem::MergeItems (*outItem, *currentItem);
+                  outItemSize += firstFrame->GetSize ();
+                  if (currentItem->m_lostPathId >= 0)
+                    {
+                      outItem->m_lostPathId = currentItem->m_lostPathId;
+                      if (currentItem->m_lostPathId != pathId)
+                        {
+                          outItem->m_reinjectedSize += firstFrame->GetSize ();
+                        }
+                    }
+                  currentItem->m_packet = otherFrames;
+                  m_appList.push (scheduleItem);
+                  m_appSize += otherFrames->GetSize ();
+                  break; // at most one segment
+                }
+
+              NS_LOG_LOGIC ("Add incomplete frame to the outItem");
               NS_LOG_LOGIC ("Extracted " << outItemSize << " bytes");
               uint32_t oldOffset = qsb.GetOffset();
               uint32_t newOffset = oldOffset + newPacketSize;
@@ -287,7 +329,7 @@ QuicSocketTxScheduler::GetNewSegment (uint32_t numBytes, uint8_t pathId)
               NS_ASSERT_MSG (firstPartPacket->GetSize () == newPacketSize,
                              "Wrong size " << firstPartPacket->GetSize ());
               firstPartPacket->AddHeader (newQsbToTx);
-              firstPartPacket->Print (std::cerr);
+              QUIC_TRACE (STREAM_SPLIT, qsb.GetStreamId (), oldOffset, newPacketSize, newLength);
 
               NS_LOG_INFO ("Split packet, putting second part back in application buffer - stream " << newQsbToBuffer.GetStreamId () << ", storing from offset " << newQsbToBuffer.GetOffset ());
 
@@ -296,15 +338,28 @@ QuicSocketTxScheduler::GetNewSegment (uint32_t numBytes, uint8_t pathId)
               Ptr<Packet> secondPartPacket = currentItem->m_packet->CreateFragment (
                 newPacketSize, newLength);
               secondPartPacket->AddHeader (newQsbToBuffer);
+              if (otherFrames != 0)
+                {
+                  secondPartPacket->AddAtEnd (otherFrames);
+                }
 
-              Ptr<QuicSocketTxItem> toBeBuffered = CreateObject<QuicSocketTxItem> (*currentItem);
-              toBeBuffered->m_packet = secondPartPacket;
+              // Send the first part, and keep the item (and its schedule
+              // entry) in the application buffer for the second one
               currentItem->m_packet = firstPartPacket;
-
               QuicSocketTxItem::MergeItems (*outItem, *currentItem);
-              outItemSize += currentItem->m_packet->GetSize ();
+              outItemSize += firstPartPacket->GetSize ();
+              if (currentItem->m_lostPathId >= 0)
+                {
+                  outItem->m_lostPathId = currentItem->m_lostPathId;
+                  if (currentItem->m_lostPathId != pathId)
+                    {
+                      outItem->m_reinjectedSize += firstPartPacket->GetSize ();
+                    }
+                }
 
-              m_appList.push (CreateObject<QuicSocketTxScheduleItem> (scheduleItem->GetStreamId (), scheduleItem->GetOffset (), scheduleItem->GetPriority (), toBeBuffered));
+              Ptr<QuicSocketTxItem> toBeBuffered = currentItem;
+              toBeBuffered->m_packet = secondPartPacket;
+              m_appList.push (scheduleItem);
               m_appSize += toBeBuffered->m_packet->GetSize ();
 
 
@@ -327,5 +382,26 @@ QuicSocketTxScheduler::AppSize (void) const
   return m_appSize;
 }
 
+Ptr<QuicSocketTxScheduleItem>
+QuicSocketTxScheduler::PeekNextItem (void) const
+{
+  if (m_appList.empty ())
+    {
+      return 0;
+    }
+  return m_appList.top ();
+}
+
+void
+QuicSocketTxScheduler::SetNextItemPriority (double priority)
+{
+  NS_LOG_FUNCTION (this << priority);
+  NS_ASSERT (!m_appList.empty ());
+  Ptr<QuicSocketTxScheduleItem> item = m_appList.top ();
+  m_appList.pop ();
+  item->SetPriority (priority);
+  m_appList.push (item);
+}
+
 
 }
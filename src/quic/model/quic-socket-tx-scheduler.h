@@ -27,6 +27,8 @@
 #define QUICSOCKETTXSCHEDULER_H
 
 #include "quic-socket.h"
+#include "quic-free-list.h"
+#include "ns3/simple-ref-count.h"
 #include <queue>
 #include <vector>
 
@@ -38,18 +40,35 @@ class QuicSocketTxItem;
  * \ingroup quic
  *
  * \brief Tx item for QUIC with priority
+ *
+ * Like QuicSocketTxItem, schedule items are plain reference-counted records
+ * whose storage is recycled through a QuicFreeList.
  */
-class QuicSocketTxScheduleItem : public Object
+class QuicSocketTxScheduleItem : public SimpleRefCount<QuicSocketTxScheduleItem>
 {
 public:
+  QuicSocketTxScheduleItem (uint64_t id, uint64_t off, double p, Ptr<QuicSocketTxItem> it);
+  QuicSocketTxScheduleItem (const QuicSocketTxScheduleItem &other);
+
   /**
-   * \brief Get the type ID.
-   * \return the object TypeId
+   * \brief Get storage for a schedule item from the free list
+   * \param size the size of the item
+   * \return the storage
    */
-  static TypeId GetTypeId (void);
+  static void* operator new (std::size_t size)
+  {
+    return QuicFreeList<QuicSocketTxScheduleItem>::Allocate (size);
+  }
 
-  QuicSocketTxScheduleItem (uint64_t id, uint64_t off, double p, Ptr<QuicSocketTxItem> it);
-  QuicSocketTxScheduleItem (const QuicSocketTxScheduleItem &other);
+  /**
+   * \brief Give back the storage of a schedule item to the free list
+   * \param p the storage
+   * \param size the size of the item
+   */
+  static void operator delete (void *p, std::size_t size)
+  {
+    QuicFreeList<QuicSocketTxScheduleItem>::Release (p, size);
+  }
 
   /**
    *  Compare \p this to another QuicSocketTxScheduleItem
@@ -106,10 +125,22 @@ public:
    */
   void SetPriority (double priority);
 
+  /**
+   * \brief Check whether the item was found unable to meet its deadline
+   * \return true if the item missed its deadline
+   */
+  bool HasMissedDeadline () const;
+
+  /**
+   * \brief Record that the item cannot meet its deadline
+   */
+  void SetMissedDeadline ();
+
 private:
   uint64_t m_streamId;                //!< ID of the stream the item belongs to
   uint64_t m_offset;                  //!< offset on the stream
   double m_priority;                  //!< Priority level of the item (lowest is sent first)
+  bool m_missedDeadline;              //!< True if the item cannot meet its deadline
   Ptr<QuicSocketTxItem> m_item;       //!< TxItem containing the packet
 };
 
@@ -179,6 +210,23 @@ public:
    */
   void AddScheduleItem (Ptr<QuicSocketTxScheduleItem> item, bool retx);
 
+  /**
+   * \brief Get the item that will be sent next, without removing it
+   *
+   * \return the head-of-line item, or 0 if the application buffer is empty
+   */
+  Ptr<QuicSocketTxScheduleItem> PeekNextItem (void) const;
+
+  /**
+   * \brief Change the priority of the item that will be sent next
+   *
+   * The item is queued again with the new priority, so that it may no longer
+   * be the head-of-line item.
+   *
+   * \param priority the new priority of the head-of-line item
+   */
+  void SetNextItemPriority (double priority);
+
   /**
    * indicate the offset in order to out-of-order schedule
    */
@@ -41,6 +41,7 @@
 #include "quic-stream-base.h"
 #include "quic-header.h"
 #include "quic-transport-parameters.h"
+#include "quic-trace-recorder.h"
 
 namespace ns3 {
 
@@ -97,6 +98,8 @@ QuicStreamBase::QuicStreamBase (void)
   m_quicl5 (0),
   m_maxStreamData (0),
   m_maxAdvertisedData (0),
+  m_peerMaxStreamData (0),
+  m_sendMaxStreamData (0),
   m_sentSize (0),
   m_recvSize (0),
   m_fin (false)
@@ -186,6 +189,12 @@ QuicStreamBase::GetStreamTxAvailable () const
   return m_txBuffer->Available ();
 }
 
+uint32_t
+QuicStreamBase::GetStreamTxBufferedSize () const
+{
+  return m_txBuffer->AppSize ();
+}
+
 
 uint32_t
 QuicStreamBase::SendPendingData (void)
@@ -294,7 +303,7 @@ uint32_t
 QuicStreamBase::AvailableWindow () const
 {
   NS_LOG_FUNCTION (this);
-  uint32_t streamRWnd = (m_streamId != 0) ? StreamWindow () : m_maxStreamData;
+  uint32_t streamRWnd = (m_streamId != 0) ? std::min (StreamWindow (), m_quicl5->GetConnectionCredit ()) : m_maxStreamData;
   return streamRWnd;
 }
 
@@ -302,9 +311,31 @@ uint32_t
 QuicStreamBase::StreamWindow () const
 {
   NS_LOG_FUNCTION (this);
-  uint32_t inFlight = m_txBuffer->BytesInFlight ();
 
-  return (inFlight > m_maxStreamData) ? 0 : m_maxStreamData - inFlight;
+  if (!m_quicl5->GetRcvBufAutoTuning ())
+    {
+      uint32_t inFlight = m_txBuffer->BytesInFlight ();
+      return (inFlight > m_maxStreamData) ? 0 : m_maxStreamData - inFlight;
+    }
+
+  // MAX_STREAM_DATA is an offset: the credit left is what lies beyond the data already sent
+  return (m_sentSize > m_maxStreamData) ? 0 : m_maxStreamData - m_sentSize;
+}
+
+uint64_t
+QuicStreamBase::GetSentSize () const
+{
+  return m_sentSize;
+}
+
+void
+QuicStreamBase::ResumeSending ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_txBuffer->AppSize () > 0 and !m_streamSendPendingDataEvent.IsRunning ())
+    {
+      m_streamSendPendingDataEvent = Simulator::ScheduleNow (&QuicStreamBase::SendPendingData, this);
+    }
 }
 
 int
@@ -357,10 +388,18 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
                                            "Received MAX_STREAM_DATA in receive-only Stream");
           return -1;
         }
-      else
+      else if (!m_quicl5->GetRcvBufAutoTuning ())
+        {
+          SetMaxStreamData (sub.GetMaxStreamData ());
+          NS_LOG_INFO ("Max stream data (flow control) - " << m_maxStreamData);
+        }
+      else if (sub.GetMaxStreamData () > m_peerMaxStreamData)
         {
+          // an offset, which frames reordered across the paths must not move back
+          m_peerMaxStreamData = sub.GetMaxStreamData ();
           SetMaxStreamData (sub.GetMaxStreamData ());
           NS_LOG_INFO ("Max stream data (flow control) - " << m_maxStreamData);
+          ResumeSending ();
         }
 
       break;
@@ -411,6 +450,25 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
           return -1;
         }
 
+      if (sub.GetLength () > 0 and sub.GetOffset () + sub.GetLength () <= m_recvSize)
+        {
+          // A copy sent on another path, or a spurious retransmission, of
+          // data already delivered: drop it before it reaches the RX buffer
+          NS_LOG_INFO ("Discarding already delivered frame - offset " << sub.GetOffset () << ", length " << sub.GetLength ());
+          break;
+        }
+
+      if (sub.GetOffset () < m_recvSize)
+        {
+          // Sent again cut at other frame boundaries than the copy partly
+          // delivered: the bytes beyond the delivered offset come in order
+          uint32_t delivered = m_recvSize - sub.GetOffset ();
+          NS_LOG_INFO ("Trimming " << delivered << " already delivered bytes of frame - offset " << sub.GetOffset ());
+          QuicSubheader rest = QuicSubheader::CreateStreamSubHeader (m_streamId, m_recvSize, frame->GetSize () - delivered,
+                                                                     true, true, sub.IsStreamFin ());
+          return Recv (frame->CreateFragment (delivered, frame->GetSize () - delivered), rest, address);
+        }
+
       if (m_rxBuffer->Size () + sub.GetLength () > m_maxStreamData)
         {
           m_quicl5->SignalAbortConnection (QuicSubheader::TransportErrorCodes_t::FLOW_CONTROL_ERROR,
@@ -446,10 +504,7 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
       SetStreamStateRecvIf (m_streamStateRecv == RECV and m_fin, SIZE_KNOWN);
 
 
-    // temp_comment
-    std::cout<< Simulator::Now ().GetSeconds () << "\t"<< m_streamId <<"\t" << m_recvSize<<"\t"<<sub.GetOffset ()<< "\t" << m_rxBuffer->Size () << "\t" <<std::endl;
-
-    //  std::cout<< Simulator::Now ().GetSeconds () << "--///--Received a frame on stream "<< m_streamId <<" with the size " << sub.GetLength ()<<" expected offset: "<<m_recvSize<<" actual offset:"<<sub.GetOffset ()<< " Buffer Size: " << m_rxBuffer->Size ()<<std::endl;
+      QUIC_TRACE (STREAM_RECV, m_streamId, m_recvSize, sub.GetOffset (), m_rxBuffer->Size ());
 
       if (m_recvSize == sub.GetOffset ()) 
         {
@@ -458,7 +513,8 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
          
           m_recvSize += sub.GetLength ();
 
-          if (m_maxAdvertisedData == 0 || m_recvSize + m_rxBuffer->Available () > m_maxAdvertisedData + m_maxDataInterval)
+          if ((m_streamId == 0 or !m_quicl5->GetRcvBufAutoTuning ())
+              and (m_maxAdvertisedData == 0 || m_recvSize + m_rxBuffer->Available () > m_maxAdvertisedData + m_maxDataInterval))
             {
               m_maxAdvertisedData = m_recvSize + m_rxBuffer->Available ();
               QuicSubheader sub = QuicSubheader::CreateMaxData (m_recvSize + m_rxBuffer->Available ());
@@ -471,17 +527,8 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
           NS_LOG_LOGIC ("Try to Flush RxBuffer if Available - offset " << m_recvSize);
           // check if the packets in the RX buffer can be released (in order release)
           std::pair<uint64_t, uint64_t> offSetLength = m_rxBuffer->GetDeliverable (m_recvSize);
-          NS_LOG_LOGIC ("Extracting " << offSetLength.second << " bytes from RxBuffer");
-          if (offSetLength.second > 0)
-            {
-              Ptr<Packet> payload = m_rxBuffer->Extract (offSetLength.second);
-              m_recvSize += offSetLength.second;
-              if (payload) {
-                frame->AddAtEnd (payload);
-              }
-            }
-          NS_LOG_LOGIC ("Flushed RxBuffer - new offset " << m_recvSize << ", " << m_rxBuffer->Available () << "bytes available");
-          SetStreamStateRecvIf (m_streamStateRecv == SIZE_KNOWN and m_rxBuffer->Size () == 0, DATA_RECVD);
+          uint64_t deliverable = offSetLength.second;
+          NS_LOG_LOGIC ("Extracting " << deliverable << " bytes from RxBuffer");
 
           if (m_streamId != 0 )
             {
@@ -496,6 +543,39 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
             {
               NS_LOG_INFO ("Received handshake Message in Stream 0");
             }
+
+          // The frames buffered behind this one follow it, each in the packet
+          // it arrived in rather than merged into a copy
+          while (deliverable > 0)
+            {
+              Ptr<Packet> payload = m_rxBuffer->ExtractFrame ();
+              NS_ASSERT (payload != nullptr and payload->GetSize () <= deliverable);
+              m_recvSize += payload->GetSize ();
+              deliverable -= payload->GetSize ();
+              if (m_streamId != 0)
+                {
+                  m_quicl5->Recv (payload, address);
+                }
+            }
+          NS_LOG_LOGIC ("Flushed RxBuffer - new offset " << m_recvSize << ", " << m_rxBuffer->Available () << "bytes available");
+
+          if (m_streamId != 0 and m_quicl5->GetRcvBufAutoTuning ())
+            {
+              // Move the credit of the sender once half of the receive window
+              // is consumed, counting the buffered frames just delivered: the
+              // sender may have nothing left to send until it gets the credit
+              uint32_t window = GetStreamRcvBufSize ();
+              if (m_maxAdvertisedData == 0 || m_recvSize + window > m_maxAdvertisedData + window / 2)
+                {
+                  m_maxAdvertisedData = m_recvSize + window;
+                  QuicSubheader sub = QuicSubheader::CreateMaxStreamData (m_streamId, m_recvSize + window);
+                  Ptr<Packet> maxStream = Create<Packet> (0);
+                  maxStream->AddHeader (sub);
+                  m_quicl5->Send (maxStream);
+                }
+            }
+          UpdateSendMaxStreamData ();
+          SetStreamStateRecvIf (m_streamStateRecv == SIZE_KNOWN and m_rxBuffer->Size () == 0, DATA_RECVD);
           SetStreamStateRecvIf (m_streamStateRecv == DATA_RECVD, DATA_READ);
 
         }
@@ -517,6 +597,7 @@ QuicStreamBase::Recv (Ptr<Packet> frame, const QuicSubheader& sub, Address &addr
                   m_quicl5->SignalAbortConnection (QuicSubheader::TransportErrorCodes_t::NO_ERROR, "Aborting connection due to full RX buffer");
               }
             }
+          UpdateSendMaxStreamData ();
         }
 
       break;
@@ -580,6 +661,21 @@ QuicStreamBase::SendMaxStreamData ()
   return m_recvSize + m_rxBuffer->Available ();
 }
 
+void
+QuicStreamBase::UpdateSendMaxStreamData ()
+{
+  if (m_quicl5 == nullptr)
+    {
+      return;
+    }
+  uint32_t sendMaxStreamData = SendMaxStreamData ();
+  if (sendMaxStreamData != m_sendMaxStreamData)
+    {
+      m_quicl5->UpdateMaxData (m_sendMaxStreamData, sendMaxStreamData);
+      m_sendMaxStreamData = sendMaxStreamData;
+    }
+}
+
 void
 QuicStreamBase::SetMaxStreamData (uint32_t maxStreamData)
 {
@@ -761,6 +857,7 @@ QuicStreamBase::SetStreamRcvBufSize (uint32_t size)
   NS_LOG_FUNCTION (this << size);
   m_streamRxBufferSize = size;
   m_rxBuffer->SetMaxBufferSize (size);
+  UpdateSendMaxStreamData ();
 }
 
 uint32_t
@@ -97,10 +97,26 @@ public:
   /**
    * \brief Compute the stream window for streams different from 0
    *
+   * With RcvBufAutoTuning, MAX_STREAM_DATA is an offset and the window is
+   * what lies beyond the data already sent; otherwise it is a limit on the
+   * bytes in flight on the stream.
+   *
    * \return the amount of data that can be sent on the stream
    */
   uint32_t StreamWindow () const;
 
+  /**
+   * \brief Get the amount of data sent in this stream
+   *
+   * \return the offset of the next new data
+   */
+  uint64_t GetSentSize () const;
+
+  /**
+   * \brief Send the data held for flow control, after the peer gave more credit
+   */
+  void ResumeSending ();
+
   /**
    * \brief Called by the QuicL5Protocol class to forward a frame for this stream
    *
@@ -182,6 +198,12 @@ public:
    */
   uint32_t GetStreamRcvBufSize (void) const;
 
+  /**
+   * \brief Get the bytes of the stream not yet passed to the socket
+   * \returns the bytes in the stream TX buffer
+   */
+  uint32_t GetStreamTxBufferedSize (void) const;
+
   // Implementation of QuicStream virtuals
   std::string StreamDirectionTypeToString () const;
   void SetStreamDirectionType (const QuicStreamDirectionTypes_t& streamDirectionType);
@@ -198,6 +220,13 @@ public:
   uint32_t GetStreamTxAvailable (void) const;
   void UpdateRxBuf (uint32_t oldValue, uint32_t newValue);
 
+protected:
+  /**
+   * \brief Report a change of SendMaxStreamData to the QuicL5Protocol,
+   * which keeps the connection MAX_DATA as a running sum
+   */
+  void UpdateSendMaxStreamData ();
+
 protected:
   QuicStreamTypes_t m_streamType;                    //!< The stream type
   QuicStreamDirectionTypes_t m_streamDirectionType;  //!< The stream direction
@@ -211,6 +240,8 @@ protected:
   // Flow Control Parameters
   uint32_t m_maxStreamData;                          //!< Maximum amount of data that can be sent/received on the stream
   uint32_t m_maxAdvertisedData;                                          //!< Last advertised MaxData
+  uint32_t m_peerMaxStreamData;                      //!< Largest MAX_STREAM_DATA received from the peer
+  uint32_t m_sendMaxStreamData;                      //!< Last SendMaxStreamData reported to the QuicL5Protocol
   uint32_t m_maxDataInterval;                                            //!< Interval between MaxData frames
   uint64_t m_sentSize;                               //!< Amount of data sent in this stream
   uint64_t m_recvSize;                               //!< Amount of data received in this stream
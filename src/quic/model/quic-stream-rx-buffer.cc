@@ -33,6 +33,7 @@
 // #include "ns3/ipv6-l3-protocol.h"
 // #include "ns3/ipv6-routing-protocol.h"
 #include <algorithm>
+#include <iterator>
 #include "quic-stream-rx-buffer.h"
 #include "quic-subheader.h"
 
@@ -95,6 +96,60 @@ QuicStreamRxBuffer::QuicStreamRxBuffer ()
 
 QuicStreamRxBuffer::~QuicStreamRxBuffer ()
 {
+  for (QuicStreamRxPacketList::iterator it = m_streamRecvList.begin ();
+       it != m_streamRecvList.end (); ++it)
+    {
+      delete it->second;
+    }
+  for (std::vector<QuicStreamRxItem*>::iterator it = m_itemPool.begin ();
+       it != m_itemPool.end (); ++it)
+    {
+      delete *it;
+    }
+}
+
+QuicStreamRxItem*
+QuicStreamRxBuffer::AllocateItem (void)
+{
+  if (m_itemPool.empty ())
+    {
+      return new QuicStreamRxItem ();
+    }
+  QuicStreamRxItem *item = m_itemPool.back ();
+  m_itemPool.pop_back ();
+  return item;
+}
+
+void
+QuicStreamRxBuffer::ReleaseItem (QuicStreamRxItem *item)
+{
+  item->m_packet = 0;
+  item->m_offset = 0;
+  item->m_fin = false;
+  m_itemPool.push_back (item);
+}
+
+QuicStreamRxItem*
+QuicStreamRxBuffer::RemoveFirst (void)
+{
+  NS_ASSERT (!m_streamRecvList.empty ());
+  QuicStreamRxPacketList::iterator first = m_streamRecvList.begin ();
+  QuicStreamRxItem *item = first->second;
+  m_streamRecvList.erase (first);
+
+  // The first item always opens the first range
+  QuicStreamRxRangeMap::iterator range = m_ranges.begin ();
+  NS_ASSERT (range != m_ranges.end () && range->first == item->m_offset);
+  uint64_t itemEnd = item->m_offset + item->m_packet->GetSize ();
+  uint64_t rangeEnd = range->second;
+  m_ranges.erase (range);
+  if (itemEnd < rangeEnd)
+    {
+      m_ranges[itemEnd] = rangeEnd;
+    }
+
+  m_numBytesInBuffer -= item->m_packet->GetSize ();
+  return item;
 }
 
 bool
@@ -105,67 +160,98 @@ QuicStreamRxBuffer::Add (Ptr<Packet> p, const QuicSubheader& sub)
   NS_LOG_INFO (
     "Try to append " << p->GetSize () << " bytes " << ", availSize=" << Available ());
 
-  if (p->GetSize () <= Available ())
+  if (p->GetSize () > Available ())
     {
-      if (p->GetSize () > 0)
-        {
+      NS_LOG_WARN ("Rejected. Not enough room to buffer packet.");
+      return false;
+    }
+  if (p->GetSize () == 0)
+    {
+      NS_LOG_WARN ("Discarded. Trying to insert empty packet.");
+      return false;
+    }
 
-          QuicStreamRxItem *item = new QuicStreamRxItem ();
-          item->m_packet = p->Copy ();
-          item->m_offset = sub.GetOffset ();
-          item->m_fin = sub.IsStreamFin ();
-
-          QuicStreamRxPacketList::iterator it;
-
-          // FIN packet for the stream
-          if (sub.IsStreamFin ())
-            {
-              NS_LOG_LOGIC ("FIN packet for the stream");
-              m_finalSize = sub.GetOffset () + p->GetSize ();
-              m_recvFin = true;
-              m_streamRecvList.insert (m_streamRecvList.end (), item);
-              return true;
-            }
-
-          // Find the right place to insert packet (TODO: binary search would be more efficient)
-          bool inserted = false;
-          for (it = m_streamRecvList.begin (); it < m_streamRecvList.end ();
-               ++it)
-            {
-              if (item->m_offset == (*it)->m_offset)
-                {
-                  // Duplicate packet
-                  NS_LOG_WARN ("Discarded duplicate packet.");
-                  return false;
-                }
-              if (item->m_offset < (*it)->m_offset)
-                {
-                  m_streamRecvList.insert (it, item);
-                  NS_LOG_LOGIC ("Inserted packet");
-                  inserted = true;
-                  break;
-                }
-            }
-          // The packet is not in the buffer, append it to the end
-          if (!inserted)
-            {
-              NS_LOG_LOGIC ("Appending packet");
-              m_streamRecvList.insert (m_streamRecvList.end (), item);
-            }
-          m_numBytesInBuffer += p->GetSize ();
-          NS_LOG_INFO ("Update: Received Size = " << m_numBytesInBuffer);
-          return true;
+  uint64_t offset = sub.GetOffset ();
+  uint64_t end = offset + p->GetSize ();
 
-        }
-      else
+  // First range starting after offset, and the one before it (if any)
+  QuicStreamRxRangeMap::iterator next = m_ranges.upper_bound (offset);
+  QuicStreamRxRangeMap::iterator prev = m_ranges.end ();
+  if (next != m_ranges.begin ())
+    {
+      prev = std::prev (next);
+      if (prev->second >= end)
         {
-          NS_LOG_WARN ("Discarded. Trying to insert empty packet.");
+          NS_LOG_WARN ("Discarded duplicate packet.");
           return false;
         }
+      if (prev->second > offset)
+        {
+          // Sent again cut at other frame boundaries: keep the new bytes only
+          NS_LOG_LOGIC ("Trimmed " << prev->second - offset << " buffered bytes at the start of the packet");
+          QuicSubheader rest = QuicSubheader::CreateStreamSubHeader (sub.GetStreamId (), prev->second, end - prev->second,
+                                                                     true, true, sub.IsStreamFin ());
+          return Add (p->CreateFragment (prev->second - offset, end - prev->second), rest);
+        }
     }
-  NS_LOG_WARN ("Rejected. Not enough room to buffer packet.");
-  // std::cout<<"stream rx buffer, Rejected. Not enough room to buffer packet."<<std::endl;
-  return false;
+  if (next != m_ranges.end () && next->first < end)
+    {
+      // The packet covers buffered bytes: add what lies before and after them
+      NS_LOG_LOGIC ("Split the packet around the buffered range from " << next->first << " to " << next->second);
+      uint64_t rangeEnd = next->second;
+      QuicSubheader head = QuicSubheader::CreateStreamSubHeader (sub.GetStreamId (), offset, next->first - offset,
+                                                                 true, true, false);
+      bool added = Add (p->CreateFragment (0, next->first - offset), head);
+      if (rangeEnd < end)
+        {
+          QuicSubheader tail = QuicSubheader::CreateStreamSubHeader (sub.GetStreamId (), rangeEnd, end - rangeEnd,
+                                                                     true, true, sub.IsStreamFin ());
+          added = Add (p->CreateFragment (rangeEnd - offset, end - rangeEnd), tail) or added;
+        }
+      return added;
+    }
+
+  // FIN packet for the stream
+  if (sub.IsStreamFin ())
+    {
+      NS_LOG_LOGIC ("FIN packet for the stream");
+      m_finalSize = end;
+      m_recvFin = true;
+    }
+
+  bool joinPrev = (prev != m_ranges.end () && prev->second == offset);
+  bool joinNext = (next != m_ranges.end () && next->first == end);
+
+  if (joinPrev && joinNext)
+    {
+      prev->second = next->second;
+      m_ranges.erase (next);
+    }
+  else if (joinPrev)
+    {
+      prev->second = end;
+    }
+  else if (joinNext)
+    {
+      uint64_t last = next->second;
+      m_ranges.erase (next);
+      m_ranges[offset] = last;
+    }
+  else
+    {
+      m_ranges[offset] = end;
+    }
+
+  QuicStreamRxItem *item = AllocateItem ();
+  item->m_packet = p;
+  item->m_offset = offset;
+  item->m_fin = sub.IsStreamFin ();
+  m_streamRecvList.insert (std::make_pair (offset, item));
+  NS_LOG_LOGIC ("Inserted packet");
+
+  m_numBytesInBuffer += p->GetSize ();
+  NS_LOG_INFO ("Update: Received Size = " << m_numBytesInBuffer);
+  return true;
 }
 
 Ptr<Packet>
@@ -173,7 +259,7 @@ QuicStreamRxBuffer::Extract (uint32_t maxSize)
 {
   NS_LOG_FUNCTION (this << maxSize);
 
-  uint32_t extractSize = std::min (maxSize, m_numBytesInBuffer.Get());
+  uint32_t extractSize = std::min (maxSize, m_numBytesInBuffer.Get ());
   NS_LOG_INFO (
     "Requested to extract " << extractSize << " bytes from QuicStreamRxBuffer of size = " << m_numBytesInBuffer);
 
@@ -184,32 +270,14 @@ QuicStreamRxBuffer::Extract (uint32_t maxSize)
 
   Ptr<Packet> outPkt = Create<Packet> ();
 
-  QuicStreamRxPacketList::iterator it = m_streamRecvList.begin ();
-
   while (extractSize > 0 && !m_streamRecvList.empty ()
-         && it != m_streamRecvList.end ())
+         && m_streamRecvList.begin ()->second->m_packet->GetSize () <= extractSize)
     {
-      it = m_streamRecvList.begin ();
-      Ptr<Packet> currentPacket = (*it)->m_packet;
-
-      if (currentPacket->GetSize () <= extractSize)   // Merge
-        {
-
-          outPkt->AddAtEnd (currentPacket);
-          m_streamRecvList.erase (it);
-          NS_LOG_LOGIC ("Extracted and removed packet " << (*it)->m_offset << " from RxBuffer, bytes to extract: " << extractSize);
-
-          m_numBytesInBuffer -= currentPacket->GetSize ();
-          extractSize -= currentPacket->GetSize ();
-
-          continue;
-        }
-      else
-        {
-          break;
-        }
-
-      it++;
+      QuicStreamRxItem *item = RemoveFirst ();
+      outPkt->AddAtEnd (item->m_packet);
+      extractSize -= item->m_packet->GetSize ();
+      NS_LOG_LOGIC ("Extracted and removed packet " << item->m_offset << " from RxBuffer, bytes to extract: " << extractSize);
+      ReleaseItem (item);
     }
 
   if (outPkt->GetSize () == 0)
@@ -221,27 +289,57 @@ QuicStreamRxBuffer::Extract (uint32_t maxSize)
   return outPkt;
 }
 
+Ptr<Packet>
+QuicStreamRxBuffer::ExtractFrame (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_streamRecvList.empty ())
+    {
+      return 0;
+    }
+
+  QuicStreamRxItem *item = RemoveFirst ();
+  Ptr<Packet> frame = item->m_packet;
+  NS_LOG_LOGIC ("Extracted and removed packet " << item->m_offset << " from RxBuffer");
+  ReleaseItem (item);
+  return frame;
+}
+
 std::pair<uint64_t, uint64_t>
 QuicStreamRxBuffer::GetDeliverable (uint64_t currRecvOffset)
 {
-  NS_LOG_FUNCTION (this);
-  uint64_t offsetToExtract = currRecvOffset;
-  uint64_t lengthToExtract = 0;
+  NS_LOG_FUNCTION (this << currRecvOffset);
   NS_LOG_LOGIC ("Calculating deliverable size");
 
-  QuicStreamRxPacketList::iterator i;
-
-  for (i = m_streamRecvList.begin (); i != m_streamRecvList.end (); ++i)
+  // Drop the data which has already been delivered, trimming a frame which
+  // straddles the current offset
+  while (!m_streamRecvList.empty ()
+         && m_streamRecvList.begin ()->first < currRecvOffset)
     {
-      if ((*i)->m_offset == currRecvOffset + lengthToExtract)
+      QuicStreamRxItem *item = RemoveFirst ();
+      uint64_t itemEnd = item->m_offset + item->m_packet->GetSize ();
+      NS_LOG_LOGIC ("Dropped already delivered packet with offset " << item->m_offset);
+      if (itemEnd > currRecvOffset)
         {
-          offsetToExtract = (*i)->m_offset;
-          lengthToExtract += (*i)->m_packet->GetSize ();
+          uint32_t delivered = currRecvOffset - item->m_offset;
+          Ptr<Packet> rest = item->m_packet->CreateFragment (delivered, itemEnd - currRecvOffset);
+          QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (0, currRecvOffset, rest->GetSize (),
+                                                                    true, true, item->m_fin);
+          Add (rest, sub);
         }
-      NS_LOG_LOGIC ("Inspected packet with offset " << (*i)->m_offset);
+      ReleaseItem (item);
+    }
+
+  QuicStreamRxRangeMap::const_iterator first = m_ranges.begin ();
+  if (first == m_ranges.end () || first->first != currRecvOffset)
+    {
+      return std::make_pair (currRecvOffset, 0);
     }
 
-  return std::make_pair (offsetToExtract, lengthToExtract);
+  // Offset of the last packet of the contiguous range
+  QuicStreamRxPacketList::const_iterator last = std::prev (m_streamRecvList.lower_bound (first->second));
+  return std::make_pair (last->first, first->second - currRecvOffset);
 }
 
 uint32_t
@@ -292,7 +390,7 @@ QuicStreamRxBuffer::Print (std::ostream & os) const
 
   for (it = m_streamRecvList.begin (); it != m_streamRecvList.end (); ++it)
     {
-      (*it)->Print (ss);
+      it->second->Print (ss);
     }
 
   os << "Stream Recv list: \n" << ss.str () << "\n\nCurrent Status: "
@@ -26,6 +26,7 @@
 #define QUICSTREAMRXBUFFER_H
 
 #include <map>
+#include <vector>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/sequence-number.h"
@@ -82,6 +83,15 @@ public:
  * \ingroup quic
  *
  * \brief Rx stream buffer for QUIC
+ *
+ * Out-of-order frames are kept in a map keyed by their offset, next to the
+ * set of byte ranges they cover. Ranges are coalesced as frames are added,
+ * so that the contiguous data available at the current receive offset is
+ * found with a single lookup instead of a scan of the buffer. The storage of
+ * the items released by Extract is kept aside and reused for the next frames.
+ *
+ * The frames are kept as the fragments of the received packets, without a
+ * copy, and ExtractFrame hands them back one by one in the same way.
  */
 class QuicStreamRxBuffer : public Object
 {
@@ -136,9 +146,12 @@ public:
   /**
    * Add a packet to the receive buffer
    *
+   * Only the bytes which are not buffered yet are added, as a frame sent
+   * again may be cut at other boundaries than the copies already received.
+   *
    * \param p a smart pointer to a packet
    * \param sub the QuicSubheader of the packet
-   * \return true if the insertion was successful
+   * \return true if some bytes of the packet were added
    */
   bool Add (Ptr<Packet> p, const QuicSubheader& sub);
 
@@ -150,6 +163,14 @@ public:
    */
   Ptr<Packet> Extract (uint32_t maxSize);
 
+  /**
+   * Extract the first frame of the buffer as it was added, without merging
+   * it with the next ones
+   *
+   * \return a smart pointer to the frame, or a pointer to 0 if the buffer is empty
+   */
+  Ptr<Packet> ExtractFrame (void);
+
   /**
    * Get the total amount of data received in a stream
    * which has received a frame with the FIN bit set
@@ -166,10 +187,30 @@ public:
   uint32_t Size (void) const;
 
 private:
-  // TODO consider replacing std::vector with a ordered data structure
-  typedef std::vector<QuicStreamRxItem*> QuicStreamRxPacketList;  //!< container for data stored in the buffer
+  typedef std::map<uint64_t, QuicStreamRxItem*> QuicStreamRxPacketList;  //!< container for data stored in the buffer, keyed by offset
+  typedef std::map<uint64_t, uint64_t> QuicStreamRxRangeMap;             //!< first offset -> offset past the last byte of a range
+
+  /**
+   * \brief Get an item, reusing the storage of a released one if possible
+   * \return an empty item
+   */
+  QuicStreamRxItem* AllocateItem (void);
+
+  /**
+   * \brief Give back the storage of an item which left the buffer
+   * \param item the item
+   */
+  void ReleaseItem (QuicStreamRxItem *item);
+
+  /**
+   * \brief Remove the item with the lowest offset, updating the ranges and the buffer occupancy
+   * \return the item removed, to be released by the caller
+   */
+  QuicStreamRxItem* RemoveFirst (void);
 
   QuicStreamRxPacketList m_streamRecvList;  //!< List of received packets with additional info
+  QuicStreamRxRangeMap m_ranges;            //!< disjoint, non-adjacent byte ranges held in the buffer
+  std::vector<QuicStreamRxItem*> m_itemPool; //!< released items available for reuse
   TracedValue<uint32_t> m_numBytesInBuffer;              //!< Current buffer occupancy
   uint32_t m_finalSize;                     //!< Final buffer size
   uint32_t m_maxBuffer;                     //!< Maximum buffer size
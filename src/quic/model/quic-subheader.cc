@@ -28,6 +28,7 @@
 #include "ns3/buffer.h"
 #include "ns3/address-utils.h"
 #include "ns3/log.h"
+#include "ns3/packet.h"
 
 namespace ns3 {
 
@@ -56,8 +57,6 @@ QuicSubheader::QuicSubheader ()
     m_pathId (0)
 {
   m_reasonPhrase = std::vector<uint8_t> ();
-  m_additionalAckBlocks = std::vector<uint32_t> ();
-  m_gaps = std::vector<uint32_t> ();
 }
 
 QuicSubheader::~QuicSubheader ()
@@ -1069,6 +1068,60 @@ QuicSubheader::ReadVarInt64 (Buffer::Iterator& i)
   return bytestream64;
 }
 
+/**
+ * \brief Read a variable-length integer from a byte array
+ *
+ * \param data the array, advanced past the integer
+ * \param end the end of the array
+ * \param varInt64 the integer
+ * \return false if the array ends before the integer
+ */
+static bool
+ReadVarInt64FromBytes (const uint8_t *&data, const uint8_t *end, uint64_t &varInt64)
+{
+  if (data == end)
+    {
+      return false;
+    }
+  uint32_t size = 1 << (*data >> 6);
+  if ((uint32_t) (end - data) < size)
+    {
+      return false;
+    }
+  varInt64 = *data++ & 0b00111111;
+  for (uint32_t j = 1; j < size; j++)
+    {
+      varInt64 = (varInt64 << 8) | *data++;
+    }
+  return true;
+}
+
+bool
+QuicSubheader::PeekStreamIdAndOffset (Ptr<const Packet> packet, uint64_t &streamId, uint64_t &offset)
+{
+  // frame type, stream ID and offset, at most 8 bytes each
+  uint8_t buffer[17];
+  uint32_t size = packet->CopyData (buffer, sizeof (buffer));
+  const uint8_t *data = buffer + 1;
+  const uint8_t *end = buffer + size;
+
+  if (size > 0 and buffer[0] >= STREAM000 and buffer[0] <= STREAM111)
+    {
+      offset = 0;
+      if (ReadVarInt64FromBytes (data, end, streamId)
+          and (!(buffer[0] & 0x04) or ReadVarInt64FromBytes (data, end, offset)))
+        {
+          return true;
+        }
+    }
+
+  QuicSubheader sub;
+  packet->PeekHeader (sub);
+  streamId = sub.GetStreamId ();
+  offset = sub.GetOffset ();
+  return sub.IsStream ();
+}
+
 uint32_t
 QuicSubheader::GetVarInt64Size (uint64_t varInt64)
 {
@@ -1280,7 +1333,7 @@ QuicSubheader::CreateStopSending (uint64_t streamId, uint16_t applicationErrorCo
 }
 
 QuicSubheader
-QuicSubheader::CreateAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, std::vector<uint32_t>& gaps, std::vector<uint32_t>& additionalAckBlocks)
+QuicSubheader::CreateAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, const QuicAckBlocks& gaps, const QuicAckBlocks& additionalAckBlocks)
 {
   NS_LOG_INFO ("Created Ack Header");
 
@@ -1461,12 +1514,12 @@ void QuicSubheader::SetAckBlockCount (uint32_t ackBlockCount)
   m_ackBlockCount = ackBlockCount;
 }
 
-const std::vector<uint32_t>& QuicSubheader::GetAdditionalAckBlocks () const
+const QuicAckBlocks& QuicSubheader::GetAdditionalAckBlocks () const
 {
   return m_additionalAckBlocks;
 }
 
-void QuicSubheader::SetAdditionalAckBlocks (const std::vector<uint32_t>& ackBlocks)
+void QuicSubheader::SetAdditionalAckBlocks (const QuicAckBlocks& ackBlocks)
 {
   m_additionalAckBlocks = ackBlocks;
 }
@@ -1521,12 +1574,12 @@ void QuicSubheader::SetFrameType (uint8_t frameType)
   m_frameType = frameType;
 }
 
-const std::vector<uint32_t>& QuicSubheader::GetGaps () const
+const QuicAckBlocks& QuicSubheader::GetGaps () const
 {
   return m_gaps;
 }
 
-void QuicSubheader::SetGaps (const std::vector<uint32_t>& gaps)
+void QuicSubheader::SetGaps (const QuicAckBlocks& gaps)
 {
   m_gaps = gaps;
 }
@@ -1695,7 +1748,7 @@ QuicSubheader::CreateRemoveAddress(Address addr, uint8_t pathId)
 
 
 QuicSubheader
-QuicSubheader::CreateMpAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, std::vector<uint32_t>& gaps, std::vector<uint32_t>& additionalAckBlocks, uint8_t pathId)
+QuicSubheader::CreateMpAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, const QuicAckBlocks& gaps, const QuicAckBlocks& additionalAckBlocks, uint8_t pathId)
 {
   NS_LOG_INFO ("Created Ack Header");
 
@@ -31,9 +31,20 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/sequence-number.h"
+#include "ns3/ptr.h"
+#include "quic-inline-vector.h"
 
 namespace ns3 {
 
+class Packet;
+
+/**
+ * \ingroup quic
+ *
+ * Gaps and additional blocks of an ACK frame, stored inline up to the usual number of blocks
+ */
+typedef QuicInlineVector<uint32_t, 8> QuicAckBlocks;
+
 /**
  * \ingroup quic
  * \brief SubHeader for the QUIC Protocol
@@ -216,6 +227,20 @@ public:
    **/
   static uint32_t GetVarInt64Size (uint64_t varInt64);
 
+  /**
+   * \brief Read the stream ID and offset of the subheader at the start of a packet
+   *
+   * STREAM frames are parsed straight from the first bytes of the packet,
+   * without deserializing a full QuicSubheader; other frames fall back
+   * to PeekHeader.
+   *
+   * \param packet the packet
+   * \param streamId the stream ID of the frame
+   * \param offset the offset of the frame, 0 if not carried
+   * \return true if the frame is a STREAM frame
+   */
+  static bool PeekStreamIdAndOffset (Ptr<const Packet> packet, uint64_t &streamId, uint64_t &offset);
+
   /**
    * Create a Padding subheader
    *
@@ -337,7 +362,7 @@ public:
    * \param additionalAckBlocks the vector where each field contains the number of contiguous acknowledged packets preceding the largest packet number
    * \return the generated QuicSubheader
    */
-  static QuicSubheader CreateAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, std::vector<uint32_t>& gaps, std::vector<uint32_t>& additionalAckBlocks);
+  static QuicSubheader CreateAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, const QuicAckBlocks& gaps, const QuicAckBlocks& additionalAckBlocks);
 
   /**
    * Create a Path Response subheader
@@ -386,13 +411,13 @@ public:
    * \brief Get the additional ack block vector
    * \return The additional ack block vector for this QuicSubheader
    */
-  const std::vector<uint32_t>& GetAdditionalAckBlocks () const;
+  const QuicAckBlocks& GetAdditionalAckBlocks () const;
 
   /**
    * \brief Set the additional ack block vector
    * \param ackBlocks the additional ack block vector for this QuicSubheader
    */
-  void SetAdditionalAckBlocks (const std::vector<uint32_t>& ackBlocks);
+  void SetAdditionalAckBlocks (const QuicAckBlocks& ackBlocks);
 
   /**
    * \brief Get the ack delay
@@ -458,13 +483,13 @@ public:
    * \brief Get the gap vector
    * \return The gap vector for this QuicSubheader
    */
-  const std::vector<uint32_t>& GetGaps () const;
+  const QuicAckBlocks& GetGaps () const;
 
   /**
    * \brief Set the gap vector
    * \param gaps the gap for this QuicSubheader
    */
-  void SetGaps (const std::vector<uint32_t>& gaps);
+  void SetGaps (const QuicAckBlocks& gaps);
 
   /**
    * \brief Get the largest acknowledged
@@ -787,7 +812,7 @@ public:
    * 
    * \return the generated QuicSubheader
    */
-  static QuicSubheader CreateMpAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, std::vector<uint32_t>& gaps, std::vector<uint32_t>& additionalAckBlocks,uint8_t pathId);
+  static QuicSubheader CreateMpAck (uint32_t largestAcknowledged, uint64_t ackDelay, uint32_t firstAckBlock, const QuicAckBlocks& gaps, const QuicAckBlocks& additionalAckBlocks,uint8_t pathId);
 
   static QuicSubheader CreatePathAbandon (uint8_t pathId, uint16_t m_errorCode);
 
@@ -839,8 +864,8 @@ private:
   uint32_t m_ackDelay;                          //!< Ack delay
   uint32_t m_ackBlockCount;                     //!< Ack block count
   uint32_t m_firstAckBlock;                     //!< First Ack block
-  std::vector<uint32_t> m_additionalAckBlocks;  //!< Additional ack blocks vector
-  std::vector<uint32_t> m_gaps;                 //!< Gaps vector
+  QuicAckBlocks m_additionalAckBlocks;          //!< Additional ack blocks vector
+  QuicAckBlocks m_gaps;                         //!< Gaps vector
   uint8_t m_data;                               //!< Data word
   uint64_t m_length;                            //!< Length
   uint8_t m_pathId;                            //!< Multipath Implementation: Path Id
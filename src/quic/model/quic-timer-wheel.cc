@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "quic-timer-wheel.h"
+#include "quic-lazy-timer.h"
+
+#include <algorithm>
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QuicTimerWheel");
+
+QuicTimerWheel::QuicTimerWheel ()
+  : m_event (),
+    m_eventTime (Seconds (0)),
+    m_nArms (0),
+    m_nEvents (0),
+    m_expiring (false)
+{
+}
+
+QuicTimerWheel::~QuicTimerWheel ()
+{
+  m_event.Cancel ();
+  // the timers may outlive the wheel, e.g. in a subflow still referenced elsewhere
+  for (QuicLazyTimer *timer : m_timers)
+    {
+      timer->m_wheel = 0;
+    }
+}
+
+void
+QuicTimerWheel::Attach (QuicLazyTimer *timer)
+{
+  NS_LOG_FUNCTION (this << timer);
+  if (std::find (m_timers.begin (), m_timers.end (), timer) == m_timers.end ())
+    {
+      m_timers.push_back (timer);
+    }
+}
+
+void
+QuicTimerWheel::Detach (QuicLazyTimer *timer)
+{
+  NS_LOG_FUNCTION (this << timer);
+  std::vector<QuicLazyTimer *>::iterator it = std::find (m_timers.begin (), m_timers.end (), timer);
+  if (it != m_timers.end ())
+    {
+      m_timers.erase (it);
+    }
+  // a timer detached while the others expire must not be invoked
+  std::replace (m_due.begin (), m_due.end (), timer, static_cast<QuicLazyTimer *> (0));
+}
+
+void
+QuicTimerWheel::Update (QuicLazyTimer *timer)
+{
+  timer->m_armOrder = ++m_nArms;
+  Wait (timer->m_end);
+}
+
+void
+QuicTimerWheel::Wait (Time deadline)
+{
+  if (m_expiring)
+    {
+      // Expire looks for the earliest deadline once all the timers are served
+      return;
+    }
+  if (m_event.IsRunning ())
+    {
+      if (m_eventTime <= deadline)
+        {
+          // the pending event will find the new deadline when it fires
+          return;
+        }
+      // removed rather than cancelled, so that the queue holds a single event
+      Simulator::Remove (m_event);
+    }
+  Arm (deadline);
+}
+
+uint32_t
+QuicTimerWheel::GetNTimers (void) const
+{
+  return m_timers.size ();
+}
+
+uint64_t
+QuicTimerWheel::GetNEvents (void) const
+{
+  return m_nEvents;
+}
+
+void
+QuicTimerWheel::Arm (Time deadline)
+{
+  m_eventTime = deadline;
+  m_event = Simulator::Schedule (deadline - Simulator::Now (), &QuicTimerWheel::Expire, this);
+  ++m_nEvents;
+}
+
+void
+QuicTimerWheel::Expire (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
+
+  m_due.clear ();
+  for (QuicLazyTimer *timer : m_timers)
+    {
+      if (timer->m_running and timer->m_end <= now)
+        {
+          m_due.push_back (timer);
+        }
+    }
+  std::sort (m_due.begin (), m_due.end (),
+             [] (const QuicLazyTimer *a, const QuicLazyTimer *b)
+             {
+               return a->m_end < b->m_end or (a->m_end == b->m_end and a->m_armOrder < b->m_armOrder);
+             });
+
+  // an expiring timer may arm timers, or attach and detach them
+  m_expiring = true;
+  for (uint32_t i = 0; i < m_due.size (); i++)
+    {
+      QuicLazyTimer *timer = m_due[i];
+      if (timer != 0 and timer->m_running and timer->m_end <= now)
+        {
+          NS_ASSERT_MSG (timer->m_impl != 0, "No function set for the QuicLazyTimer");
+          timer->m_running = false;
+          timer->m_impl->Invoke ();
+        }
+    }
+  m_due.clear ();
+  m_expiring = false;
+
+  Time next = Time::Max ();
+  for (QuicLazyTimer *timer : m_timers)
+    {
+      if (timer->m_running and timer->m_end < next)
+        {
+          next = timer->m_end;
+        }
+    }
+  if (next != Time::Max ())
+    {
+      Wait (std::max (next, now));
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "quic-trace-recorder.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QuicTraceRecorder");
+
+QuicTraceRecorder &
+QuicTraceRecorder::Get (void)
+{
+  static QuicTraceRecorder recorder;
+  return recorder;
+}
+
+const char *
+QuicTraceRecorder::GetEventName (uint16_t type)
+{
+  switch (type)
+    {
+    case STREAM_RECV:
+      return "STREAM_RECV";
+    case STREAM_SPLIT:
+      return "STREAM_SPLIT";
+    case PACKET_SENT:
+      return "PACKET_SENT";
+    case ACK_RECEIVED:
+      return "ACK_RECEIVED";
+    default:
+      return "UNKNOWN";
+    }
+}
+
+QuicTraceRecorder::QuicTraceRecorder ()
+  : m_capacity (65536),
+    m_recorded (0)
+{
+}
+
+void
+QuicTraceRecorder::SetCapacity (uint32_t capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  NS_ASSERT (capacity > 0);
+  m_capacity = capacity;
+  m_events.clear ();
+  m_recorded = 0;
+}
+
+uint32_t
+QuicTraceRecorder::GetCapacity (void) const
+{
+  return m_capacity;
+}
+
+void
+QuicTraceRecorder::Record (EventType type, uint16_t id, uint64_t a, uint64_t b, uint64_t c)
+{
+  if (m_events.empty ())
+    {
+      // allocated on the first event, so that builds without tracing do not pay for it
+      m_events.resize (m_capacity);
+    }
+  QuicTraceEvent &event = m_events[m_recorded % m_capacity];
+  event.m_time = Simulator::Now ().GetTimeStep ();
+  event.m_context = Simulator::GetContext ();
+  event.m_type = type;
+  event.m_id = id;
+  event.m_values[0] = a;
+  event.m_values[1] = b;
+  event.m_values[2] = c;
+  m_recorded++;
+  m_eventTrace (event);
+}
+
+uint64_t
+QuicTraceRecorder::GetNumRecorded (void) const
+{
+  return m_recorded;
+}
+
+uint32_t
+QuicTraceRecorder::GetSize (void) const
+{
+  return std::min<uint64_t> (m_recorded, m_capacity);
+}
+
+const QuicTraceEvent &
+QuicTraceRecorder::GetEvent (uint32_t index) const
+{
+  NS_ASSERT (index < GetSize ());
+  return m_events[(m_recorded - GetSize () + index) % m_capacity];
+}
+
+void
+QuicTraceRecorder::Clear (void)
+{
+  m_recorded = 0;
+}
+
+void
+QuicTraceRecorder::Dump (std::ostream &os) const
+{
+  for (uint32_t i = 0; i < GetSize (); i++)
+    {
+      const QuicTraceEvent &event = GetEvent (i);
+      os << TimeStep (event.m_time).GetSeconds () << "\t" << event.m_context << "\t"
+         << GetEventName (event.m_type) << "\t" << event.m_id << "\t"
+         << event.m_values[0] << "\t" << event.m_values[1] << "\t" << event.m_values[2] << "\n";
+    }
+}
+
+void
+QuicTraceRecorder::DumpBinary (std::ostream &os) const
+{
+  for (uint32_t i = 0; i < GetSize (); i++)
+    {
+      os.write (reinterpret_cast<const char *> (&GetEvent (i)), sizeof (QuicTraceEvent));
+    }
+}
+
+void
+QuicTraceRecorder::ConnectWithoutContext (const CallbackBase &cb)
+{
+  m_eventTrace.ConnectWithoutContext (cb);
+}
+
+void
+QuicTraceRecorder::DisconnectWithoutContext (const CallbackBase &cb)
+{
+  m_eventTrace.DisconnectWithoutContext (cb);
+}
+
+} // namespace ns3
@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef QUICTRACERECORDER_H
+#define QUICTRACERECORDER_H
+
+#include <ostream>
+#include <vector>
+#include <stdint.h>
+#include "ns3/traced-callback.h"
+
+/**
+ * \ingroup quic
+ *
+ * \brief Record an event of the QUIC data path in the QuicTraceRecorder
+ *
+ * The events are only recorded if ns-3 was configured with
+ * --enable-quic-trace; otherwise the macro, and its arguments, compile to
+ * nothing.
+ *
+ * \param type the QuicTraceRecorder::EventType of the event
+ * \param id the stream or path ID the event refers to
+ * \param a first value of the event
+ * \param b second value of the event
+ * \param c third value of the event
+ */
+#ifdef NS3_QUIC_TRACE
+#define QUIC_TRACE(type, id, a, b, c)                                   \
+  ns3::QuicTraceRecorder::Get ().Record (ns3::QuicTraceRecorder::type, id, a, b, c)
+#else
+#define QUIC_TRACE(type, id, a, b, c)           \
+  do                                            \
+    {                                           \
+    }                                           \
+  while (false)
+#endif
+
+namespace ns3 {
+
+/**
+ * \ingroup quic
+ *
+ * \brief An event of the QUIC data path, as stored by QuicTraceRecorder
+ */
+struct QuicTraceEvent
+{
+  int64_t m_time;         //!< Simulation time of the event, in time steps
+  uint32_t m_context;     //!< Simulator context (node ID) of the event
+  uint16_t m_type;        //!< QuicTraceRecorder::EventType of the event
+  uint16_t m_id;          //!< Stream or path ID the event refers to
+  uint64_t m_values[3];   //!< Values of the event, depending on its type
+};
+
+/**
+ * \ingroup quic
+ *
+ * \brief Ring buffer of the last events of the QUIC data path
+ *
+ * Events are fixed-size binary records, written with the QUIC_TRACE macro
+ * from the per-packet code paths instead of printing them. The buffer keeps
+ * the last GetCapacity () events; they can be dumped on demand, as text or
+ * as raw records, and each event is also passed to the callbacks connected
+ * with ConnectWithoutContext.
+ *
+ * Recording is compiled in only if ns-3 was configured with
+ * --enable-quic-trace.
+ */
+class QuicTraceRecorder
+{
+public:
+  /**
+   * \brief Types of the events, and meaning of their values
+   */
+  enum EventType
+  {
+    STREAM_RECV = 1,    //!< STREAM frame received: stream ID, expected offset, frame offset, rx buffer size
+    STREAM_SPLIT,       //!< STREAM frame split to fit a packet: stream ID, offset, bytes sent, bytes put back
+    PACKET_SENT,        //!< Packet sent: path ID, packet number, size, bytes in flight
+    ACK_RECEIVED        //!< ACK received: path ID, largest acknowledged, bytes acked, bytes in flight
+  };
+
+  /**
+   * \brief Callback signature for the recorded events
+   *
+   * \param [in] event the event
+   */
+  typedef void (*EventTracedCallback)(const QuicTraceEvent &event);
+
+  /**
+   * \return the recorder shared by all the QUIC sockets of the simulation
+   */
+  static QuicTraceRecorder &Get (void);
+
+  /**
+   * \param type the type of an event
+   * \return the name of the type
+   */
+  static const char *GetEventName (uint16_t type);
+
+  QuicTraceRecorder ();
+
+  /**
+   * \brief Set the number of events kept, dropping the recorded ones
+   *
+   * \param capacity the number of events
+   */
+  void SetCapacity (uint32_t capacity);
+
+  /**
+   * \return the number of events kept
+   */
+  uint32_t GetCapacity (void) const;
+
+  /**
+   * \brief Record an event at the current simulation time
+   *
+   * \param type the type of the event
+   * \param id the stream or path ID the event refers to
+   * \param a first value of the event
+   * \param b second value of the event
+   * \param c third value of the event
+   */
+  void Record (EventType type, uint16_t id, uint64_t a, uint64_t b, uint64_t c);
+
+  /**
+   * \return the number of events recorded since the last Clear, including the dropped ones
+   */
+  uint64_t GetNumRecorded (void) const;
+
+  /**
+   * \return the number of events in the buffer
+   */
+  uint32_t GetSize (void) const;
+
+  /**
+   * \param index the index of the event, 0 being the oldest in the buffer
+   * \return the event
+   */
+  const QuicTraceEvent &GetEvent (uint32_t index) const;
+
+  /**
+   * \brief Drop all the events
+   */
+  void Clear (void);
+
+  /**
+   * \brief Write the events in the buffer as text, one per line, oldest first
+   *
+   * \param os the output stream
+   */
+  void Dump (std::ostream &os) const;
+
+  /**
+   * \brief Write the events in the buffer as raw QuicTraceEvent records, oldest first
+   *
+   * \param os the output stream
+   */
+  void DumpBinary (std::ostream &os) const;
+
+  /**
+   * \brief Pass each recorded event to a callback
+   *
+   * \param cb the callback
+   */
+  void ConnectWithoutContext (const CallbackBase &cb);
+
+  /**
+   * \brief Stop passing the recorded events to a callback
+   *
+   * \param cb the callback
+   */
+  void DisconnectWithoutContext (const CallbackBase &cb);
+
+private:
+  uint32_t m_capacity;                                   //!< Number of events kept
+  std::vector<QuicTraceEvent> m_events;                  //!< Ring buffer of the events
+  uint64_t m_recorded;                                   //!< Events recorded since the last Clear
+  TracedCallback<const QuicTraceEvent &> m_eventTrace;   //!< Trace of the recorded events
+};
+
+} // namespace ns3
+
+#endif /* QUICTRACERECORDER_H */
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+
+#include "ns3/mp-quic-coupled-state.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MpQuicCoupledStateTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the incremental aggregates of MpQuicCoupledState against a full scan of the paths
+ *
+ * Random paths are updated with random windows, RTTs (some of them not
+ * measured) and loss intervals; after each update, the totals and the best
+ * paths must match the ones computed from all the paths.
+ */
+class MpQuicCoupledStateTestCase : public TestCase
+{
+public:
+  MpQuicCoupledStateTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+MpQuicCoupledStateTestCase::MpQuicCoupledStateTestCase () :
+    TestCase ("MpQuicCoupledState Test")
+{
+}
+
+void
+MpQuicCoupledStateTestCase::DoRun ()
+{
+  const uint8_t paths = 4;
+  MpQuicCoupledState state;
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) state.GetNumPaths (), 0, "No path was reported");
+  NS_TEST_ASSERT_MSG_EQ (state.GetMaxCwndPath (), -1, "No path was reported");
+
+  uint32_t cWnd[paths] = {0};
+  double rtt[paths] = {0};
+  uint32_t lossInterval[paths] = {0};
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+  for (uint32_t step = 0; step < 10000; step++)
+    {
+      uint8_t pathId = rng->GetInteger (0, paths - 1);
+      cWnd[pathId] = rng->GetInteger (2400, 200000);
+      rtt[pathId] = (rng->GetValue () < 0.1) ? 0 : rng->GetValue (0.005, 0.2);
+      lossInterval[pathId] = rng->GetInteger (0, 1000000);
+      state.UpdatePath (pathId, cWnd[pathId], rtt[pathId], lossInterval[pathId]);
+
+      uint8_t numPaths = 0;
+      double totalCwnd = 0;
+      double sumRate = 0;
+      double maxRate = 0;
+      double maxCwndOverRttSquared = 0;
+      int16_t maxCwndPath = -1;
+      int16_t bestRatePath = -1;
+      int16_t bestLossIntervalPath = -1;
+      for (uint8_t i = 0; i < paths; i++)
+        {
+          if (rtt[i] == 0)
+            {
+              continue;
+            }
+          double rate = cWnd[i] / rtt[i];
+          double lossRate = (double) lossInterval[i] * lossInterval[i] / (rtt[i] * rtt[i]);
+          numPaths++;
+          totalCwnd += cWnd[i];
+          sumRate += rate;
+          maxCwndOverRttSquared = std::max (maxCwndOverRttSquared, rate / rtt[i]);
+          if (maxCwndPath < 0 || cWnd[i] > cWnd[maxCwndPath])
+            {
+              maxCwndPath = i;
+            }
+          if (bestRatePath < 0 || rate > maxRate)
+            {
+              bestRatePath = i;
+              maxRate = rate;
+            }
+          if (bestLossIntervalPath < 0
+              || lossRate > (double) lossInterval[bestLossIntervalPath] * lossInterval[bestLossIntervalPath]
+                 / (rtt[bestLossIntervalPath] * rtt[bestLossIntervalPath]))
+            {
+              bestLossIntervalPath = i;
+            }
+        }
+
+      NS_TEST_ASSERT_MSG_EQ ((uint16_t) state.GetNumPaths (), (uint16_t) numPaths, "Wrong number of paths at step " << step);
+      NS_TEST_ASSERT_MSG_EQ_TOL (state.GetTotalCwnd (), totalCwnd, 1e-6 * totalCwnd + 1e-6, "Wrong total window at step " << step);
+      NS_TEST_ASSERT_MSG_EQ_TOL (state.GetSumRate (), sumRate, 1e-6 * sumRate + 1e-6, "Wrong sum of rates at step " << step);
+      NS_TEST_ASSERT_MSG_EQ_TOL (state.GetMaxRate (), maxRate, 1e-9 * maxRate, "Wrong max rate at step " << step);
+      NS_TEST_ASSERT_MSG_EQ_TOL (state.GetMaxCwndOverRttSquared (), maxCwndOverRttSquared,
+                                 1e-9 * maxCwndOverRttSquared, "Wrong max cWnd/rtt^2 at step " << step);
+      NS_TEST_ASSERT_MSG_EQ (state.GetMaxCwndPath (), maxCwndPath, "Wrong largest window path at step " << step);
+      NS_TEST_ASSERT_MSG_EQ (state.GetBestRatePath (), bestRatePath, "Wrong best rate path at step " << step);
+      NS_TEST_ASSERT_MSG_EQ (state.GetBestLossIntervalPath (), bestLossIntervalPath, "Wrong OLIA best path at step " << step);
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the MpQuicCoupledState test case
+ */
+class MpQuicCoupledStateTestSuite : public TestSuite
+{
+public:
+  MpQuicCoupledStateTestSuite () :
+      TestSuite ("mp-quic-coupled-state", UNIT)
+  {
+    AddTestCase (new MpQuicCoupledStateTestCase, TestCase::QUICK);
+  }
+};
+static MpQuicCoupledStateTestSuite g_mpQuicCoupledStateTestSuite;
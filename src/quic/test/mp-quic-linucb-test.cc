@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <cmath>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+
+#include "ns3/mp-quic-linucb.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MpQuicLinUcbTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the incremental LinUCB arms against a full inversion of A at every decision
+ *
+ * Two arms play against each other, as the fastest and the slow path do in
+ * the Peekaboo scheduler, over random contexts and rewards. The choices of
+ * MpQuicLinUcbArm must be the same as those of the reference implementation.
+ */
+class MpQuicLinUcbTestCase : public TestCase
+{
+public:
+  MpQuicLinUcbTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+MpQuicLinUcbTestCase::MpQuicLinUcbTestCase () :
+    TestCase ("MpQuicLinUcb Test")
+{
+}
+
+void
+MpQuicLinUcbTestCase::DoRun ()
+{
+  const int dim = MpQuicLinUcbArm::DIM;
+  const double alpha = 0.8;
+  const uint32_t decisions = 5000;
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  MpQuicLinUcbArm arms[2] = {MpQuicLinUcbArm (alpha), MpQuicLinUcbArm (alpha)};
+  Eigen::MatrixXd refA[2] = {Eigen::MatrixXd::Identity (dim, dim), Eigen::MatrixXd::Identity (dim, dim)};
+  Eigen::VectorXd refB[2] = {Eigen::VectorXd::Zero (dim), Eigen::VectorXd::Zero (dim)};
+
+  double reward = 0;
+  uint32_t choices[2] = {0, 0};
+  for (uint32_t n = 0; n < decisions; n++)
+    {
+      MpQuicLinUcbArm::Vector x;
+      Eigen::VectorXd refX (dim);
+      for (int j = 0; j < dim; j++)
+        {
+          x[j] = refX[j] = rng->GetValue (0, 1);
+        }
+      reward += rng->GetValue (0, 1);
+
+      double refScore[2];
+      for (int i = 0; i < 2; i++)
+        {
+          Eigen::MatrixXd inverse = refA[i].inverse ();
+          Eigen::VectorXd theta = inverse * refB[i];
+          refScore[i] = refX.dot (theta) + alpha * std::sqrt (refX.transpose () * inverse * refX);
+
+          double score = arms[i].GetScore (x);
+          NS_TEST_ASSERT_MSG_EQ_TOL (score, refScore[i], 1e-9 * std::abs (refScore[i]), "Wrong score for arm " << i);
+          // A second query with the same context is served from the cache
+          NS_TEST_ASSERT_MSG_EQ (arms[i].GetScore (x), score, "Cached score differs");
+        }
+
+      int refChoice = refScore[0] > refScore[1] ? 0 : 1;
+      int choice = arms[0].GetScore (x) > arms[1].GetScore (x) ? 0 : 1;
+      NS_TEST_ASSERT_MSG_EQ (choice, refChoice, "Different choice at decision " << n);
+      choices[choice]++;
+
+      refA[refChoice] += refX * refX.transpose ();
+      refB[refChoice] += reward * refX;
+      arms[choice].Update (x, reward);
+    }
+
+  // both arms must have been played for the comparison to be meaningful
+  NS_TEST_ASSERT_MSG_GT (choices[0], 0, "Arm 0 never chosen");
+  NS_TEST_ASSERT_MSG_GT (choices[1], 0, "Arm 1 never chosen");
+
+  for (int i = 0; i < 2; i++)
+    {
+      MpQuicLinUcbArm::Matrix identity = arms[i].GetA () * arms[i].GetAInverse ();
+      NS_TEST_ASSERT_MSG_LT ((identity - MpQuicLinUcbArm::Matrix::Identity ()).cwiseAbs ().maxCoeff (), 1e-9,
+                             "A^-1 of arm " << i << " drifted from the inverse of A");
+    }
+}
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the scores of a MpQuicLinUcbArm against values computed by hand
+ *
+ * The expected reward is the LinUCB estimate x' A^-1 b, not the x' A b the
+ * Peekaboo scheduler used before MpQuicLinUcbArm.
+ */
+class MpQuicLinUcbScoreTestCase : public TestCase
+{
+public:
+  MpQuicLinUcbScoreTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+MpQuicLinUcbScoreTestCase::MpQuicLinUcbScoreTestCase () :
+    TestCase ("MpQuicLinUcb hand-computed scores Test")
+{
+}
+
+void
+MpQuicLinUcbScoreTestCase::DoRun ()
+{
+  MpQuicLinUcbArm arm (0.8);
+  MpQuicLinUcbArm::Vector e1 = MpQuicLinUcbArm::Vector::Unit (0);
+  MpQuicLinUcbArm::Vector e2 = MpQuicLinUcbArm::Vector::Unit (1);
+  MpQuicLinUcbArm::Vector e12 = e1 + e2;
+
+  // A = I and b = 0: only the confidence width, 0.8 * sqrt (1)
+  NS_TEST_ASSERT_MSG_EQ_TOL (arm.GetScore (e1), 0.8, 1e-12, "Wrong score of a new arm");
+
+  // A = diag (2, 1, ...), b = (2, 0, ...): theta = (1, 0, ...), and
+  // 1 + 0.8 * sqrt (1 / 2), where x' A b would give 4
+  arm.Update (e1, 2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (arm.GetScore (e1), 1 + 0.8 * std::sqrt (0.5), 1e-12, "Wrong score after one update");
+  NS_TEST_ASSERT_MSG_EQ_TOL (arm.GetWidth (), 0.8 * std::sqrt (0.5), 1e-12, "Wrong confidence width");
+
+  // A = diag (2, 2, 1, ...), b = (2, 4, 0, ...): theta = (1, 2, 0, ...), and
+  // for (1, 1, 0, ...) 3 + 0.8 * sqrt (1 / 2 + 1 / 2), where x' A b would give 12
+  arm.Update (e2, 4);
+  NS_TEST_ASSERT_MSG_EQ_TOL (arm.GetScore (e12), 3.8, 1e-12, "Wrong score after two updates");
+
+  // A = [3 1; 1 3] on the first two coordinates, b = (3, 5, 0, ...):
+  // A^-1 = [3 -1; -1 3] / 8, theta = (1 / 2, 3 / 2, 0, ...), and for e1
+  // 1 / 2 + 0.8 * sqrt (3 / 8)
+  arm.Update (e12, 1);
+  NS_TEST_ASSERT_MSG_EQ_TOL (arm.GetScore (e1), 0.5 + 0.8 * std::sqrt (0.375), 1e-12, "Wrong score with correlated contexts");
+  NS_TEST_ASSERT_MSG_EQ_TOL (arm.GetScore (e2), 1.5 + 0.8 * std::sqrt (0.375), 1e-12, "Wrong score with correlated contexts");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the MpQuicLinUcbArm test case
+ */
+class MpQuicLinUcbTestSuite : public TestSuite
+{
+public:
+  MpQuicLinUcbTestSuite () :
+      TestSuite ("mp-quic-linucb", UNIT)
+  {
+    AddTestCase (new MpQuicLinUcbTestCase, TestCase::QUICK);
+    AddTestCase (new MpQuicLinUcbScoreTestCase, TestCase::QUICK);
+  }
+};
+static MpQuicLinUcbTestSuite g_mpQuicLinUcbTestSuite;
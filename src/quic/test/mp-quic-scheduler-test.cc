@@ -0,0 +1,341 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// This file defines the counting operator new of the test runner, to check
+// that scheduling decisions do not allocate
+#define QUIC_ALLOC_COUNTER
+
+#include <algorithm>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/integer.h"
+#include "ns3/uinteger.h"
+#include "ns3/packet.h"
+
+#include "ns3/quic-socket-base.h"
+#include "ns3/mp-quic-subflow.h"
+#include "ns3/mp-quic-scheduler.h"
+#include "ns3/quic-socket-tx-edf-scheduler.h"
+#include "ns3/quic-subheader.h"
+#include "ns3/quic-alloc-counter.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MpQuicSchedulerTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the path choices of MpQuicScheduler and that they do not allocate memory
+ */
+class MpQuicSchedulerTestCase : public TestCase
+{
+public:
+  MpQuicSchedulerTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Create a subflow
+   *
+   * \param pathId the path ID of the subflow
+   * \param srtt the smoothed RTT of the path
+   * \param cwnd the congestion window of the path
+   * \return the subflow
+   */
+  Ptr<MpQuicSubFlow> CreateSubflow (uint8_t pathId, Time srtt, uint32_t cwnd);
+
+  /**
+   * \brief Add a frame to the transmission buffer of a socket
+   *
+   * \param socket the socket
+   * \param streamId the stream of the frame
+   */
+  void AddFrame (Ptr<QuicSocketBase> socket, uint64_t streamId);
+
+  /**
+   * \brief Record a predicted deadline miss
+   *
+   * \param streamId the stream of the frame
+   * \param misses the number of predicted deadline misses of the stream
+   */
+  void PredictedDeadlineMiss (uint64_t streamId, uint32_t misses);
+
+  uint64_t m_missStreamId;  //!< Stream of the last predicted deadline miss
+  uint32_t m_misses;        //!< Number of predicted deadline misses traced
+};
+
+MpQuicSchedulerTestCase::MpQuicSchedulerTestCase () :
+    TestCase ("MpQuicScheduler Test"),
+    m_missStreamId (0),
+    m_misses (0)
+{
+}
+
+Ptr<MpQuicSubFlow>
+MpQuicSchedulerTestCase::CreateSubflow (uint8_t pathId, Time srtt, uint32_t cwnd)
+{
+  Ptr<MpQuicSubFlow> subflow = CreateObject<MpQuicSubFlow> ();
+  subflow->m_flowId = pathId;
+  subflow->SetSegSize (1200);
+  subflow->m_tcb->m_smoothedRtt = srtt;
+  subflow->m_tcb->m_lastRtt = srtt;
+  subflow->m_tcb->m_cWnd = cwnd;
+  subflow->m_subflowState = MpQuicSubFlow::Validating;
+  return subflow;
+}
+
+void
+MpQuicSchedulerTestCase::AddFrame (Ptr<QuicSocketBase> socket, uint64_t streamId)
+{
+  Ptr<Packet> p = Create<Packet> (1000);
+  p->AddHeader (QuicSubheader::CreateStreamSubHeader (streamId, 0, p->GetSize (), false, true, false));
+  socket->GetTxBuffer ()->Add (p);
+}
+
+void
+MpQuicSchedulerTestCase::PredictedDeadlineMiss (uint64_t streamId, uint32_t misses)
+{
+  m_missStreamId = streamId;
+  m_misses++;
+}
+
+void
+MpQuicSchedulerTestCase::DoRun ()
+{
+  std::vector<int> *check = new std::vector<int> (10);
+  delete check;
+  NS_TEST_ASSERT_MSG_GT (QuicAllocCounter::GetAllocations (), 0, "The allocations are not counted");
+
+  // Other suites of the test runner may enable the logs of the transmission
+  // buffer, whose messages would be counted as allocations of the scheduler
+  LogComponentDisable ("QuicSocketTxBuffer", LOG_LEVEL_ALL);
+
+  Ptr<QuicSocketBase> socket = CreateObject<QuicSocketBase> ();
+  socket->InitializeScheduling ();
+  std::vector<Ptr<MpQuicSubFlow> > subflows;
+  subflows.push_back (CreateSubflow (0, MilliSeconds (80), 12000));
+  subflows.push_back (CreateSubflow (1, MilliSeconds (20), 12000));
+  subflows.push_back (CreateSubflow (2, MilliSeconds (50), 24000));
+  subflows.push_back (CreateSubflow (3, MilliSeconds (30), 6000));
+  for (auto subflow : subflows)
+    {
+      socket->SubflowInsert (subflow);
+    }
+  NS_TEST_ASSERT_MSG_EQ (socket->GetActiveSubflows ().size (), 0, "No subflow should be active yet");
+  for (auto subflow : subflows)
+    {
+      subflow->m_subflowState = MpQuicSubFlow::Active;
+    }
+  NS_TEST_ASSERT_MSG_EQ (socket->GetActiveSubflows ().size (), 4, "The active subflows were not updated");
+
+  Ptr<MpQuicScheduler> scheduler = CreateObject<MpQuicScheduler> ();
+  scheduler->SetSocket (socket);
+  MpQuicPathSplit split;
+
+  // Path 1 is the fastest and has room in its window
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::MIN_RTT));
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.GetSize (), 1, "MinRTT uses a single path");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 1, "MinRTT should use the fastest path");
+  NS_TEST_ASSERT_MSG_EQ (split.Get (0).m_budget, 6000, "Wrong budget");
+
+  // A path going back to validation leaves the active set
+  subflows[3]->m_subflowState = MpQuicSubFlow::Validating;
+  NS_TEST_ASSERT_MSG_EQ (socket->GetActiveSubflows ().size (), 3, "The active subflows were not updated");
+  subflows[3]->m_subflowState = MpQuicSubFlow::Active;
+
+  int16_t types[] = {MpQuicScheduler::ROUND_ROBIN, MpQuicScheduler::MIN_RTT, MpQuicScheduler::BLEST,
+                     MpQuicScheduler::ECF, MpQuicScheduler::PEEKABOO, MpQuicScheduler::DEADLINE,
+                     MpQuicScheduler::REDUNDANT, MpQuicScheduler::SELECTIVE_REDUNDANT};
+  for (int16_t type : types)
+    {
+      scheduler->SetAttribute ("SchedulerType", IntegerValue (type));
+      // Exercise both the decisions taken when the fastest path has room in
+      // its window and the ones taken when no path has any
+      for (uint32_t maxData : {4294967295u, 0u})
+        {
+          socket->SetAttribute ("MaxData", UintegerValue (maxData));
+          // the first decision may size the per-path state of the scheduler
+          scheduler->GetNextPathIdToUse (6000, split);
+
+          uint64_t allocations = QuicAllocCounter::GetAllocations ();
+          for (uint32_t i = 0; i < 1000; i++)
+            {
+              scheduler->GetNextPathIdToUse (6000, split);
+              NS_ASSERT (split.GetSize () >= 1 && split.Get (0).m_pathId < 4);
+            }
+          NS_TEST_ASSERT_MSG_EQ (QuicAllocCounter::GetAllocations () - allocations, 0,
+                                 "Scheduler " << type << " allocated memory, max data " << maxData);
+        }
+    }
+
+  // A path held back by pacing is left out of the decision, and nothing is
+  // scheduled when pacing holds back every path
+  socket->SetAttribute ("MaxData", UintegerValue (4294967295u));
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::MIN_RTT));
+  for (auto subflow : subflows)
+    {
+      subflow->m_tcb->m_pacing = true;
+    }
+  subflows[1]->m_pacingTimer.Schedule (MilliSeconds (1));
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 3, "MinRTT should skip the path held back by pacing");
+  for (auto subflow : subflows)
+    {
+      if (!subflow->m_pacingTimer.IsRunning ())
+        {
+          subflow->m_pacingTimer.Schedule (MilliSeconds (1));
+        }
+    }
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.GetSize (), 0, "No path can send while pacing holds back every path");
+  for (auto subflow : subflows)
+    {
+      subflow->m_pacingTimer.Cancel ();
+      subflow->m_tcb->m_pacing = false;
+    }
+
+  // The schedulers return path IDs, which are no longer the positions in the
+  // active subflows once a lower-numbered path leaves the Active state
+  subflows[1]->m_subflowState = MpQuicSubFlow::Failed;
+  int16_t idTypes[] = {MpQuicScheduler::ROUND_ROBIN, MpQuicScheduler::MIN_RTT, MpQuicScheduler::BLEST,
+                       MpQuicScheduler::ECF, MpQuicScheduler::PEEKABOO, MpQuicScheduler::DEADLINE,
+                       MpQuicScheduler::REDUNDANT, MpQuicScheduler::SELECTIVE_REDUNDANT};
+  for (int16_t type : idTypes)
+    {
+      scheduler->SetAttribute ("SchedulerType", IntegerValue (type));
+      for (uint32_t maxData : {4294967295u, 0u})
+        {
+          socket->SetAttribute ("MaxData", UintegerValue (maxData));
+          for (uint32_t i = 0; i < 6; i++)
+            {
+              scheduler->GetNextPathIdToUse (6000, split);
+              for (uint8_t j = 0; j < split.GetSize (); j++)
+                {
+                  uint8_t pathId = split.Get (j).m_pathId;
+                  NS_TEST_ASSERT_MSG_EQ ((pathId == 0 || pathId == 2 || pathId == 3), true,
+                                         "Scheduler " << type << " used path " << (uint16_t) pathId
+                                         << ", max data " << maxData);
+                }
+            }
+        }
+    }
+
+  socket->SetAttribute ("MaxData", UintegerValue (4294967295u));
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::MIN_RTT));
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 3, "MinRTT should use the fastest active path");
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::REDUNDANT));
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.GetSize (), 3, "The segment should be copied on every active path");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 3, "The original should use the fastest active path");
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::ROUND_ROBIN));
+  std::vector<uint16_t> rrPaths;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      scheduler->GetNextPathIdToUse (6000, split);
+      rrPaths.push_back (split.Get (0).m_pathId);
+    }
+  std::sort (rrPaths.begin (), rrPaths.end ());
+  NS_TEST_ASSERT_MSG_EQ ((rrPaths == std::vector<uint16_t> {0, 2, 3}), true,
+                         "Round robin should cycle over the active paths");
+  subflows[1]->m_subflowState = MpQuicSubFlow::Active;
+
+  // The redundant scheduler sends a segment on the fastest path and copies it
+  // on every other active path
+  socket->SetAttribute ("MaxData", UintegerValue (4294967295u));
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::REDUNDANT));
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.GetSize (), 4, "The segment should be copied on every path");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 1, "The original should use the fastest path");
+  NS_TEST_ASSERT_MSG_EQ (split.Get (0).m_budget, socket->GetSegSize (), "Frames should be copied one segment at a time");
+  NS_TEST_ASSERT_MSG_EQ (split.Get (0).m_duplicate, false, "The first entry is the original");
+  for (uint8_t i = 1; i < split.GetSize (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (split.Get (i).m_duplicate, true, "The other entries are copies");
+      NS_TEST_ASSERT_MSG_NE ((uint16_t) split.Get (i).m_pathId, 1, "A copy on the path of the original");
+    }
+
+  // Without RTT variance or latency-critical streams the selective variant
+  // behaves like MinRTT
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::SELECTIVE_REDUNDANT));
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.GetSize (), 1, "The segment should not be copied");
+  subflows[1]->m_tcb->m_rttVar = MilliSeconds (15);
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.GetSize (), 4, "A path with a high RTT variance should trigger copies");
+  subflows[1]->m_tcb->m_rttVar = Time (0);
+
+  // The deadline scheduler places the frames with an EDF stream scheduler.
+  // Path 1 is expected to deliver in 10 ms but has no room in its window,
+  // path 3 delivers in 15 ms and the other paths are slower
+  subflows[1]->m_tcb->m_cWnd = 0;
+  Ptr<QuicSocketTxEdfScheduler> edf = CreateObject<QuicSocketTxEdfScheduler> ();
+  edf->SetLatency (1, MilliSeconds (30));
+  edf->SetLatency (2, MilliSeconds (12));
+  edf->SetLatency (3, MilliSeconds (5));
+  socket->GetTxBuffer ()->SetScheduler (edf);
+  scheduler->SetAttribute ("SchedulerType", IntegerValue (MpQuicScheduler::DEADLINE));
+  scheduler->TraceConnectWithoutContext ("PredictedDeadlineMiss",
+                                         MakeCallback (&MpQuicSchedulerTestCase::PredictedDeadlineMiss, this));
+
+  AddFrame (socket, 1);
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 3, "A path with room that meets the deadline should be used");
+  NS_TEST_ASSERT_MSG_EQ (split.Get (0).m_budget, socket->GetSegSize (), "Frames should be placed one segment at a time");
+
+  AddFrame (socket, 2);
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 1, "Only waiting for path 1 meets the deadline");
+
+  AddFrame (socket, 3);
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) split.Get (0).m_pathId, 3, "A late frame should be sent as soon as possible");
+  NS_TEST_ASSERT_MSG_EQ (m_misses, 1, "The deadline miss was not traced");
+  NS_TEST_ASSERT_MSG_EQ (m_missStreamId, 3, "The deadline miss was traced for the wrong stream");
+  NS_TEST_ASSERT_MSG_EQ (scheduler->GetPredictedDeadlineMisses (3), 1, "The deadline miss was not counted");
+  NS_TEST_ASSERT_MSG_EQ (scheduler->GetPredictedDeadlineMisses (2), 0, "Stream 2 can meet its deadline");
+
+  // The late frame is not counted again
+  scheduler->GetNextPathIdToUse (6000, split);
+  NS_TEST_ASSERT_MSG_EQ (scheduler->GetPredictedDeadlineMisses (3), 1, "The deadline miss was counted twice");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the MpQuicScheduler test case
+ */
+class MpQuicSchedulerTestSuite : public TestSuite
+{
+public:
+  MpQuicSchedulerTestSuite () :
+      TestSuite ("mp-quic-scheduler", UNIT)
+  {
+    AddTestCase (new MpQuicSchedulerTestCase, TestCase::QUICK);
+  }
+};
+static MpQuicSchedulerTestSuite g_mpQuicSchedulerTestSuite;
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+#include "ns3/quic-ack-range-tracker.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("QuicAckRangeTrackerTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the ranges of QuicAckRangeTracker and the ACK blocks built from them
+ */
+class QuicAckRangeTrackerTestCase : public TestCase
+{
+public:
+  QuicAckRangeTrackerTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+QuicAckRangeTrackerTestCase::QuicAckRangeTrackerTestCase () :
+    TestCase ("QuicAckRangeTracker Test")
+{
+}
+
+void
+QuicAckRangeTrackerTestCase::DoRun ()
+{
+  QuicAckRangeTracker tracker;
+  QuicAckBlocks gaps;
+  QuicAckBlocks blocks;
+  NS_TEST_ASSERT_MSG_EQ (tracker.IsEmpty (), true, "A new tracker should be empty");
+
+  // In-order packet numbers extend a single range
+  for (uint32_t pn = 1; pn <= 3; pn++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (tracker.Add (SequenceNumber32 (pn)), true, "A new packet number was rejected");
+      NS_TEST_ASSERT_MSG_EQ (tracker.IsOutOfOrder (), false, "Packet " << pn << " is in order");
+    }
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 1, "In-order packets should form one range");
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetLargest (), SequenceNumber32 (3), "Wrong largest packet number");
+  NS_TEST_ASSERT_MSG_EQ (tracker.Add (SequenceNumber32 (2)), false, "A duplicate was accepted");
+
+  // Packets 4 and 6 to 7 are missing: ranges [1, 3], [5, 5] and [8, 9]
+  tracker.Add (SequenceNumber32 (5));
+  NS_TEST_ASSERT_MSG_EQ (tracker.IsOutOfOrder (), true, "Packet 5 opens a gap");
+  tracker.Add (SequenceNumber32 (8));
+  tracker.Add (SequenceNumber32 (9));
+  NS_TEST_ASSERT_MSG_EQ (tracker.IsOutOfOrder (), false, "Packet 9 extends the largest range");
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 3, "Wrong number of ranges");
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetLargest (), SequenceNumber32 (9), "Wrong largest packet number");
+
+  tracker.GetAckBlocks (gaps, blocks, 8);
+  NS_TEST_ASSERT_MSG_EQ (gaps.size (), 2, "Wrong number of gaps");
+  NS_TEST_ASSERT_MSG_EQ (blocks.size (), 2, "Wrong number of blocks");
+  NS_TEST_ASSERT_MSG_EQ (gaps[0], 7, "The first gap ends below packet 8");
+  NS_TEST_ASSERT_MSG_EQ (blocks[0], 5, "The second block ends at packet 5");
+  NS_TEST_ASSERT_MSG_EQ (gaps[1], 4, "The second gap ends below packet 5");
+  NS_TEST_ASSERT_MSG_EQ (blocks[1], 3, "The third block ends at packet 3");
+
+  tracker.GetAckBlocks (gaps, blocks, 1);
+  NS_TEST_ASSERT_MSG_EQ (gaps.size (), 1, "The gaps should be limited to maxGaps");
+  NS_TEST_ASSERT_MSG_EQ (blocks[0], 5, "The most recent gaps should be reported first");
+
+  // Filling a gap merges the ranges on both sides
+  tracker.Add (SequenceNumber32 (4));
+  NS_TEST_ASSERT_MSG_EQ (tracker.IsOutOfOrder (), true, "Packet 4 fills an older gap");
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 2, "Packet 4 should join [1, 3] and [5, 5]");
+  tracker.Add (SequenceNumber32 (7));
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 2, "Packet 7 should extend [8, 9] downwards");
+  tracker.GetAckBlocks (gaps, blocks, 8);
+  NS_TEST_ASSERT_MSG_EQ (gaps.size (), 1, "Wrong number of gaps");
+  NS_TEST_ASSERT_MSG_EQ (gaps[0], 6, "Only packet 6 is missing");
+  NS_TEST_ASSERT_MSG_EQ (blocks[0], 5, "The second block ends at packet 5");
+  tracker.Add (SequenceNumber32 (6));
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 1, "Every packet up to 9 was received");
+  tracker.GetAckBlocks (gaps, blocks, 8);
+  NS_TEST_ASSERT_MSG_EQ (gaps.size (), 0, "There should be no gap left");
+
+  // Pruning folds the oldest ranges together
+  tracker.Add (SequenceNumber32 (11));
+  tracker.Add (SequenceNumber32 (13));
+  tracker.Add (SequenceNumber32 (15));
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 4, "Wrong number of ranges");
+  tracker.Prune (2);
+  NS_TEST_ASSERT_MSG_EQ (tracker.GetNumRanges (), 2, "The ranges were not pruned");
+  tracker.GetAckBlocks (gaps, blocks, 8);
+  NS_TEST_ASSERT_MSG_EQ (gaps[0], 14, "The most recent gap should be kept");
+  NS_TEST_ASSERT_MSG_EQ (blocks[0], 13, "The oldest ranges should be folded up to packet 13");
+  NS_TEST_ASSERT_MSG_EQ (tracker.Add (SequenceNumber32 (12)), false,
+                         "A packet number folded into a range counts as received");
+
+  tracker.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (tracker.IsEmpty (), true, "The tracker was not cleared");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the QuicAckRangeTracker test case
+ */
+class QuicAckRangeTrackerTestSuite : public TestSuite
+{
+public:
+  QuicAckRangeTrackerTestSuite () :
+      TestSuite ("quic-ack-range-tracker", UNIT)
+  {
+    AddTestCase (new QuicAckRangeTrackerTestCase, TestCase::QUICK);
+  }
+};
+static QuicAckRangeTrackerTestSuite g_quicAckRangeTrackerTestSuite;
@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include "ns3/quic-socket-base.h"
+#include "ns3/quic-l5-protocol.h"
+#include "ns3/quic-stream-base.h"
+#include "ns3/quic-subheader.h"
+#include "ns3/mp-quic-subflow.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("QuicFlowControlTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check that the MAX_DATA kept by QuicL5Protocol stays equal to the
+ * sum of the MAX_STREAM_DATA of its streams
+ */
+class QuicMaxDataTestCase : public TestCase
+{
+public:
+  QuicMaxDataTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Sum the MAX_STREAM_DATA of the streams
+   *
+   * \param quicl5 the QuicL5Protocol holding the streams
+   * \param streams the number of streams
+   * \return the sum of the MAX_STREAM_DATA of the streams
+   */
+  uint64_t SumMaxStreamData (Ptr<QuicL5Protocol> quicl5, uint64_t streams);
+};
+
+QuicMaxDataTestCase::QuicMaxDataTestCase () :
+    TestCase ("QuicL5Protocol MAX_DATA Test")
+{
+}
+
+uint64_t
+QuicMaxDataTestCase::SumMaxStreamData (Ptr<QuicL5Protocol> quicl5, uint64_t streams)
+{
+  uint64_t sum = 0;
+  for (uint64_t streamId = 0; streamId < streams; streamId++)
+    {
+      sum += quicl5->SearchStream (streamId)->SendMaxStreamData ();
+    }
+  return sum;
+}
+
+void
+QuicMaxDataTestCase::DoRun ()
+{
+  Ptr<QuicSocketBase> socket = CreateObject<QuicSocketBase> ();
+  Ptr<QuicL5Protocol> quicl5 = CreateObject<QuicL5Protocol> ();
+  quicl5->SetSocket (socket);
+  NS_TEST_ASSERT_MSG_EQ (quicl5->GetMaxData (), 0, "MAX_DATA should be zero without streams");
+
+  // Streams 0, 1 and 2
+  quicl5->CreateStream (QuicStream::RECEIVER, socket->GetMaxStreamId ());
+  uint64_t streams = socket->GetMaxStreamId () + 1;
+  NS_TEST_ASSERT_MSG_EQ (quicl5->GetMaxData (), SumMaxStreamData (quicl5, streams),
+                         "MAX_DATA differs from the sum of MAX_STREAM_DATA after the streams were created");
+
+  // Frames received out of order take room in the receive buffers
+  Address address;
+  uint32_t offset = 5000;
+  for (uint64_t streamId = 1; streamId < streams; streamId++)
+    {
+      Ptr<QuicStreamBase> stream = quicl5->SearchStream (streamId);
+      uint32_t before = stream->SendMaxStreamData ();
+      for (uint32_t i = 0; i < 3; i++)
+        {
+          QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (streamId, offset + i * 1000, 1000, true, true);
+          stream->Recv (Create<Packet> (1000), sub, address);
+          NS_TEST_ASSERT_MSG_EQ (quicl5->GetMaxData (), SumMaxStreamData (quicl5, streams),
+                                 "MAX_DATA differs from the sum of MAX_STREAM_DATA after a frame on stream " << streamId);
+        }
+      NS_TEST_ASSERT_MSG_EQ (stream->SendMaxStreamData (), before - 3000,
+                             "The buffered frames should reduce MAX_STREAM_DATA");
+    }
+
+  // Growing and shrinking the receive buffers
+  quicl5->SearchStream (1)->SetStreamRcvBufSize (262144);
+  NS_TEST_ASSERT_MSG_EQ (quicl5->GetMaxData (), SumMaxStreamData (quicl5, streams),
+                         "MAX_DATA differs from the sum of MAX_STREAM_DATA after a larger buffer");
+  quicl5->UpdateRcvWindow (524288);
+  NS_TEST_ASSERT_MSG_EQ (quicl5->GetMaxData (), SumMaxStreamData (quicl5, streams),
+                         "MAX_DATA differs from the sum of MAX_STREAM_DATA after the window grew");
+  quicl5->SearchStream (2)->SetStreamRcvBufSize (65536);
+  NS_TEST_ASSERT_MSG_EQ (quicl5->GetMaxData (), SumMaxStreamData (quicl5, streams),
+                         "MAX_DATA differs from the sum of MAX_STREAM_DATA after a smaller buffer");
+}
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief A QuicSocketBase with its streams, which lets the tests feed the
+ * receive window autotuning
+ */
+class QuicFlowControlTestSocket : public QuicSocketBase
+{
+public:
+  /**
+   * \brief Create the stream controller and the streams of the socket
+   */
+  void CreateStreams ()
+  {
+    m_quicl5 = CreateStreamController ();
+    m_quicl5->CreateStream (QuicStream::BIDIRECTIONAL, GetMaxStreamId ());
+  }
+
+  /**
+   * \brief Get the stream controller of the socket
+   *
+   * \return the QuicL5Protocol of the socket
+   */
+  Ptr<QuicL5Protocol> GetStreamController () const
+  {
+    return m_quicl5;
+  }
+
+  using QuicSocketBase::AdjustRcvWindow;
+};
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the growth of the receive window with the delivery rate and
+ * the RTT of the slowest path
+ */
+class QuicRcvWindowTestCase : public TestCase
+{
+public:
+  QuicRcvWindowTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Deliver data in order and check the receive window
+   *
+   * \param socket the receiving socket
+   * \param bytes the bytes delivered
+   * \param window the expected receive window
+   */
+  void Deliver (Ptr<QuicFlowControlTestSocket> socket, uint32_t bytes, uint32_t window);
+};
+
+QuicRcvWindowTestCase::QuicRcvWindowTestCase () :
+    TestCase ("QuicSocketBase receive window autotuning Test")
+{
+}
+
+void
+QuicRcvWindowTestCase::Deliver (Ptr<QuicFlowControlTestSocket> socket, uint32_t bytes, uint32_t window)
+{
+  socket->AdjustRcvWindow (bytes);
+  NS_TEST_EXPECT_MSG_EQ (socket->GetRcvWindow (), window,
+                         "Wrong receive window at " << Simulator::Now ().GetSeconds () << " s");
+  Ptr<QuicL5Protocol> quicl5 = socket->GetStreamController ();
+  for (uint64_t streamId = 1; streamId <= socket->GetMaxStreamId (); streamId++)
+    {
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (quicl5->SearchStream (streamId)->GetStreamRcvBufSize (), window,
+                                   "The receive buffer of stream " << streamId << " is smaller than the window");
+    }
+}
+
+void
+QuicRcvWindowTestCase::DoRun ()
+{
+  Ptr<QuicFlowControlTestSocket> socket = CreateObject<QuicFlowControlTestSocket> ();
+  socket->CreateStreams ();
+  uint32_t initial = socket->GetRcvWindow ();
+  NS_TEST_ASSERT_MSG_EQ (initial, 131072, "The window should start from SocketRcvBufSize");
+
+  // The window is sized on the slowest path, which has no smoothed RTT but
+  // was sampled with a window update
+  Ptr<MpQuicSubFlow> fast = CreateObject<MpQuicSubFlow> ();
+  fast->m_flowId = 0;
+  fast->m_tcb->m_smoothedRtt = MilliSeconds (50);
+  socket->SubflowInsert (fast);
+  Ptr<MpQuicSubFlow> slow = CreateObject<MpQuicSubFlow> ();
+  slow->m_flowId = 1;
+  slow->m_controlRtt = MilliSeconds (100);
+  socket->SubflowInsert (slow);
+
+  Ptr<QuicFlowControlTestSocket> fixed = CreateObject<QuicFlowControlTestSocket> ();
+  fixed->SetAttribute ("RcvBufAutoTuning", BooleanValue (false));
+  fixed->CreateStreams ();
+  fixed->SubflowInsert (CreateObject<MpQuicSubFlow> ());
+
+  // Nothing changes before one RTT of the slowest path
+  Simulator::Schedule (MilliSeconds (50), &QuicRcvWindowTestCase::Deliver, this, socket, 50000, initial);
+  // 100 KB in 100 ms: twice that
+  Simulator::Schedule (MilliSeconds (100), &QuicRcvWindowTestCase::Deliver, this, socket, 50000, 200000);
+  // A slower delivery never shrinks the window
+  Simulator::Schedule (MilliSeconds (200), &QuicRcvWindowTestCase::Deliver, this, socket, 10000, 200000);
+  // The window stays under MaxRcvBufSize
+  Simulator::Schedule (MilliSeconds (300), &QuicRcvWindowTestCase::Deliver, this, socket, 20000000, 16777216);
+  // Without autotuning the window is SocketRcvBufSize
+  Simulator::Schedule (MilliSeconds (100), &QuicRcvWindowTestCase::Deliver, this, fixed, 1000000, initial);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check that frames reordered across the paths never move the
+ * MAX_DATA and MAX_STREAM_DATA limits back when the window is autotuned
+ */
+class QuicMonotonicLimitsTestCase : public TestCase
+{
+public:
+  QuicMonotonicLimitsTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+QuicMonotonicLimitsTestCase::QuicMonotonicLimitsTestCase () :
+    TestCase ("QuicSocketBase monotonic flow control limits Test")
+{
+}
+
+void
+QuicMonotonicLimitsTestCase::DoRun ()
+{
+  Address address;
+  for (bool autoTuning : {true, false})
+    {
+      Ptr<QuicFlowControlTestSocket> socket = CreateObject<QuicFlowControlTestSocket> ();
+      socket->SetAttribute ("RcvBufAutoTuning", BooleanValue (autoTuning));
+      socket->CreateStreams ();
+      Ptr<QuicStreamBase> stream = socket->GetStreamController ()->SearchStream (1);
+
+      QuicSubheader maxData = QuicSubheader::CreateMaxData (500000);
+      socket->OnReceivedFrame (maxData);
+      NS_TEST_ASSERT_MSG_EQ (socket->GetConnectionMaxData (), 500000, "MAX_DATA was not applied");
+      maxData = QuicSubheader::CreateMaxData (400000);
+      socket->OnReceivedFrame (maxData);
+      NS_TEST_ASSERT_MSG_EQ (socket->GetConnectionMaxData (), autoTuning ? 500000 : 400000,
+                             "Wrong MAX_DATA after an older frame, autotuning " << autoTuning);
+      maxData = QuicSubheader::CreateMaxData (600000);
+      socket->OnReceivedFrame (maxData);
+      NS_TEST_ASSERT_MSG_EQ (socket->GetConnectionMaxData (), 600000, "MAX_DATA did not grow");
+
+      stream->Recv (Create<Packet> (0), QuicSubheader::CreateMaxStreamData (1, 300000), address);
+      NS_TEST_ASSERT_MSG_EQ (stream->GetMaxStreamData (), 300000, "MAX_STREAM_DATA was not applied");
+      stream->Recv (Create<Packet> (0), QuicSubheader::CreateMaxStreamData (1, 250000), address);
+      NS_TEST_ASSERT_MSG_EQ (stream->GetMaxStreamData (), autoTuning ? 300000 : 250000,
+                             "Wrong MAX_STREAM_DATA after an older frame, autotuning " << autoTuning);
+      stream->Recv (Create<Packet> (0), QuicSubheader::CreateMaxStreamData (1, 400000), address);
+      NS_TEST_ASSERT_MSG_EQ (stream->GetMaxStreamData (), 400000, "MAX_STREAM_DATA did not grow");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the flow control test cases
+ */
+class QuicFlowControlTestSuite : public TestSuite
+{
+public:
+  QuicFlowControlTestSuite () :
+      TestSuite ("quic-flow-control", UNIT)
+  {
+    AddTestCase (new QuicMaxDataTestCase, TestCase::QUICK);
+    AddTestCase (new QuicRcvWindowTestCase, TestCase::QUICK);
+    AddTestCase (new QuicMonotonicLimitsTestCase, TestCase::QUICK);
+  }
+};
+static QuicFlowControlTestSuite g_quicFlowControlTestSuite;
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+
+#include "ns3/quic-inline-vector.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("QuicInlineVectorTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check that a QuicInlineVector keeps its elements, in order, inline
+ * and once it moved them to the heap
+ */
+class QuicInlineVectorTestCase : public TestCase
+{
+public:
+  QuicInlineVectorTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+QuicInlineVectorTestCase::QuicInlineVectorTestCase () :
+    TestCase ("QuicInlineVector Test")
+{
+}
+
+void
+QuicInlineVectorTestCase::DoRun ()
+{
+  typedef QuicInlineVector<uint32_t, 4> Vector;
+
+  Vector v;
+  NS_TEST_ASSERT_MSG_EQ (v.empty (), true, "A new vector should be empty");
+  NS_TEST_ASSERT_MSG_EQ ((v.end () - v.begin ()), 0, "A new vector should have no element to iterate");
+
+  // Inline storage
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      v.push_back (10 * i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (v.size (), 4, "Wrong size");
+  Vector inlineCopy (v);
+  NS_TEST_ASSERT_MSG_EQ (inlineCopy.size (), 4, "Wrong size of a copy");
+  NS_TEST_ASSERT_MSG_NE (inlineCopy.begin (), v.begin (), "A copy should not share the storage");
+
+  // Past N, the elements move to the heap and keep their order
+  for (uint32_t i = 4; i < 20; i++)
+    {
+      v.push_back (10 * i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (v.size (), 20, "Wrong size after the growth");
+  uint32_t expected = 0;
+  for (uint32_t value : v)
+    {
+      NS_TEST_ASSERT_MSG_EQ (value, expected, "Element lost or moved when the vector grew");
+      expected += 10;
+    }
+  v[3] = 7;
+  NS_TEST_ASSERT_MSG_EQ (v[3], 7, "Element not written");
+
+  // Copies of a vector on the heap are deep
+  Vector heapCopy (v);
+  v[0] = 1;
+  NS_TEST_ASSERT_MSG_EQ (heapCopy.size (), 20, "Wrong size of a copy");
+  NS_TEST_ASSERT_MSG_EQ (heapCopy[0], 0, "A copy should not share the storage");
+  NS_TEST_ASSERT_MSG_EQ (heapCopy[19], 190, "Wrong last element of a copy");
+
+  inlineCopy = heapCopy;
+  NS_TEST_ASSERT_MSG_EQ (inlineCopy.size (), 20, "Wrong size after the assignment");
+  NS_TEST_ASSERT_MSG_EQ (inlineCopy[3], 7, "Wrong element after the assignment");
+  Vector &self = heapCopy;
+  heapCopy = self;
+  NS_TEST_ASSERT_MSG_EQ (heapCopy.size (), 20, "A self-assignment changed the vector");
+  NS_TEST_ASSERT_MSG_EQ (heapCopy[19], 190, "A self-assignment changed the vector");
+
+  // Clearing keeps the storage, which can be filled again
+  v.clear ();
+  NS_TEST_ASSERT_MSG_EQ (v.empty (), true, "The vector was not cleared");
+  v.push_back (5);
+  NS_TEST_ASSERT_MSG_EQ (v.size (), 1, "Wrong size after a clear");
+  NS_TEST_ASSERT_MSG_EQ (v[0], 5, "Wrong element after a clear");
+
+  // reserve only grows the storage
+  Vector r;
+  r.push_back (1);
+  r.reserve (2);
+  r.reserve (100);
+  NS_TEST_ASSERT_MSG_EQ (r.size (), 1, "reserve changed the size");
+  NS_TEST_ASSERT_MSG_EQ (r[0], 1, "reserve lost an element");
+
+  std::vector<uint32_t> s = {3, 1, 4, 1, 5, 9};
+  Vector fromStd (s);
+  NS_TEST_ASSERT_MSG_EQ (fromStd.size (), s.size (), "Wrong size of a copy of a std::vector");
+  for (uint32_t i = 0; i < s.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (fromStd[i], s[i], "Wrong element of a copy of a std::vector");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the QuicInlineVector test case
+ */
+class QuicInlineVectorTestSuite : public TestSuite
+{
+public:
+  QuicInlineVectorTestSuite () :
+      TestSuite ("quic-inline-vector", UNIT)
+  {
+    AddTestCase (new QuicInlineVectorTestCase, TestCase::QUICK);
+  }
+};
+static QuicInlineVectorTestSuite g_quicInlineVectorTestSuite;
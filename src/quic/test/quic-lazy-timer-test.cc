@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "ns3/quic-lazy-timer.h"
+#include "ns3/quic-timer-wheel.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("QuicLazyTimerTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check that QuicLazyTimer expires once, at its last deadline
+ */
+class QuicLazyTimerTestCase : public TestCase
+{
+public:
+  QuicLazyTimerTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Arm the timer
+   *
+   * \param delay the delay
+   */
+  void Arm (Time delay);
+
+  /**
+   * \brief Disarm the timer
+   */
+  void Disarm (void);
+
+  /**
+   * \brief Record an expiry of the timer
+   *
+   * \param id the argument bound to the timer
+   */
+  void Expire (uint8_t id);
+
+  QuicLazyTimer m_timer;              //!< The timer under test
+  std::vector<Time> m_expiries;       //!< Times at which the timer expired
+};
+
+QuicLazyTimerTestCase::QuicLazyTimerTestCase () :
+    TestCase ("QuicLazyTimer Test")
+{
+}
+
+void
+QuicLazyTimerTestCase::Arm (Time delay)
+{
+  m_timer.Schedule (delay);
+}
+
+void
+QuicLazyTimerTestCase::Disarm ()
+{
+  m_timer.Cancel ();
+}
+
+void
+QuicLazyTimerTestCase::Expire (uint8_t id)
+{
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) id, 7, "Wrong argument");
+  NS_TEST_EXPECT_MSG_EQ (m_timer.IsRunning (), false, "The timer should be disarmed when it expires");
+  m_expiries.push_back (Simulator::Now ());
+}
+
+void
+QuicLazyTimerTestCase::DoRun ()
+{
+  m_timer.SetFunction (&QuicLazyTimerTestCase::Expire, this);
+  m_timer.SetArguments ((uint8_t) 7);
+
+  // pushed forward: expires once, at the last deadline
+  Simulator::Schedule (Seconds (0), &QuicLazyTimerTestCase::Arm, this, Seconds (1));
+  Simulator::Schedule (Seconds (0.5), &QuicLazyTimerTestCase::Arm, this, Seconds (1));
+  // moved earlier: expires at the new deadline only
+  Simulator::Schedule (Seconds (2), &QuicLazyTimerTestCase::Arm, this, Seconds (3));
+  Simulator::Schedule (Seconds (2.5), &QuicLazyTimerTestCase::Arm, this, Seconds (0.5));
+  // cancelled, then armed again before the stale event fires
+  Simulator::Schedule (Seconds (4), &QuicLazyTimerTestCase::Arm, this, Seconds (1));
+  Simulator::Schedule (Seconds (4.5), &QuicLazyTimerTestCase::Disarm, this);
+  Simulator::Schedule (Seconds (4.6), &QuicLazyTimerTestCase::Arm, this, Seconds (1));
+  // cancelled for good
+  Simulator::Schedule (Seconds (7), &QuicLazyTimerTestCase::Arm, this, Seconds (1));
+  Simulator::Schedule (Seconds (7.5), &QuicLazyTimerTestCase::Disarm, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_expiries.size (), 3, "Wrong number of expiries");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[0], Seconds (1.5), "The deadline was not pushed forward");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[1], Seconds (3), "The deadline was not moved earlier");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[2], Seconds (5.6), "The timer was not armed again after Cancel");
+  NS_TEST_ASSERT_MSG_EQ (m_timer.IsExpired (), true, "The timer should be disarmed");
+}
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check that the timers attached to a QuicTimerWheel expire at their
+ * deadlines, with one event pending at a time
+ */
+class QuicTimerWheelTestCase : public TestCase
+{
+public:
+  QuicTimerWheelTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Arm a timer
+   *
+   * \param id the timer
+   * \param delay the delay
+   */
+  void Arm (uint8_t id, Time delay);
+
+  /**
+   * \brief Record an expiry of a timer
+   *
+   * \param id the timer
+   */
+  void Expire (uint8_t id);
+
+  QuicTimerWheel m_wheel;             //!< The wheel under test
+  QuicLazyTimer m_timers[3];          //!< The timers attached to the wheel
+  std::vector<std::pair<uint8_t, Time> > m_expiries;  //!< Timers expired, and when
+};
+
+QuicTimerWheelTestCase::QuicTimerWheelTestCase () :
+    TestCase ("QuicTimerWheel Test")
+{
+}
+
+void
+QuicTimerWheelTestCase::Arm (uint8_t id, Time delay)
+{
+  m_timers[id].Schedule (delay);
+}
+
+void
+QuicTimerWheelTestCase::Expire (uint8_t id)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_timers[id].IsRunning (), false, "The timer should be disarmed when it expires");
+  m_expiries.push_back (std::make_pair (id, Simulator::Now ()));
+  if (id == 0 and m_expiries.size () == 1)
+    {
+      // armed again from its own expiry, as the ACK timers are
+      m_timers[0].Schedule (Seconds (2));
+    }
+}
+
+void
+QuicTimerWheelTestCase::DoRun ()
+{
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      m_timers[i].SetFunction (&QuicTimerWheelTestCase::Expire, this);
+      m_timers[i].SetArguments (i);
+      m_timers[i].SetWheel (&m_wheel);
+    }
+  NS_TEST_ASSERT_MSG_EQ (m_wheel.GetNTimers (), 3, "Wrong number of timers attached");
+
+  // timer 1 is pushed forward on every "packet", timer 2 is moved earlier
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (MilliSeconds (100 * i), &QuicTimerWheelTestCase::Arm, this, 1, Seconds (1));
+    }
+  Simulator::Schedule (Seconds (0), &QuicTimerWheelTestCase::Arm, this, 0, Seconds (1));
+  Simulator::Schedule (Seconds (0), &QuicTimerWheelTestCase::Arm, this, 2, Seconds (5));
+  Simulator::Schedule (Seconds (0.5), &QuicTimerWheelTestCase::Arm, this, 2, Seconds (1.5));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_expiries.size (), 4, "Wrong number of expiries");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) m_expiries[0].first, 0, "Wrong order of expiries");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[0].second, Seconds (1), "Wrong deadline of timer 0");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) m_expiries[1].first, 1, "Wrong order of expiries");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[1].second, Seconds (1.9), "The deadline of timer 1 was not pushed forward");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) m_expiries[2].first, 2, "Wrong order of expiries");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[2].second, Seconds (2), "The deadline of timer 2 was not moved earlier");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) m_expiries[3].first, 0, "Wrong order of expiries");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[3].second, Seconds (3), "Timer 0 was not armed again");
+  // one event for each distinct deadline reached: 1, 1.9, 2 and 3 s
+  NS_TEST_ASSERT_MSG_EQ (m_wheel.GetNEvents (), 4, "The wheel scheduled too many events");
+
+  // timers due at the same time expire in the order they were armed, not
+  // in the order they were attached; the run goes on from 3 s
+  m_expiries.clear ();
+  Simulator::Schedule (Seconds (0), &QuicTimerWheelTestCase::Arm, this, 2, Seconds (1));
+  Simulator::Schedule (Seconds (0.5), &QuicTimerWheelTestCase::Arm, this, 1, Seconds (0.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (m_expiries.size (), 2, "Wrong number of expiries");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) m_expiries[0].first, 2, "The timer armed first should expire first");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) m_expiries[1].first, 1, "The timer armed last should expire last");
+  NS_TEST_ASSERT_MSG_EQ (m_expiries[1].second, Seconds (4), "Wrong deadline of timer 1");
+
+  m_timers[1].SetWheel (0);
+  NS_TEST_ASSERT_MSG_EQ (m_wheel.GetNTimers (), 2, "The timer was not detached");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the QuicLazyTimer test case
+ */
+class QuicLazyTimerTestSuite : public TestSuite
+{
+public:
+  QuicLazyTimerTestSuite () :
+      TestSuite ("quic-lazy-timer", UNIT)
+  {
+    AddTestCase (new QuicLazyTimerTestCase, TestCase::QUICK);
+    AddTestCase (new QuicTimerWheelTestCase, TestCase::QUICK);
+  }
+};
+static QuicLazyTimerTestSuite g_quicLazyTimerTestSuite;
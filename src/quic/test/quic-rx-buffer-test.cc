@@ -22,6 +22,7 @@
  *          
  */
 
+#include <cstring>
 #include "ns3/test.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
@@ -70,6 +71,16 @@ private:
    */
   void
   TestStreamExtract ();
+  /**
+   * \brief Test the reassembly of overlapping and already delivered frames in the Stream RX buffer
+   */
+  void
+  TestStreamReassembly ();
+  /**
+   * \brief Test that the RX buffers deliver the packets they received rather than copies
+   */
+  void
+  TestZeroCopy ();
 };
 
 QuicRxBufferTestCase::QuicRxBufferTestCase () :
@@ -115,6 +126,24 @@ QuicRxBufferTestCase::DoRun ()
    * -> check correctness of buffer application size and available size
    */
   TestStreamExtract ();
+
+  /*
+   * Test the reassembly of frames in the Stream RX buffer:
+   * -> add frames in reverse order and check the deliverable range
+   * -> reject frames inside buffered data, keep the new bytes of frames
+   *    partially overlapping it
+   * -> drop already delivered data and trim a frame straddling the offset
+   * -> check FIN accounting
+   */
+  TestStreamReassembly ();
+
+  /*
+   * Test the zero-copy extraction of the RX buffers:
+   * -> extract the packets added to the Socket RX buffer
+   * -> split a packet at the byte boundary of a partial read
+   * -> extract the frames of the Stream RX buffer one at a time
+   */
+  TestZeroCopy ();
 }
 
 void
@@ -361,6 +390,145 @@ QuicRxBufferTestCase::TestStreamExtract ()
   NS_TEST_ASSERT_MSG_EQ(rxBuf.Size (), 0, "Wrong buffer size");
 }
 
+void
+QuicRxBufferTestCase::TestStreamReassembly ()
+{
+  // create the buffer
+  QuicStreamRxBuffer rxBuf;
+  rxBuf.SetMaxBufferSize (18000);
+
+  Ptr<Packet> p = Create<Packet> (1000);
+  QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, 0, p->GetSize (), true,
+                                                            true, false);
+
+  // add frames from the last to the first
+  for (uint64_t offset = 4000; offset >= 1000; offset -= 1000)
+    {
+      sub.SetOffset (offset);
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (p, sub), true, "Failed to add packet");
+      std::pair<uint64_t, uint64_t> deliverable = rxBuf.GetDeliverable (0);
+      NS_TEST_ASSERT_MSG_EQ (deliverable.second, 0, "Deliverable data with a gap at the start");
+    }
+
+  // frame inside the buffered data
+  sub.SetOffset (2500);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (p, sub), false, "Added overlapping packet");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 4000, "Wrong buffer size");
+
+  // fill the gap
+  sub.SetOffset (0);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (p, sub), true, "Failed to add packet");
+  std::pair<uint64_t, uint64_t> deliverable = rxBuf.GetDeliverable (0);
+  NS_TEST_ASSERT_MSG_EQ (deliverable.first, 4000, "Wrong deliverable offset value");
+  NS_TEST_ASSERT_MSG_EQ (deliverable.second, 5000, "Wrong deliverable packet size");
+
+  // the receiver has already delivered up to 1500: the first frame is
+  // dropped and the second one trimmed
+  deliverable = rxBuf.GetDeliverable (1500);
+  NS_TEST_ASSERT_MSG_EQ (deliverable.first, 4000, "Wrong deliverable offset value");
+  NS_TEST_ASSERT_MSG_EQ (deliverable.second, 3500, "Wrong deliverable packet size");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 3500, "Wrong buffer size");
+
+  // FIN frame, counted in the buffer occupancy
+  sub = QuicSubheader::CreateStreamSubHeader (1, 5000, p->GetSize (), true, true, true);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (p, sub), true, "Failed to add FIN packet");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetFinalSize (), 6000, "Wrong final size");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 4500, "Wrong buffer size");
+
+  Ptr<Packet> out = rxBuf.Extract (rxBuf.GetDeliverable (1500).second);
+  NS_TEST_ASSERT_MSG_NE (out, 0, "Failed to extract packets");
+  NS_TEST_ASSERT_MSG_EQ (out->GetSize (), 4500, "Wrong packet size");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 0, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 18000, "Wrong available data size");
+
+  // storage is reused after the buffer has been emptied
+  sub.SetOffset (7000);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Add (p, sub), true, "Failed to add packet");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetDeliverable (6000).second, 0, "Deliverable data with a gap at the start");
+
+  // frames sent again cut at other boundaries: only their new bytes are added
+  QuicStreamRxBuffer splitBuf;
+  splitBuf.SetMaxBufferSize (18000);
+  sub = QuicSubheader::CreateStreamSubHeader (1, 1000, p->GetSize (), true, true, false);
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.Add (p, sub), true, "Failed to add packet");
+  sub.SetOffset (3000);
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.Add (p, sub), true, "Failed to add packet");
+
+  // the start of the frame is buffered already
+  sub.SetOffset (1500);
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.Add (p, sub), true, "Dropped partially overlapping packet");
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.Size (), 2500, "Wrong buffer size");
+
+  // the frame covers buffered data, with new bytes before and after it,
+  // and the FIN is kept with its last bytes
+  Ptr<Packet> large = Create<Packet> (4000);
+  sub = QuicSubheader::CreateStreamSubHeader (1, 500, large->GetSize (), true, true, true);
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.Add (large, sub), true, "Dropped covering packet");
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.Size (), 4000, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.GetFinalSize (), 4500, "Wrong final size");
+  NS_TEST_ASSERT_MSG_EQ (splitBuf.GetDeliverable (500).second, 4000, "Wrong deliverable packet size");
+  out = splitBuf.Extract (4000);
+  NS_TEST_ASSERT_MSG_NE (out, 0, "Failed to extract packets");
+  NS_TEST_ASSERT_MSG_EQ (out->GetSize (), 4000, "Wrong packet size");
+}
+
+void
+QuicRxBufferTestCase::TestZeroCopy ()
+{
+  uint8_t data[1200];
+  for (uint32_t i = 0; i < sizeof (data); i++)
+    {
+      data[i] = i % 251;
+    }
+
+  QuicSocketRxBuffer socketBuf;
+  socketBuf.SetMaxBufferSize (3600);
+  Ptr<Packet> p = Create<Packet> (data, sizeof (data));
+  Ptr<Packet> p1 = Create<Packet> (data, sizeof (data));
+  socketBuf.Add (p);
+  socketBuf.Add (p1);
+
+  // a whole packet is returned as it was added
+  Ptr<Packet> out = socketBuf.Extract (1200);
+  NS_TEST_ASSERT_MSG_EQ (out, p, "Extracted a copy of the packet");
+
+  // a partial read returns the bytes up to the read size and leaves the rest
+  out = socketBuf.Extract (500);
+  NS_TEST_ASSERT_MSG_EQ (out->GetSize (), 500, "Packet size differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (socketBuf.Size (), 700, "Buffer size differs from expected");
+  uint8_t buf[1200];
+  out->CopyData (buf, 500);
+  NS_TEST_ASSERT_MSG_EQ (memcmp (buf, data, 500), 0, "Wrong packet content");
+
+  // a read larger than the rest of the packet stops at its end
+  out = socketBuf.Extract (1200);
+  NS_TEST_ASSERT_MSG_EQ (out->GetSize (), 700, "Packet size differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (socketBuf.Size (), 0, "Buffer size differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (socketBuf.Available (), 3600, "Availability differs from expected");
+  out->CopyData (buf, 700);
+  NS_TEST_ASSERT_MSG_EQ (memcmp (buf, data + 500, 700), 0, "Wrong packet content");
+
+  QuicStreamRxBuffer streamBuf;
+  streamBuf.SetMaxBufferSize (18000);
+  QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, 0, p->GetSize (), true,
+                                                            true, false);
+  sub.SetOffset (1200);
+  streamBuf.Add (p1, sub);
+  sub.SetOffset (0);
+  streamBuf.Add (p, sub);
+  NS_TEST_ASSERT_MSG_EQ (streamBuf.GetDeliverable (0).second, 2400, "Wrong deliverable packet size");
+
+  // the frames come out in offset order, each in the packet it was received in
+  out = streamBuf.ExtractFrame ();
+  NS_TEST_ASSERT_MSG_EQ (out, p, "Extracted a copy of the frame");
+  out = streamBuf.ExtractFrame ();
+  NS_TEST_ASSERT_MSG_EQ (out, p1, "Extracted a copy of the frame");
+  NS_TEST_ASSERT_MSG_EQ (streamBuf.Size (), 0, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ (streamBuf.Available (), 18000, "Wrong available data size");
+  out = streamBuf.ExtractFrame ();
+  NS_TEST_ASSERT_MSG_EQ (out, 0, "Extracted a frame from an empty buffer");
+}
+
 void
 QuicRxBufferTestCase::DoTeardown ()
 {
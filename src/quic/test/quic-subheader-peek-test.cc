@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include "ns3/quic-subheader.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("QuicSubheaderPeekTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check that QuicSubheader::PeekStreamIdAndOffset reads the same
+ * stream ID and offset as a full deserialization
+ */
+class QuicSubheaderPeekTestCase : public TestCase
+{
+public:
+  QuicSubheaderPeekTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+};
+
+QuicSubheaderPeekTestCase::QuicSubheaderPeekTestCase () :
+    TestCase ("QuicSubheader PeekStreamIdAndOffset Test")
+{
+}
+
+void
+QuicSubheaderPeekTestCase::DoRun ()
+{
+  // the bounds of each size of variable-length integer
+  uint64_t values[] = {0, 63, 64, 16383, 16384, 1073741823, 1073741824, 4611686018427387903ULL};
+  uint64_t streamId, offset;
+
+  for (uint8_t frameType = QuicSubheader::STREAM000; frameType <= QuicSubheader::STREAM111; frameType++)
+    {
+      bool offBit = frameType & 0x04;
+      bool lengthBit = frameType & 0x02;
+      bool finBit = frameType & 0x01;
+      for (uint64_t id : values)
+        {
+          for (uint64_t off : values)
+            {
+              QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (id, off, 10, offBit, lengthBit, finBit);
+              Ptr<Packet> frame = Create<Packet> (10);
+              frame->AddHeader (sub);
+              NS_TEST_ASSERT_MSG_EQ (QuicSubheader::PeekStreamIdAndOffset (frame, streamId, offset), true,
+                                     "STREAM frame not recognized by the peek, type " << (uint16_t) frameType);
+              NS_TEST_ASSERT_MSG_EQ (streamId, id, "Different stream id found by the peek");
+              NS_TEST_ASSERT_MSG_EQ (offset, offBit ? off : 0, "Different offset found by the peek");
+
+              QuicSubheader copy;
+              frame->PeekHeader (copy);
+              NS_TEST_ASSERT_MSG_EQ (streamId, copy.GetStreamId (), "The peek differs from the deserialization");
+              NS_TEST_ASSERT_MSG_EQ (offset, copy.GetOffset (), "The peek differs from the deserialization");
+            }
+        }
+    }
+
+  // Other frames are deserialized, and are not STREAM frames
+  Ptr<Packet> frame = Create<Packet> ();
+  frame->AddHeader (QuicSubheader::CreateMaxStreamData (16384, 100000));
+  NS_TEST_ASSERT_MSG_EQ (QuicSubheader::PeekStreamIdAndOffset (frame, streamId, offset), false,
+                         "MAX_STREAM_DATA recognized as a STREAM frame");
+  NS_TEST_ASSERT_MSG_EQ (streamId, 16384, "Wrong stream id of a MAX_STREAM_DATA frame");
+
+  frame = Create<Packet> ();
+  frame->AddHeader (QuicSubheader::CreateMaxData (100000));
+  NS_TEST_ASSERT_MSG_EQ (QuicSubheader::PeekStreamIdAndOffset (frame, streamId, offset), false,
+                         "MAX_DATA recognized as a STREAM frame");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the QuicSubheader peek test case
+ */
+class QuicSubheaderPeekTestSuite : public TestSuite
+{
+public:
+  QuicSubheaderPeekTestSuite () :
+      TestSuite ("quic-subheader-peek", UNIT)
+  {
+    AddTestCase (new QuicSubheaderPeekTestCase, TestCase::QUICK);
+  }
+};
+static QuicSubheaderPeekTestSuite g_quicSubheaderPeekTestSuite;
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2022 Pan Lab, Department of Computer Science, University of Victoria
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <sstream>
+#include <string>
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "ns3/quic-trace-recorder.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("QuicTraceRecorderTestSuite");
+
+/**
+ * \ingroup internet-tests
+ * \ingroup tests
+ *
+ * \brief Check the ring buffer, the dumps and the callbacks of QuicTraceRecorder
+ */
+class QuicTraceRecorderTestCase : public TestCase
+{
+public:
+  QuicTraceRecorderTestCase ();
+
+private:
+  virtual void
+  DoRun (void);
+
+  /**
+   * \brief Record the events in the buffer
+   */
+  void RecordEvents (void);
+
+  /**
+   * \brief Count the events passed to the callback
+   *
+   * \param event the event
+   */
+  void CountEvent (const QuicTraceEvent &event);
+
+  QuicTraceRecorder m_recorder;   //!< The recorder under test
+  uint32_t m_callbacks;           //!< Events passed to the callback
+};
+
+QuicTraceRecorderTestCase::QuicTraceRecorderTestCase () :
+    TestCase ("QuicTraceRecorder Test"),
+    m_callbacks (0)
+{
+}
+
+void
+QuicTraceRecorderTestCase::RecordEvents ()
+{
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      m_recorder.Record (QuicTraceRecorder::PACKET_SENT, 1, i, 1200, i * 1200);
+    }
+}
+
+void
+QuicTraceRecorderTestCase::CountEvent (const QuicTraceEvent &event)
+{
+  m_callbacks++;
+}
+
+void
+QuicTraceRecorderTestCase::DoRun ()
+{
+  m_recorder.SetCapacity (4);
+  m_recorder.ConnectWithoutContext (MakeCallback (&QuicTraceRecorderTestCase::CountEvent, this));
+  Simulator::Schedule (Seconds (1), &QuicTraceRecorderTestCase::RecordEvents, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_recorder.GetNumRecorded (), 10, "Wrong number of events recorded");
+  NS_TEST_ASSERT_MSG_EQ (m_callbacks, 10, "Wrong number of events passed to the callback");
+  NS_TEST_ASSERT_MSG_EQ (m_recorder.GetSize (), 4, "The buffer should only keep the last events");
+  for (uint32_t i = 0; i < m_recorder.GetSize (); i++)
+    {
+      const QuicTraceEvent &event = m_recorder.GetEvent (i);
+      NS_TEST_ASSERT_MSG_EQ (event.m_type, QuicTraceRecorder::PACKET_SENT, "Wrong event type");
+      NS_TEST_ASSERT_MSG_EQ (event.m_id, 1, "Wrong path ID");
+      NS_TEST_ASSERT_MSG_EQ (event.m_values[0], 6 + i, "Events are not ordered from the oldest");
+      NS_TEST_ASSERT_MSG_EQ (TimeStep (event.m_time), Seconds (1), "Wrong event time");
+    }
+
+  std::ostringstream text;
+  m_recorder.Dump (text);
+  NS_TEST_ASSERT_MSG_EQ (text.str ().substr (0, text.str ().find ('\n')),
+                         std::string ("1\t4294967295\tPACKET_SENT\t1\t6\t1200\t7200"), "Wrong text dump");
+
+  std::ostringstream binary;
+  m_recorder.DumpBinary (binary);
+  NS_TEST_ASSERT_MSG_EQ (binary.str ().size (), 4 * sizeof (QuicTraceEvent), "Wrong binary dump size");
+
+  m_recorder.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (m_recorder.GetSize (), 0, "The buffer was not cleared");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief the TestSuite for the QuicTraceRecorder test case
+ */
+class QuicTraceRecorderTestSuite : public TestSuite
+{
+public:
+  QuicTraceRecorderTestSuite () :
+      TestSuite ("quic-trace-recorder", UNIT)
+  {
+    AddTestCase (new QuicTraceRecorderTestCase, TestCase::QUICK);
+  }
+};
+static QuicTraceRecorderTestSuite g_quicTraceRecorderTestSuite;
@@ -84,6 +84,21 @@ private:
   /** \brief Test the Socket TX buffer retransmission of lost packets */
   void
   TestRetransmission ();
+  /** \brief Test the cancellation of the copies of a packet sent on several paths */
+  void
+  TestDuplicates ();
+  /** \brief Test the reinjection on another path of the frames in flight or lost on a path */
+  void
+  TestReinjection ();
+  /** \brief Test that the frames in flight on a failed path are put back in the buffer */
+  void
+  TestClearSentList ();
+  /** \brief Test that the sent list of each path keeps its own in-flight and lost counts */
+  void
+  TestSentLedger ();
+  /** \brief Test that the ACKs of a path only update the rate sample of that path */
+  void
+  TestRateSamples ();
 };
 
 QuicTxBufferTestCase::QuicTxBufferTestCase () :
@@ -193,6 +208,281 @@ QuicTxBufferTestCase::DoRun ()
    * -> check correctness of acked and lost packets list
    */
   TestRetransmission ();
+
+  /*
+   * Test the copies of a packet sent on several paths:
+   * -> send 1 packet on path 0 and copy it on path 1
+   * -> ack the copy and check that the original is no longer in flight
+   * -> send and copy another packet, lose the copy
+   * -> check that the lost copy is not retransmitted
+   */
+  TestDuplicates ();
+
+  /*
+   * Test the reinjection of frames on another path:
+   * -> send 2 packets on path 0 and reinject them one at a time
+   * -> send the reinjected frames on path 1, lose the originals
+   * -> check that the originals are not retransmitted
+   * -> copy a retransmitted packet on path 1
+   * -> check the count of reinjected bytes
+   */
+  TestReinjection ();
+
+  /*
+   * Test the frames in flight on a failed path:
+   * -> send 2 packets on path 0 and 1 packet on path 1
+   * -> clear the sent list of path 0 and check that its frames are back in the buffer
+   * -> check that path 1 is untouched
+   * -> send the frames again on path 1
+   */
+  TestClearSentList ();
+
+  /*
+   * Test the in-flight accounting of the sent list of each path:
+   * -> send 3 packets on path 0 and 2 packets on path 1, with the same packet numbers
+   * -> ack path 1 and check that path 0 is untouched
+   * -> lose a packet on path 0 and ack a later one
+   * -> retransmit the lost packet and check the counts of both paths
+   */
+  TestSentLedger ();
+
+  /*
+   * Test the rate sample of each path:
+   * -> send and ack 2 packets in a row on path 0, send 1 packet on path 1
+   * -> check that only the rate sample of path 0 moved
+   * -> ack the packet of path 1 and check that path 0 is untouched
+   */
+  TestRateSamples ();
+}
+
+void
+QuicTxBufferTestCase::TestDuplicates ()
+{
+  QuicSocketTxBuffer txBuf;
+  Ptr<QuicSocketTxScheduler> sched = CreateObject<QuicSocketTxScheduler>();
+  txBuf.SetScheduler(sched);
+  txBuf.AddSentList (1);
+  Ptr<QuicSocketState> tcbd = CreateObject<QuicSocketState> ();
+
+  Ptr<Packet> p1 = Create<Packet> (1196);
+  QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, 0, p1->GetSize (),
+                                                            false, true, false);
+  p1->AddHeader (sub);
+  txBuf.Add (p1);
+
+  Ptr<Packet> ptx = txBuf.NextSequence (1200, SequenceNumber32 (1), 0);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 1200, "TxBuf miscalculates size");
+  ptx = txBuf.NextDuplicate (SequenceNumber32 (1), 0);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 0, "A packet should not be copied on its own path");
+  ptx = txBuf.NextDuplicate (SequenceNumber32 (1), 1);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 1200, "TxBuf miscalculates size of the copy");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 1200, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 1200, "TxBuf miscalculates size of in flight segments");
+
+  // the copy arrives first and cancels the original
+  std::vector<uint32_t> additionalAckBlocks;
+  std::vector<uint32_t> gaps;
+  std::vector<Ptr<QuicSocketTxItem>> acked = txBuf.OnAckUpdate (tcbd, 1, additionalAckBlocks,
+                                                                gaps, 1);
+  NS_TEST_ASSERT_MSG_EQ(acked.size (), 1, "Wrong acked packet vector size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 0, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 0, "The original was not cancelled by its copy");
+  acked = txBuf.OnAckUpdate (tcbd, 1, additionalAckBlocks, gaps, 0);
+  NS_TEST_ASSERT_MSG_EQ(acked.size (), 0, "A cancelled packet should not be acked again");
+
+  // the copy of the second packet is lost and not retransmitted
+  Ptr<Packet> p2 = Create<Packet> (1196);
+  sub = QuicSubheader::CreateStreamSubHeader (1, 1200, p2->GetSize (),
+                                              false, true, false);
+  p2->AddHeader (sub);
+  txBuf.Add (p2);
+  ptx = txBuf.NextSequence (1200, SequenceNumber32 (2), 0);
+  ptx = txBuf.NextDuplicate (SequenceNumber32 (2), 1);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 1200, "TxBuf miscalculates size of the copy");
+  txBuf.ResetSentList (1, 0);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.DetectLostPackets (1).size (), 1, "Wrong lost packet vector size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Retransmission (SequenceNumber32 (3), 1), 0,
+                        "A lost copy should not be retransmitted");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.AppSize (), 0, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 0, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 1200, "TxBuf miscalculates size of in flight segments");
+}
+
+void
+QuicTxBufferTestCase::TestReinjection ()
+{
+  QuicSocketTxBuffer txBuf;
+  Ptr<QuicSocketTxScheduler> sched = CreateObject<QuicSocketTxScheduler>();
+  txBuf.SetScheduler(sched);
+  txBuf.AddSentList (1);
+
+  for (uint32_t offset = 0; offset < 2400; offset += 1200)
+    {
+      Ptr<Packet> p = Create<Packet> (1196);
+      QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, offset, p->GetSize (),
+                                                                false, true, false);
+      p->AddHeader (sub);
+      txBuf.Add (p);
+    }
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (2), 0);
+  NS_TEST_ASSERT_MSG_EQ((txBuf.GetOldestUnackedSent (0) == Time::Max ()), false,
+                        "The packets in flight are not found");
+
+  // the budget fits one packet at a time, and a packet is reinjected once
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Reinject (0, 2000), 1200, "Wrong reinjected size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.AppSize (), 1200, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Reinject (0, 2000), 1200, "Wrong reinjected size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Reinject (0, 2000), 0, "A packet was reinjected twice");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.AppSize (), 2400, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ((txBuf.GetOldestUnackedSent (0) == Time::Max ()), true,
+                        "Reinjected packets should not be considered in flight");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 2400, "TxBuf miscalculates size of in flight segments");
+
+  // the frames are sent on path 1, and the originals are lost
+  Ptr<Packet> ptx = txBuf.NextSequence (2400, SequenceNumber32 (1), 1);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 2400, "TxBuf miscalculates size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetReinjectedBytes (), 2400, "Wrong reinjected bytes");
+  txBuf.ResetSentList (0, 0);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.DetectLostPackets (0).size (), 2, "Wrong lost packet vector size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Retransmission (SequenceNumber32 (3), 0), 0,
+                        "Reinjected packets should not be retransmitted");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 0, "TxBuf miscalculates size of in flight segments");
+
+  // a packet lost on path 1 is retransmitted there and copied on path 0
+  txBuf.ResetSentList (1, 0);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Retransmission (SequenceNumber32 (2), 1), 2400, "Wrong retransmitted size");
+  ptx = txBuf.NextSequence (2400, SequenceNumber32 (2), 1);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetReinjectedBytes (), 2400, "A retransmission on the same path is not a reinjection");
+  ptx = txBuf.NextDuplicate (SequenceNumber32 (3), 0);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 2400, "TxBuf miscalculates size of the copy");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetReinjectedBytes (), 4800, "Wrong reinjected bytes");
+}
+
+void
+QuicTxBufferTestCase::TestClearSentList ()
+{
+  QuicSocketTxBuffer txBuf;
+  Ptr<QuicSocketTxScheduler> sched = CreateObject<QuicSocketTxScheduler>();
+  txBuf.SetScheduler(sched);
+  txBuf.AddSentList (1);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.ClearSentList (2), 0, "A path without a sent list has nothing in flight");
+
+  for (uint32_t offset = 0; offset < 3600; offset += 1200)
+    {
+      Ptr<Packet> p = Create<Packet> (1196);
+      QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, offset, p->GetSize (),
+                                                                false, true, false);
+      p->AddHeader (sub);
+      txBuf.Add (p);
+    }
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (2), 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 1);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.AppSize (), 0, "Wrong buffer size");
+
+  NS_TEST_ASSERT_MSG_EQ(txBuf.ClearSentList (0), 2400, "Wrong size put back");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.AppSize (), 2400, "Wrong buffer size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 0, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ((txBuf.GetOldestUnackedSent (0) == Time::Max ()), true,
+                        "A cleared path should have nothing in flight");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.DetectLostPackets (0).size (), 0, "A cleared path should have nothing to lose");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.ClearSentList (0), 0, "A path was cleared twice");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 1200, "The other path should be untouched");
+
+  Ptr<Packet> ptx = txBuf.NextSequence (2400, SequenceNumber32 (2), 1);
+  NS_TEST_ASSERT_MSG_EQ(ptx->GetSize (), 2400, "TxBuf miscalculates size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 3600, "TxBuf miscalculates size of in flight segments");
+}
+
+void
+QuicTxBufferTestCase::TestSentLedger ()
+{
+  QuicSocketTxBuffer txBuf;
+  Ptr<QuicSocketTxScheduler> sched = CreateObject<QuicSocketTxScheduler>();
+  txBuf.SetScheduler(sched);
+  txBuf.AddSentList (1);
+  Ptr<QuicSocketState> tcb = CreateObject<QuicSocketState> ();
+
+  for (uint32_t offset = 0; offset < 6000; offset += 1200)
+    {
+      Ptr<Packet> p = Create<Packet> (1196);
+      QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, offset, p->GetSize (),
+                                                                false, true, false);
+      p->AddHeader (sub);
+      txBuf.Add (p);
+    }
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (2), 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (3), 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 1);
+  txBuf.NextSequence (1200, SequenceNumber32 (2), 1);
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 3600, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 2400, "TxBuf miscalculates size of in flight segments");
+
+  // Packets 1 and 2 of path 1 do not acknowledge those of path 0
+  QuicAckBlocks blocks;
+  QuicAckBlocks gaps;
+  std::vector<Ptr<QuicSocketTxItem> > acked = txBuf.OnAckUpdate (tcb, 2, blocks, gaps, 1);
+  NS_TEST_ASSERT_MSG_EQ(acked.size (), 2, "Wrong number of acked packets");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 0, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 3600, "An ACK of path 1 changed path 0");
+
+  // A lost packet stays in flight until it is retransmitted
+  NS_TEST_ASSERT_MSG_EQ(txBuf.MarkAsLost (SequenceNumber32 (1), 0), true, "The packet was not found");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetLost (0), 1200, "Wrong lost size");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetLost (1), 0, "A loss on path 0 changed path 1");
+  gaps.push_back (2);
+  acked = txBuf.OnAckUpdate (tcb, 3, blocks, gaps, 0);
+  NS_TEST_ASSERT_MSG_EQ(acked.size (), 1, "Only packet 3 should be acked");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 2400, "TxBuf miscalculates size of in flight segments");
+
+  // The retransmitted frames go back to the buffer, only packet 2 is left in flight
+  NS_TEST_ASSERT_MSG_EQ(txBuf.Retransmission (SequenceNumber32 (4), 0), 1200, "Wrong size retransmitted");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetLost (0), 0, "The retransmitted packet is still lost");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (0), 1200, "TxBuf miscalculates size of in flight segments");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.BytesInFlight (1), 0, "A retransmission on path 0 changed path 1");
+}
+
+void
+QuicTxBufferTestCase::TestRateSamples ()
+{
+  QuicSocketTxBuffer txBuf;
+  Ptr<QuicSocketTxScheduler> sched = CreateObject<QuicSocketTxScheduler>();
+  txBuf.SetScheduler(sched);
+  txBuf.AddSentList (1);
+  Ptr<QuicSocketState> tcb0 = CreateObject<QuicSocketState> ();
+  Ptr<QuicSocketState> tcb1 = CreateObject<QuicSocketState> ();
+
+  for (uint32_t offset = 0; offset < 3600; offset += 1200)
+    {
+      Ptr<Packet> p = Create<Packet> (1196);
+      QuicSubheader sub = QuicSubheader::CreateStreamSubHeader (1, offset, p->GetSize (),
+                                                                false, true, false);
+      p->AddHeader (sub);
+      txBuf.Add (p);
+    }
+  QuicAckBlocks blocks;
+  QuicAckBlocks gaps;
+
+  // Packet 2 of path 0 is sent once 1200 bytes were delivered on the path
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 0);
+  txBuf.UpdatePacketSent (SequenceNumber32 (1), 1200, 0, tcb0);
+  txBuf.OnAckUpdate (tcb0, 1, blocks, gaps, 0);
+  txBuf.NextSequence (1200, SequenceNumber32 (2), 0);
+  txBuf.UpdatePacketSent (SequenceNumber32 (2), 1200, 0, tcb0);
+  txBuf.NextSequence (1200, SequenceNumber32 (1), 1);
+  txBuf.UpdatePacketSent (SequenceNumber32 (1), 1200, 1, tcb1);
+  txBuf.OnAckUpdate (tcb0, 2, blocks, gaps, 0);
+  NS_TEST_ASSERT_MSG_EQ(tcb0->m_delivered, 2400, "Wrong bytes delivered on path 0");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetRateSample (0)->m_priorDelivered, 1200, "Wrong rate sample of path 0");
+  NS_TEST_ASSERT_MSG_EQ(tcb1->m_delivered, 0, "An ACK of path 0 changed path 1");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetRateSample (1)->m_priorDelivered, 0, "An ACK of path 0 changed the rate sample of path 1");
+
+  txBuf.OnAckUpdate (tcb1, 1, blocks, gaps, 1);
+  NS_TEST_ASSERT_MSG_EQ(tcb1->m_delivered, 1200, "Wrong bytes delivered on path 1");
+  NS_TEST_ASSERT_MSG_EQ(txBuf.GetRateSample (0)->m_priorDelivered, 1200, "An ACK of path 1 changed the rate sample of path 0");
+  NS_TEST_ASSERT_MSG_EQ(tcb0->m_delivered, 2400, "An ACK of path 1 changed path 0");
 }
 
 void
@@ -267,7 +557,7 @@ QuicTxBufferTestCase::TestRetransmission ()
 
   // retransmit the first of the two packets
   uint32_t newPackets = 1;
-  txBuf.ResetSentList (newPackets);
+  txBuf.ResetSentList (pathId, newPackets);
   std::vector<Ptr<QuicSocketTxItem>> lostPackets = txBuf.DetectLostPackets (pathId);
   NS_TEST_ASSERT_MSG_EQ(lostPackets.size (), 1, "Wrong lost packet vector size");
   NS_TEST_ASSERT_MSG_EQ(lostPackets.at (0)->m_packet->GetSize (), 1200, "TxBuf miscalculates size");
@@ -799,7 +1089,7 @@ QuicTxBufferTestCase::TestSetLoss ()
                         "TxBuf gets the wrong lost packet ID");
 
   // mark packets 1 and 2 as lost (all except the last 4)
-  txBuf.ResetSentList (4);
+  txBuf.ResetSentList (pathId, 4);
 
   lost = txBuf.DetectLostPackets (pathId);
 